@@ -34,16 +34,25 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #ifndef RMAP_HH_
 #define RMAP_HH_
 
+#include "RMAPAddressRangeIndex.hh"
+#include "RMAPAsyncInitiator.hh"
 #include "RMAPEngine.hh"
 #include "RMAPInitiator.hh"
+#include "RMAPInitiatorException.hh"
 #include "RMAPInitiatorOptions.hh"
+#include "RMAPMemoryTarget.hh"
+#include "RMAPObjectPool.hh"
 #include "RMAPPacket.hh"
 #include "RMAPProtocol.hh"
+#include "RMAPRegister.hh"
 #include "RMAPReplyException.hh"
 #include "RMAPReplyStatus.hh"
 #include "RMAPTarget.hh"
+#include "RMAPTargetDispatchIndex.hh"
 #include "RMAPTargetNode.hh"
+#include "RMAPTargetNodeImage.hh"
 #include "RMAPTransaction.hh"
+#include "RMAPTransactionTimerWheel.hh"
 #include "RMAPUtilities.hh"
 
 #include "RouterConfigurationPort.hh"
@@ -0,0 +1,130 @@
+/* 
+============================================================================
+SpaceWire/RMAP Library is provided under the MIT License.
+============================================================================
+
+Copyright (c) 2006-2013 Takayuki Yuasa and The Open-source SpaceWire Project
+
+Permission is hereby granted, free of charge, to any person obtaining a 
+copy of this software and associated documentation files (the 
+"Software"), to deal in the Software without restriction, including 
+without limitation the rights to use, copy, modify, merge, publish, 
+distribute, sublicense, and/or sell copies of the Software, and to 
+permit persons to whom the Software is furnished to do so, subject to 
+the following conditions:
+
+The above copyright notice and this permission notice shall be included 
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. 
+*/
+/*
+ * RMAPAddressRangeIndex.hh
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef RMAPADDRESSRANGEINDEX_HH_
+#define RMAPADDRESSRANGEINDEX_HH_
+
+#include <algorithm>
+#include <vector>
+
+#include <stdint.h>
+
+class RMAPTargetAccessAction;
+
+/** A sorted flat index of address ranges, each associated with an RMAPTargetAccessAction.
+ * Entries are sorted by the start address, and each entry also records the maximum end address
+ * of the entries up to it, so that find() binary-searches the last entry which starts at or before
+ * the accessed range, and walks back only while an earlier entry can still cover the range.
+ * For non-overlapping ranges (the usual case of register blocks), a lookup is O(log n).
+ * When overlapping ranges contain the accessed range, the entry with the smallest order wins,
+ * i.e. the one registered first.
+ * The index is immutable after build(), and therefore can be searched by multiple threads.
+ */
+class RMAPAddressRangeIndex {
+public:
+	class Entry {
+	public:
+		uint32_t addressFrom;
+		uint32_t addressTo;
+		//registration order; a smaller value is preferred
+		uint64_t order;
+		RMAPTargetAccessAction* action;
+		//the maximum addressTo among entries[0..this]
+		uint32_t maximumAddressTo;
+
+	public:
+		bool operator<(const Entry& entry) const {
+			return addressFrom < entry.addressFrom;
+		}
+	};
+
+private:
+	std::vector<Entry> entries;
+
+public:
+	/** Adds a range [addressFrom, addressTo] (both inclusive). build() should be called after adding ranges. */
+	void add(uint32_t addressFrom, uint32_t addressTo, uint64_t order, RMAPTargetAccessAction* action) {
+		Entry entry;
+		entry.addressFrom = addressFrom;
+		entry.addressTo = addressTo;
+		entry.order = order;
+		entry.action = action;
+		entry.maximumAddressTo = addressTo;
+		entries.push_back(entry);
+	}
+
+public:
+	void build() {
+		std::stable_sort(entries.begin(), entries.end());
+		for (size_t i = 1; i < entries.size(); i++) {
+			entries[i].maximumAddressTo = std::max(entries[i - 1].maximumAddressTo, entries[i].addressTo);
+		}
+	}
+
+public:
+	/** Returns the entry which contains [addressFrom, addressTo] (in the same way as
+	 * RMAPAddressRange::contains()), or NULL if there is none.
+	 */
+	const Entry* find(uint32_t addressFrom, uint32_t addressTo) const {
+		Entry key;
+		key.addressFrom = addressFrom;
+		//the first entry which starts after addressFrom
+		size_t i = std::upper_bound(entries.begin(), entries.end(), key) - entries.begin();
+		const Entry* found = NULL;
+		while (i != 0) {
+			i--;
+			const Entry& entry = entries[i];
+			if (entry.maximumAddressTo < addressTo) {
+				//no entry at or before i reaches addressTo
+				break;
+			}
+			if (addressTo <= entry.addressTo && entry.addressFrom <= addressTo && addressFrom <= entry.addressTo) {
+				if (found == NULL || entry.order < found->order) {
+					found = &entry;
+				}
+			}
+		}
+		return found;
+	}
+
+public:
+	size_t size() const {
+		return entries.size();
+	}
+
+public:
+	bool empty() const {
+		return entries.empty();
+	}
+};
+
+#endif /* RMAPADDRESSRANGEINDEX_HH_ */
@@ -0,0 +1,698 @@
+/* 
+ ============================================================================
+ SpaceWire/RMAP Library is provided under the MIT License.
+ ============================================================================
+
+ Copyright (c) 2006-2013 Takayuki Yuasa and The Open-source SpaceWire Project
+
+ Permission is hereby granted, free of charge, to any person obtaining a
+ copy of this software and associated documentation files (the
+ "Software"), to deal in the Software without restriction, including
+ without limitation the rights to use, copy, modify, merge, publish,
+ distribute, sublicense, and/or sell copies of the Software, and to
+ permit persons to whom the Software is furnished to do so, subject to
+ the following conditions:
+
+ The above copyright notice and this permission notice shall be included
+ in all copies or substantial portions of the Software.
+
+ THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS
+ OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF
+ MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.
+ IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY
+ CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT,
+ TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE
+ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+/*
+ * RMAPAsyncInitiator.hh
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef RMAPASYNCINITIATOR_HH_
+#define RMAPASYNCINITIATOR_HH_
+
+#include "RMAPPacket.hh"
+#include "RMAPEngine.hh"
+#include "RMAPTransaction.hh"
+#include "RMAPTargetNode.hh"
+#include "RMAPReplyStatus.hh"
+#include "RMAPReplyException.hh"
+#include "RMAPInitiatorException.hh"
+#include "RMAPObjectPool.hh"
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <iostream>
+#include <list>
+#include <mutex>
+
+/** Statistics of a range read/write performed by RMAPAsyncInitiator::readRange()/writeRange(). */
+class RMAPRangeTransferStatistics {
+public:
+	size_t nBytes;
+	size_t nTransactions;
+	/** Elapsed time in second. */
+	double elapsedTime;
+
+public:
+	RMAPRangeTransferStatistics() {
+		nBytes = 0;
+		nTransactions = 0;
+		elapsedTime = 0;
+	}
+
+public:
+	/** Returns throughput in MB/s (1MB=10^6 bytes). */
+	double getThroughput() const {
+		if (elapsedTime <= 0) {
+			return 0;
+		}
+		return nBytes / elapsedTime / 1e6;
+	}
+
+public:
+	std::string toString() const {
+		using namespace std;
+		stringstream ss;
+		ss << dec << nBytes << " bytes in " << nTransactions << " transactions, " << fixed << setprecision(3)
+				<< elapsedTime * 1000 << " ms (" << setprecision(2) << getThroughput() << " MB/s)";
+		return ss.str();
+	}
+};
+
+/** An RMAP initiator which keeps multiple transactions outstanding.
+ * readAsync()/writeAsync() return as soon as a command is sent, and
+ * completion is notified via a std::future or a callback.
+ * At most getWindowSize() transactions are in flight at once; further
+ * requests block until an outstanding transaction completes.
+ * Timeouts are tracked by the timer wheel of RMAPEngine, so no thread is
+ * blocked per outstanding transaction.
+ * Callbacks are invoked in the receive thread (or the timeout thread) of
+ * RMAPEngine, and therefore should return quickly.
+ * @code
+ * RMAPAsyncInitiator* asyncInitiator = new RMAPAsyncInitiator(rmapEngine);
+ * asyncInitiator->setWindowSize(32);
+ * std::vector<std::future<void> > futures;
+ * for (size_t i = 0; i < nChunks; i++) {
+ * 	futures.push_back(asyncInitiator->readAsync(targetNode, address + i * chunkSize, chunkSize, buffer + i * chunkSize));
+ * }
+ * for (size_t i = 0; i < nChunks; i++) {
+ * 	futures[i].get(); //throws RMAPInitiatorException or RMAPReplyException on failure
+ * }
+ * @endcode
+ */
+class RMAPAsyncInitiator {
+public:
+	/** Result passed to a completion callback. */
+	enum {
+		Completed, Timeout, ReplyWithError, ReadReplyWithInsufficientData, TransactionCouldNotBeInitiated
+	};
+
+public:
+	/** A completion callback. replyStatus is valid when result is Completed or ReplyWithError. */
+	typedef std::function<void(uint32_t result, uint8_t replyStatus)> CompletionCallback;
+
+public:
+	static const size_t DefaultWindowSize = 16;
+	static const bool DefaultIncrementMode = true;
+	static constexpr double DefaultTimeoutDuration = 1000.0;
+
+private:
+	class Request: public RMAPTransactionCompletionAction {
+	public:
+		RMAPAsyncInitiator* initiator;
+		RMAPTransaction transaction;
+		RMAPPacket commandPacket;
+		uint8_t* readBuffer;
+		uint32_t readLength;
+		std::promise<void> promise;
+		CompletionCallback callback;
+		std::list<Request*>::iterator position;
+
+	public:
+		void doAction(RMAPTransaction* transaction) {
+			if (transaction->getState() == RMAPTransaction::Timeout) {
+				initiator->timedOut(this);
+			} else {
+				initiator->replyReceived(this);
+			}
+		}
+	};
+
+private:
+	RMAPEngine* rmapEngine;
+	uint8_t initiatorLogicalAddress;
+	bool incrementMode;
+	bool useDraftECRC;
+	uint32_t priorityClass;
+
+private:
+	size_t windowSize;
+	std::list<Request*> outstandingRequests;
+	//requests removed from outstandingRequests whose result is still being notified by complete()
+	size_t nCompletingRequests;
+	std::mutex mutex;
+	std::condition_variable windowCondition;
+	//completed requests are recycled together with their command packets
+	RMAPObjectPool<Request> requestPool;
+
+public:
+	size_t nCompletedTransactions;
+	size_t nTimedOutTransactions;
+	size_t nFailedTransactions;
+
+public:
+	RMAPAsyncInitiator(RMAPEngine* rmapEngine) :
+			rmapEngine(rmapEngine) {
+		initiatorLogicalAddress = SpaceWireProtocol::DefaultLogicalAddress;
+		incrementMode = DefaultIncrementMode;
+		useDraftECRC = false;
+		priorityClass = RMAPTransaction::NormalPriorityClass;
+		windowSize = DefaultWindowSize;
+		nCompletingRequests = 0;
+		nCompletedTransactions = 0;
+		nTimedOutTransactions = 0;
+		nFailedTransactions = 0;
+	}
+
+public:
+	/** Destructor. Outstanding transactions are canceled and completed as Timeout.
+	 * Returns after the receive and timeout threads of RMAPEngine have finished
+	 * notifying the results of transactions of this instance.
+	 */
+	~RMAPAsyncInitiator() {
+		cancelAllTransactions();
+	}
+
+public:
+	/** Cancels the outstanding transactions, which are completed as Timeout, and waits until
+	 * the receive and timeout threads of RMAPEngine have finished notifying the results of
+	 * transactions of this instance. After this returns, RMAPEngine holds no reference to this instance.
+	 */
+	void cancelAllTransactions() {
+		cancelOutstandingRequests();
+		//wait for replies which were being processed while canceling
+		waitForAllTransactions();
+	}
+
+public:
+	/** Reads remote memory without waiting for the reply.
+	 * The read data are written to buffer when the reply is received,
+	 * and therefore buffer should be kept valid until the returned future becomes ready.
+	 * Blocks while getWindowSize() transactions are outstanding.
+	 */
+	std::future<void> readAsync(RMAPTargetNode* rmapTargetNode, uint32_t memoryAddress, uint32_t length,
+			uint8_t* buffer, double timeoutDuration = DefaultTimeoutDuration) {
+		Request* request = createReadRequest(rmapTargetNode, memoryAddress, length, buffer, timeoutDuration);
+		std::future<void> future = request->promise.get_future();
+		initiate(request);
+		return future;
+	}
+
+public:
+	/** Reads remote memory without waiting for the reply, and invokes callback on completion.
+	 * See readAsync(RMAPTargetNode*, uint32_t, uint32_t, uint8_t*, double).
+	 */
+	void readAsync(RMAPTargetNode* rmapTargetNode, uint32_t memoryAddress, uint32_t length, uint8_t* buffer,
+			CompletionCallback callback, double timeoutDuration = DefaultTimeoutDuration) {
+		Request* request = createReadRequest(rmapTargetNode, memoryAddress, length, buffer, timeoutDuration);
+		request->callback = callback;
+		initiate(request);
+	}
+
+public:
+	/** Writes remote memory without waiting for the reply.
+	 * data are copied to a command packet before this method returns.
+	 * Blocks while getWindowSize() transactions are outstanding.
+	 */
+	std::future<void> writeAsync(RMAPTargetNode* rmapTargetNode, uint32_t memoryAddress, uint8_t* data,
+			uint32_t length, double timeoutDuration = DefaultTimeoutDuration) {
+		Request* request = createWriteRequest(rmapTargetNode, memoryAddress, data, length, timeoutDuration);
+		std::future<void> future = request->promise.get_future();
+		initiate(request);
+		return future;
+	}
+
+public:
+	/** Writes remote memory without waiting for the reply, and invokes callback on completion.
+	 * See writeAsync(RMAPTargetNode*, uint32_t, uint8_t*, uint32_t, double).
+	 */
+	void writeAsync(RMAPTargetNode* rmapTargetNode, uint32_t memoryAddress, uint8_t* data, uint32_t length,
+			CompletionCallback callback, double timeoutDuration = DefaultTimeoutDuration) {
+		Request* request = createWriteRequest(rmapTargetNode, memoryAddress, data, length, timeoutDuration);
+		request->callback = callback;
+		initiate(request);
+	}
+
+public:
+	/** Reads a memory range of arbitrary length into buffer.
+	 * The range is split into chunks of rmapTargetNode->getMaximumDataLengthPerTransaction() bytes,
+	 * and up to getWindowSize() chunks are kept outstanding. Each reply is copied directly to
+	 * its position in buffer. When a chunk fails, no further chunk is initiated, and the first
+	 * exception is rethrown after all outstanding chunks are completed.
+	 */
+	RMAPRangeTransferStatistics readRange(RMAPTargetNode* rmapTargetNode, uint32_t memoryAddress, size_t length,
+			uint8_t* buffer, double timeoutDuration = DefaultTimeoutDuration) throw (RMAPInitiatorException,
+					RMAPReplyException) {
+		RMAPRangeTransferStatistics statistics;
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		std::deque<std::future<void> > futures;
+		std::exception_ptr error;
+		size_t chunkSize = getChunkSize(rmapTargetNode);
+		for (size_t offset = 0; offset < length && !error; offset += chunkSize) {
+			uint32_t size = (uint32_t) std::min(chunkSize, length - offset);
+			while (futures.size() >= getWindowSize() && !error) {
+				error = waitForChunk(futures);
+			}
+			if (!error) {
+				futures.push_back(readAsync(rmapTargetNode, memoryAddress + offset, size, buffer + offset, timeoutDuration));
+				statistics.nTransactions++;
+				statistics.nBytes += size;
+			}
+		}
+		finishRange(futures, error, statistics, start);
+		return statistics;
+	}
+
+public:
+	/** Reads a memory range of arbitrary length, and writes the data to os in the order of address.
+	 * Up to getWindowSize() chunks are kept outstanding as in readRange(RMAPTargetNode*, uint32_t, size_t, uint8_t*, double),
+	 * and each completed chunk is written to os from a reused slot buffer, so that
+	 * a range larger than memory can be dumped to a file.
+	 */
+	RMAPRangeTransferStatistics readRange(RMAPTargetNode* rmapTargetNode, uint32_t memoryAddress, size_t length,
+			std::ostream& os, double timeoutDuration = DefaultTimeoutDuration) throw (RMAPInitiatorException,
+					RMAPReplyException) {
+		RMAPRangeTransferStatistics statistics;
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		size_t chunkSize = getChunkSize(rmapTargetNode);
+		size_t nSlots = getWindowSize();
+		std::vector<uint8_t> slots(chunkSize * nSlots);
+		std::deque<std::future<void> > futures;
+		std::deque<std::pair<uint8_t*, size_t> > pendingChunks;
+		std::exception_ptr error;
+		size_t slotIndex = 0;
+		for (size_t offset = 0; offset < length && !error; offset += chunkSize) {
+			uint32_t size = (uint32_t) std::min(chunkSize, length - offset);
+			if (futures.size() >= nSlots) {
+				error = waitForChunk(futures);
+				if (!error) {
+					os.write((char*) pendingChunks.front().first, pendingChunks.front().second);
+				}
+				pendingChunks.pop_front();
+			}
+			if (!error) {
+				uint8_t* slot = &(slots[chunkSize * slotIndex]);
+				slotIndex = (slotIndex + 1) % nSlots;
+				futures.push_back(readAsync(rmapTargetNode, memoryAddress + offset, size, slot, timeoutDuration));
+				pendingChunks.push_back(std::make_pair(slot, (size_t) size));
+				statistics.nTransactions++;
+				statistics.nBytes += size;
+			}
+		}
+		while (!futures.empty() && !error) {
+			error = waitForChunk(futures);
+			if (!error) {
+				os.write((char*) pendingChunks.front().first, pendingChunks.front().second);
+			}
+			pendingChunks.pop_front();
+		}
+		finishRange(futures, error, statistics, start);
+		return statistics;
+	}
+
+public:
+	/** Writes data of arbitrary length to a memory range.
+	 * The range is split and pipelined in the same way as readRange(RMAPTargetNode*, uint32_t, size_t, uint8_t*, double).
+	 */
+	RMAPRangeTransferStatistics writeRange(RMAPTargetNode* rmapTargetNode, uint32_t memoryAddress, uint8_t* data,
+			size_t length, double timeoutDuration = DefaultTimeoutDuration) throw (RMAPInitiatorException,
+					RMAPReplyException) {
+		RMAPRangeTransferStatistics statistics;
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		std::deque<std::future<void> > futures;
+		std::exception_ptr error;
+		size_t chunkSize = getChunkSize(rmapTargetNode);
+		for (size_t offset = 0; offset < length && !error; offset += chunkSize) {
+			uint32_t size = (uint32_t) std::min(chunkSize, length - offset);
+			while (futures.size() >= getWindowSize() && !error) {
+				error = waitForChunk(futures);
+			}
+			if (!error) {
+				futures.push_back(writeAsync(rmapTargetNode, memoryAddress + offset, data + offset, size, timeoutDuration));
+				statistics.nTransactions++;
+				statistics.nBytes += size;
+			}
+		}
+		finishRange(futures, error, statistics, start);
+		return statistics;
+	}
+
+public:
+	/** Reads length bytes from is, and writes them to a memory range.
+	 * Since writeAsync() copies data to a command packet, a single chunk buffer is reused.
+	 * Throws RMAPInitiatorException::Aborted if is ends before length bytes are read.
+	 */
+	RMAPRangeTransferStatistics writeRange(RMAPTargetNode* rmapTargetNode, uint32_t memoryAddress, std::istream& is,
+			size_t length, double timeoutDuration = DefaultTimeoutDuration) throw (RMAPInitiatorException,
+					RMAPReplyException) {
+		RMAPRangeTransferStatistics statistics;
+		std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+		std::deque<std::future<void> > futures;
+		std::exception_ptr error;
+		size_t chunkSize = getChunkSize(rmapTargetNode);
+		std::vector<uint8_t> chunk(chunkSize);
+		for (size_t offset = 0; offset < length && !error; offset += chunkSize) {
+			uint32_t size = (uint32_t) std::min(chunkSize, length - offset);
+			is.read((char*) &(chunk[0]), size);
+			if ((size_t) is.gcount() != size) {
+				error = std::make_exception_ptr(RMAPInitiatorException(RMAPInitiatorException::Aborted));
+				break;
+			}
+			while (futures.size() >= getWindowSize() && !error) {
+				error = waitForChunk(futures);
+			}
+			if (!error) {
+				futures.push_back(writeAsync(rmapTargetNode, memoryAddress + offset, &(chunk[0]), size, timeoutDuration));
+				statistics.nTransactions++;
+				statistics.nBytes += size;
+			}
+		}
+		finishRange(futures, error, statistics, start);
+		return statistics;
+	}
+
+public:
+	/** Blocks until all outstanding transactions complete (or time out),
+	 * and their futures and callbacks have been notified.
+	 */
+	void waitForAllTransactions() {
+		std::unique_lock<std::mutex> lock(mutex);
+		while (!outstandingRequests.empty() || nCompletingRequests != 0) {
+			windowCondition.wait(lock);
+		}
+	}
+
+public:
+	size_t getNOutstandingTransactions() {
+		std::lock_guard<std::mutex> guard(mutex);
+		return outstandingRequests.size();
+	}
+
+public:
+	size_t getWindowSize() {
+		return windowSize;
+	}
+
+public:
+	/** Sets the maximum number of outstanding transactions. */
+	void setWindowSize(size_t windowSize) {
+		{
+			std::lock_guard<std::mutex> guard(mutex);
+			this->windowSize = (windowSize != 0) ? windowSize : 1;
+		}
+		windowCondition.notify_all();
+	}
+
+public:
+	uint8_t getInitiatorLogicalAddress() const {
+		return initiatorLogicalAddress;
+	}
+
+public:
+	void setInitiatorLogicalAddress(uint8_t initiatorLogicalAddress) {
+		this->initiatorLogicalAddress = initiatorLogicalAddress;
+	}
+
+public:
+	void setIncrementMode(bool incrementMode) {
+		this->incrementMode = incrementMode;
+	}
+
+public:
+	void setUseDraftECRC(bool useDraftECRC) {
+		this->useDraftECRC = useDraftECRC;
+	}
+
+public:
+	/** Sets the priority class of transactions initiated after this call (see RMAPTransaction::setPriorityClass()). */
+	void setPriorityClass(uint32_t priorityClass) {
+		this->priorityClass = priorityClass;
+	}
+
+public:
+	uint32_t getPriorityClass() const {
+		return priorityClass;
+	}
+
+private:
+	/** Returns the chunk size of a range read/write. Throws if it is 0, since the range would never advance. */
+	size_t getChunkSize(RMAPTargetNode* rmapTargetNode) throw (RMAPInitiatorException) {
+		size_t chunkSize = rmapTargetNode->getMaximumDataLengthPerTransaction();
+		if (chunkSize == 0) {
+			throw RMAPInitiatorException(RMAPInitiatorException::MaximumDataLengthPerTransactionIsZero);
+		}
+		return chunkSize;
+	}
+
+private:
+	/** Waits for the oldest chunk of a range read/write. Returns the exception if the chunk failed. */
+	std::exception_ptr waitForChunk(std::deque<std::future<void> >& futures) {
+		std::exception_ptr error;
+		try {
+			futures.front().get();
+		} catch (...) {
+			error = std::current_exception();
+		}
+		futures.pop_front();
+		return error;
+	}
+
+private:
+	/** Waits for all remaining chunks, fills elapsedTime, and rethrows the first error if any. */
+	void finishRange(std::deque<std::future<void> >& futures, std::exception_ptr error,
+			RMAPRangeTransferStatistics& statistics, std::chrono::steady_clock::time_point start) {
+		while (!futures.empty()) {
+			std::exception_ptr chunkError = waitForChunk(futures);
+			if (!error) {
+				error = chunkError;
+			}
+		}
+		statistics.elapsedTime = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		if (error) {
+			std::rethrow_exception(error);
+		}
+	}
+
+private:
+	Request* createRequest(uint32_t memoryAddress, uint32_t length, double timeoutDuration) {
+		Request* request = requestPool.acquire();
+		request->initiator = this;
+		request->readBuffer = NULL;
+		request->readLength = 0;
+		request->promise = std::promise<void>();
+		request->callback = nullptr;
+		request->position = outstandingRequests.end();
+		request->transaction.replyPacket = NULL;
+		request->transaction.setState(RMAPTransaction::NotInitiated);
+		RMAPPacket* commandPacket = &(request->commandPacket);
+		commandPacket->setUseDraftECRC(useDraftECRC);
+		commandPacket->setInitiatorLogicalAddress(initiatorLogicalAddress);
+		commandPacket->setCommand();
+		if (incrementMode) {
+			commandPacket->setIncrementMode();
+		} else {
+			commandPacket->setNoIncrementMode();
+		}
+		commandPacket->setReplyMode();
+		commandPacket->setExtendedAddress(0x00);
+		commandPacket->setAddress(memoryAddress);
+		commandPacket->setDataLength(length);
+		request->transaction.commandPacket = commandPacket;
+		request->transaction.isNonblockingMode = true;
+		request->transaction.completionAction = request;
+		request->transaction.setTimeoutDuration(timeoutDuration);
+		request->transaction.setPriorityClass(priorityClass);
+		return request;
+	}
+
+private:
+	Request* createReadRequest(RMAPTargetNode* rmapTargetNode, uint32_t memoryAddress, uint32_t length,
+			uint8_t* buffer, double timeoutDuration) {
+		Request* request = createRequest(memoryAddress, length, timeoutDuration);
+		request->readBuffer = buffer;
+		request->readLength = length;
+		request->commandPacket.setRead();
+		request->commandPacket.setNoVerifyMode();
+		request->commandPacket.clearData();
+		/** InitiatorLogicalAddress might be updated in setRMAPTargetInformation(rmapTargetNode) below */
+		request->commandPacket.setRMAPTargetInformation(rmapTargetNode);
+		request->transaction.linkIndex = rmapTargetNode->getLinkIndex();
+		return request;
+	}
+
+private:
+	Request* createWriteRequest(RMAPTargetNode* rmapTargetNode, uint32_t memoryAddress, uint8_t* data,
+			uint32_t length, double timeoutDuration) {
+		Request* request = createRequest(memoryAddress, length, timeoutDuration);
+		request->commandPacket.setWrite();
+		request->commandPacket.setNoVerifyMode();
+		request->commandPacket.setRMAPTargetInformation(rmapTargetNode);
+		request->transaction.linkIndex = rmapTargetNode->getLinkIndex();
+		request->commandPacket.setData(data, length);
+		return request;
+	}
+
+private:
+	/** Waits for a free slot in the window, registers the request, and sends the command. */
+	void initiate(Request* request) {
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			while (outstandingRequests.size() >= windowSize) {
+				windowCondition.wait(lock);
+			}
+			request->position = outstandingRequests.insert(outstandingRequests.end(), request);
+		}
+		try {
+			rmapEngine->initiateTransaction(request->transaction);
+		} catch (...) {
+			//the reply can not arrive once the transaction is canceled
+			if (rmapEngine->cancelTransaction(&(request->transaction))
+					|| request->transaction.state == RMAPTransaction::NotInitiated) {
+				if (removeFromOutstandingRequests(request)) {
+					complete(request, TransactionCouldNotBeInitiated, 0);
+				}
+			}
+		}
+	}
+
+private:
+	/** Invoked via Request::doAction() in the receive thread of RMAPEngine. */
+	void replyReceived(Request* request) {
+		if (!removeFromOutstandingRequests(request)) {
+			return;
+		}
+		RMAPPacket* replyPacket = request->transaction.replyPacket;
+		uint8_t replyStatus = replyPacket->getStatus();
+		uint32_t result = Completed;
+		if (replyStatus != RMAPReplyStatus::CommandExcecutedSuccessfully) {
+			result = ReplyWithError;
+		} else if (request->readBuffer != NULL) {
+			if (replyPacket->getDataSize() < request->readLength) {
+				result = ReadReplyWithInsufficientData;
+			} else {
+				if (request->readLength != 0) {
+					memcpy(request->readBuffer, replyPacket->getDataBufferAsArrayPointer(), request->readLength);
+				}
+			}
+		}
+		rmapEngine->releaseRMAPPacket(replyPacket);
+		request->transaction.replyPacket = NULL;
+		complete(request, result, replyStatus);
+	}
+
+private:
+	/** Invoked via Request::doAction() when RMAPEngine expired the transaction. */
+	void timedOut(Request* request) {
+		if (removeFromOutstandingRequests(request)) {
+			complete(request, Timeout, 0);
+		}
+	}
+
+private:
+	/** Returns false if the request has already been removed by another thread.
+	 * A removed request is counted in nCompletingRequests until complete() returns it to the pool.
+	 */
+	bool removeFromOutstandingRequests(Request* request) {
+		std::lock_guard<std::mutex> guard(mutex);
+		if (request->position == outstandingRequests.end()) {
+			return false;
+		}
+		outstandingRequests.erase(request->position);
+		request->position = outstandingRequests.end();
+		nCompletingRequests++;
+		return true;
+	}
+
+private:
+	/** Notifies the result via the future or the callback, returns the request to the pool, and frees a slot of the window. */
+	void complete(Request* request, uint32_t result, uint8_t replyStatus) {
+		{
+			std::lock_guard<std::mutex> guard(mutex);
+			switch (result) {
+			case Completed:
+				nCompletedTransactions++;
+				break;
+			case Timeout:
+				nTimedOutTransactions++;
+				break;
+			default:
+				nFailedTransactions++;
+				break;
+			}
+		}
+		if (request->callback) {
+			request->callback(result, replyStatus);
+		} else {
+			switch (result) {
+			case Completed:
+				request->promise.set_value();
+				break;
+			case Timeout:
+				request->promise.set_exception(
+						std::make_exception_ptr(RMAPInitiatorException(RMAPInitiatorException::Timeout)));
+				break;
+			case ReplyWithError:
+				request->promise.set_exception(std::make_exception_ptr(RMAPReplyException(replyStatus)));
+				break;
+			case ReadReplyWithInsufficientData:
+				request->promise.set_exception(
+						std::make_exception_ptr(
+								RMAPInitiatorException(RMAPInitiatorException::ReadReplyWithInsufficientData)));
+				break;
+			default:
+				request->promise.set_exception(
+						std::make_exception_ptr(
+								RMAPInitiatorException(RMAPInitiatorException::RMAPTransactionCouldNotBeInitiated)));
+				break;
+			}
+		}
+		requestPool.release(request);
+		//notified while holding the lock, since a waiting destructor may free this instance once it is released
+		std::lock_guard<std::mutex> guard(mutex);
+		nCompletingRequests--;
+		windowCondition.notify_all();
+	}
+
+private:
+	/** Cancels all outstanding requests, and completes them as Timeout.
+	 * A request whose reply (or timeout) is being processed by RMAPEngine is left to Request::doAction().
+	 */
+	void cancelOutstandingRequests() {
+		std::vector<Request*> canceledRequests;
+		{
+			std::lock_guard<std::mutex> guard(mutex);
+			std::list<Request*>::iterator it = outstandingRequests.begin();
+			while (it != outstandingRequests.end()) {
+				Request* request = *it;
+				it++;
+				if (rmapEngine->cancelTransaction(&(request->transaction))) {
+					outstandingRequests.erase(request->position);
+					request->position = outstandingRequests.end();
+					nCompletingRequests++;
+					canceledRequests.push_back(request);
+				}
+			}
+		}
+		for (size_t i = 0; i < canceledRequests.size(); i++) {
+			complete(canceledRequests[i], Timeout, 0);
+		}
+	}
+};
+
+#endif /* RMAPASYNCINITIATOR_HH_ */
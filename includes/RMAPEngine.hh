@@ -38,13 +38,27 @@
 #include "CxxUtilities/Mutex.hh"
 #include "CxxUtilities/Action.hh"
 
+#include "RMAPObjectPool.hh"
 #include "RMAPTransaction.hh"
+#include "RMAPTransactionTimerWheel.hh"
 #include "RMAPTarget.hh"
+#include "RMAPTargetDispatchIndex.hh"
 #include "SpaceWireIF.hh"
 #include "SpaceWireUtilities.hh"
 
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <limits>
 #include <memory>
 #include <mutex>
+#include <thread>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
 
 class RMAPEngineStoppedAction: public CxxUtilities::Action<void> {
 public:
@@ -64,7 +78,10 @@ public:
 		SpecifiedTransactionIDIsAlreadyInUse,
 		PacketWasNotSentCorrectly,
 		SpaceWireIFDisconnected,
-		UnexpectedRMAPReplyPacketWasReceived
+		UnexpectedRMAPReplyPacketWasReceived,
+		NoSuchLink,
+		LinkCanNotBeAddedWhileRunning,
+		LinkHasFailed
 	};
 
 private:
@@ -124,6 +141,15 @@ public:
 		case UnexpectedRMAPReplyPacketWasReceived:
 			result = "UnexpectedRMAPReplyPacketWasReceived";
 			break;
+		case NoSuchLink:
+			result = "NoSuchLink";
+			break;
+		case LinkCanNotBeAddedWhileRunning:
+			result = "LinkCanNotBeAddedWhileRunning";
+			break;
+		case LinkHasFailed:
+			result = "LinkHasFailed";
+			break;
 		default:
 			result = "Undefined status";
 			break;
@@ -132,61 +158,218 @@ public:
 	}
 };
 
+/** A lock-free bounded ring of free transaction IDs.
+ * This is a multi-producer/multi-consumer queue whose capacity equals the
+ * number of transaction IDs, so that pushing back an ID never fails as long
+ * as each ID is held in the ring at most once.
+ */
+class RMAPTransactionIDRing {
+private:
+	struct Cell {
+		std::atomic<size_t> sequence;
+		uint16_t transactionID;
+	};
+
+private:
+	static const size_t CacheLineSize = 64;
+
+private:
+	std::unique_ptr<Cell[]> cells;
+	size_t mask;
+	//the positions are padded onto separate cache lines instead of using alignas, which would make
+	//the ring (and Link holding it) an over-aligned type that plain new cannot allocate before C++17
+	char paddingBeforeEnqueuePosition[CacheLineSize];
+	std::atomic<size_t> enqueuePosition;
+	char paddingBeforeDequeuePosition[CacheLineSize - sizeof(std::atomic<size_t>)];
+	std::atomic<size_t> dequeuePosition;
+	char paddingAfterDequeuePosition[CacheLineSize - sizeof(std::atomic<size_t>)];
+
+public:
+	/** Constructs an empty ring; reset() fills it. */
+	RMAPTransactionIDRing() {
+		reset(0, 0);
+	}
+
+public:
+	/** Constructs a ring filled with transaction IDs from 0 to capacity-1.
+	 * @param[in] capacity the number of IDs (power of two).
+	 */
+	RMAPTransactionIDRing(size_t capacity) {
+		reset(0, capacity);
+	}
+
+public:
+	/** Constructs a ring filled with nTransactionIDs IDs starting from firstTransactionID.
+	 * The capacity is rounded up to a power of two.
+	 */
+	RMAPTransactionIDRing(size_t firstTransactionID, size_t nTransactionIDs) {
+		reset(firstTransactionID, nTransactionIDs);
+	}
+
+public:
+	/** Refills the ring with nTransactionIDs IDs starting from firstTransactionID.
+	 * Not thread safe; invoked only while no other thread pushes or pops.
+	 */
+	void reset(size_t firstTransactionID, size_t nTransactionIDs) {
+		size_t capacity = 1;
+		while (capacity < nTransactionIDs) {
+			capacity <<= 1;
+		}
+		cells.reset(new Cell[capacity]);
+		mask = capacity - 1;
+		fill(firstTransactionID, nTransactionIDs);
+	}
+
+private:
+	void fill(size_t firstTransactionID, size_t nTransactionIDs) {
+		for (size_t i = 0; i <= mask; i++) {
+			if (i < nTransactionIDs) {
+				cells[i].transactionID = firstTransactionID + i;
+				cells[i].sequence.store(i + 1, std::memory_order_relaxed);
+			} else {
+				cells[i].sequence.store(i, std::memory_order_relaxed);
+			}
+		}
+		enqueuePosition.store(nTransactionIDs, std::memory_order_relaxed);
+		dequeuePosition.store(0, std::memory_order_relaxed);
+	}
+
+public:
+	/** Pushes back a transaction ID.
+	 * Waits for a concurrent pop which has claimed but not yet released the cell, so that
+	 * pushing never fails spuriously.
+	 * @returns false if the ring is full.
+	 */
+	bool push(uint16_t transactionID) {
+		size_t position = enqueuePosition.load(std::memory_order_relaxed);
+		Cell* cell;
+		while (true) {
+			cell = &cells[position & mask];
+			size_t sequence = cell->sequence.load(std::memory_order_acquire);
+			intptr_t difference = (intptr_t) sequence - (intptr_t) position;
+			if (difference == 0) {
+				if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+					break;
+				}
+			} else if (difference < 0) {
+				//the cell is still held by a pop of the previous lap; full only if that pop has not claimed it
+				if ((intptr_t) (position - dequeuePosition.load(std::memory_order_acquire)) > (intptr_t) mask) {
+					return false;
+				}
+				std::this_thread::yield();
+				position = enqueuePosition.load(std::memory_order_relaxed);
+			} else {
+				position = enqueuePosition.load(std::memory_order_relaxed);
+			}
+		}
+		cell->transactionID = transactionID;
+		cell->sequence.store(position + 1, std::memory_order_release);
+		return true;
+	}
+
+public:
+	/** Pops a transaction ID.
+	 * Waits for a concurrent push which has claimed but not yet published the cell.
+	 * @returns false if the ring is empty.
+	 */
+	bool pop(uint16_t& transactionID) {
+		size_t position = dequeuePosition.load(std::memory_order_relaxed);
+		Cell* cell;
+		while (true) {
+			cell = &cells[position & mask];
+			size_t sequence = cell->sequence.load(std::memory_order_acquire);
+			intptr_t difference = (intptr_t) sequence - (intptr_t) (position + 1);
+			if (difference == 0) {
+				if (dequeuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) {
+					break;
+				}
+			} else if (difference < 0) {
+				//the cell is not published yet; empty only if no push has claimed it
+				if (enqueuePosition.load(std::memory_order_acquire) == position) {
+					return false;
+				}
+				std::this_thread::yield();
+				position = dequeuePosition.load(std::memory_order_relaxed);
+			} else {
+				position = dequeuePosition.load(std::memory_order_relaxed);
+			}
+		}
+		transactionID = cell->transactionID;
+		cell->sequence.store(position + mask + 1, std::memory_order_release);
+		return true;
+	}
+
+public:
+	/** Returns the number of IDs in the ring (approximate while other threads push/pop). */
+	size_t size() {
+		size_t enqueued = enqueuePosition.load(std::memory_order_relaxed);
+		size_t dequeued = dequeuePosition.load(std::memory_order_relaxed);
+		return (enqueued > dequeued) ? enqueued - dequeued : 0;
+	}
+};
+
 class RMAPEngine: public CxxUtilities::Thread {
 public:
-	class RMAPTargetProcessThread: public CxxUtilities::Thread {
+	/** A pooled worker thread which processes RMAP commands
+	 * queued by RMAPEngine::rmapCommandPacketReceived().
+	 */
+	class RMAPTargetProcessThread: public CxxUtilities::StoppableThread {
 	private:
-		RMAPTargetAccessAction* rmapTargetAcessAction;
-		std::unique_ptr<RMAPTransaction> rmapTransaction;
 		RMAPEngine* rmapEngine;
 
+	public:
+		RMAPTargetProcessThread(RMAPEngine* rmapEngine) :
+				CxxUtilities::StoppableThread(), rmapEngine(rmapEngine) {
+		}
+
+	public:
+		void run() {
+			RMAPTransaction* rmapTransaction;
+			RMAPTargetAccessAction* rmapTargetAcessAction;
+			//returns false after the queue is drained and the engine stopped the pool
+			while (rmapEngine->popRMAPTargetCommand(rmapTransaction, rmapTargetAcessAction)) {
+				rmapEngine->processRMAPTargetTransaction(rmapTransaction, rmapTargetAcessAction);
+			}
+		}
+	};
+
+public:
+	class Link;
+
+public:
+	/** A thread which receives packets from a link other than the primary one (link 0),
+	 * whose packets are received by the thread of RMAPEngine itself.
+	 */
+	class RMAPLinkReceiveThread: public CxxUtilities::StoppableThread {
 	private:
-		bool isCompleted_;
+		RMAPEngine* rmapEngine;
+		Link* link;
 
 	public:
-		RMAPTargetProcessThread(RMAPEngine* rmapEngine, std::unique_ptr<RMAPTransaction>&& rmapTransaction,
-				RMAPTargetAccessAction* rmapTargetAcessAction) :
-				CxxUtilities::Thread(),
-				rmapTargetAcessAction(rmapTargetAcessAction),
-				rmapTransaction(std::move(rmapTransaction)),
-				rmapEngine(rmapEngine)
-				{
-			isCompleted_ = false;
+		RMAPLinkReceiveThread(RMAPEngine* rmapEngine, Link* link) :
+				CxxUtilities::StoppableThread(), rmapEngine(rmapEngine), link(link) {
 		}
 
 	public:
 		void run() {
-			using namespace std;
-			isCompleted_ = false;
-			try {
-				rmapTargetAcessAction->processTransaction(rmapTransaction.get());
-				rmapTransaction->setState(RMAPTransaction::ReplySet);
-			} catch (...) {
-				delete rmapTransaction->commandPacket;
-				rmapEngine->receivedCommandPacketDiscarded();
-				isCompleted_ = true;
-				return;
-			}
-			try {
-				rmapTransaction->replyPacket->constructPacket();
-				rmapEngine->sendPacket(rmapTransaction->replyPacket->getPacketBufferPointer());
-				rmapTransaction->setState(RMAPTransaction::ReplySent);
-			} catch (...) {
-				rmapTargetAcessAction->transactionReplyCouldNotBeSent(rmapTransaction.get());
-				rmapEngine->replyToReceivedCommandPacketCouldNotBeSent();
-				delete rmapTransaction->commandPacket;
-				isCompleted_ = true;
-				return;
-			}
-			rmapTargetAcessAction->transactionWillComplete(rmapTransaction.get());
-			rmapTransaction->setState(RMAPTransaction::ReplyCompleted);
-			delete rmapTransaction->commandPacket;
-			isCompleted_ = true;
+			rmapEngine->receivePackets(link);
 		}
+	};
+
+public:
+	/** A thread which expires transactions whose reply did not arrive within their timeout duration. */
+	class RMAPTransactionTimeoutThread: public CxxUtilities::StoppableThread {
+	private:
+		RMAPEngine* rmapEngine;
 
 	public:
-		bool isCompleted() {
-			return isCompleted_;
+		RMAPTransactionTimeoutThread(RMAPEngine* rmapEngine) :
+				CxxUtilities::StoppableThread(), rmapEngine(rmapEngine) {
+		}
+
+	public:
+		void run() {
+			rmapEngine->processTransactionTimeouts();
 		}
 	};
 
@@ -207,44 +390,220 @@ public:
 	};
 
 private:
-	std::map<uint16_t, RMAPTransaction*> transactions;
-	CxxUtilities::Mutex transactionIDMutex;
-	std::list<uint16_t> availableTransactionIDList;
-	uint16_t latestAssignedTransactionID;
+	//flat transaction table indexed by transaction ID (NULL when the ID is not in use)
+	std::unique_ptr<std::atomic<RMAPTransaction*>[]> transactions;
+	//true while the ID is held in the ring of free IDs of the link which owns the ID
+	std::unique_ptr<std::atomic<bool>[]> transactionIDIsInRing;
+	std::atomic<size_t> nTransactions;
+	//IDs [i*transactionIDPartitionSize, (i+1)*transactionIDPartitionSize) belong to link i
+	size_t transactionIDPartitionSize;
+
+public:
+	/** Invalidates the dispatch index of an engine when one of its targets is modified. */
+	class RMAPEngineRMAPTargetModifiedAction: public RMAPTargetModifiedAction {
+	private:
+		RMAPEngine* rmapEngine;
+
+	public:
+		RMAPEngineRMAPTargetModifiedAction(RMAPEngine* rmapEngine) {
+			this->rmapEngine = rmapEngine;
+		}
+
+	public:
+		void doAction(RMAPTarget*) {
+			rmapEngine->rmapTargetsVersion++;
+		}
+	};
 
 private:
 	std::vector<RMAPTarget*> rmapTargets;
 	std::vector<RMAPTargetProcessThread*> rmapTargetProcessThreads;
+	//incremented when a target is added, removed, or modified
+	std::atomic<size_t> rmapTargetsVersion;
+	RMAPEngineRMAPTargetModifiedAction* rmapTargetModifiedAction;
+	//rebuilt when rmapTargetsVersion changes; a replaced index is retired with the epoch at which it was
+	//replaced, and is deleted once no receive thread is searching it (see getRMAPTargetDispatchIndex())
+	std::atomic<RMAPTargetDispatchIndex*> rmapTargetDispatchIndex;
+	std::atomic<uint64_t> rmapTargetDispatchIndexEpoch;
+	std::vector<std::pair<RMAPTargetDispatchIndex*, uint64_t> > retiredRMAPTargetDispatchIndices;
+	std::mutex rmapTargetsMutex;
+
+private:
+	//bounded queue of received commands waiting for a worker thread
+	std::deque<std::pair<RMAPTransaction*, RMAPTargetAccessAction*> > rmapTargetCommandQueue;
+	std::mutex rmapTargetCommandQueueMutex;
+	std::condition_variable rmapTargetCommandQueueCondition;
+	bool rmapTargetProcessThreadsStopped;
+	size_t nRMAPTargetProcessThreads;
+	size_t rmapTargetCommandQueueCapacity;
+
+private:
+	//deadlines of transactions waiting for a reply (1 tick = 1 ms since timerWheelEpoch)
+	RMAPTransactionTimerWheel timerWheel;
+	std::mutex timerWheelMutex;
+	std::condition_variable timerWheelCondition;
+	std::chrono::steady_clock::time_point timerWheelEpoch;
+	//tick until which the timeout thread sleeps; an earlier deadline wakes it up
+	uint64_t timerWheelWakeUpTick;
+	RMAPTransactionTimeoutThread* transactionTimeoutThread;
+	bool transactionTimeoutThreadStopped;
 
 public:
 	static const size_t MaximumTIDNumber = 65536;
+	static const size_t DefaultNumberOfRMAPTargetProcessThreads = 4;
+	static const size_t DefaultRMAPTargetCommandQueueCapacity = 1024;
+	/** The number of late reply packets retained in discardedRMAPReplyPackets. Older ones are deleted. */
+	static const size_t DefaultDiscardedRMAPReplyPacketsCapacity = 16;
+	/** The maximum number of queued packets written with one SpaceWireIF::sendMany() call. */
+	static const size_t MaximumPacketsPerSendBatch = 128;
+	/** A batch is closed when it reaches this size, so that a high-priority packet
+	 * does not wait long behind large bulk packets written in the same batch.
+	 */
+	static const size_t MaximumBytesPerSendBatch = 65536;
+	/** Default number of packets taken from each priority class per scheduling round. */
+	static const size_t DefaultHighPriorityClassWeight = 8;
+	static const size_t DefaultNormalPriorityClassWeight = 4;
+	static const size_t DefaultBulkPriorityClassWeight = 1;
 	static constexpr double DefaultReceiveTimeoutDurationInMicroSec = 200000; //200ms
 
 private:
-	SpaceWireIF* spwif;
-	CxxUtilities::Mutex spwSendMutex;
+	/** A packet waiting in the send queue. Lives on the stack of the thread which invoked sendPacket(). */
+	struct PendingPacket {
+		std::vector<uint8_t>* bytes;
+		uint32_t priorityClass;
+		std::chrono::steady_clock::time_point enqueuedTime;
+		bool sent;
+		bool failed;
+	};
+
+public:
+	/** Statistics of the send queue of a priority class. Times are in microsecond. */
+	struct SendQueueStatistics {
+		size_t depth;
+		size_t maxDepth;
+		size_t nSentPackets;
+		double totalWaitTime;
+		double maxWaitTime;
+
+	public:
+		double getAverageWaitTime() const {
+			return (nSentPackets != 0) ? totalWaitTime / nSentPackets : 0;
+		}
+	};
+
+public:
+	/** A SpaceWireIF served by RMAPEngine, with its own receive thread, send queues, and
+	 * partition of the transaction ID space. Commands are sent via the link selected by
+	 * RMAPTransaction::linkIndex (RMAPTargetNode::getLinkIndex() for RMAPInitiator),
+	 * and replies to received commands are sent via the link which received the command.
+	 */
+	class Link {
+	public:
+		size_t index;
+		SpaceWireIF* spwif;
+		//CPU core to which the receive thread is pinned (-1 if not pinned)
+		int receiveThreadCPUCore;
+		RMAPLinkReceiveThread* receiveThread;
+		//filled by SpaceWireIF, and swapped into a received RMAPPacket by receivePacket()
+		std::vector<uint8_t> receiveBuffer;
+
+	public:
+		//free transaction IDs of this link
+		RMAPTransactionIDRing availableTransactionIDRing;
+		size_t firstTransactionID;
+		size_t nTransactionIDs;
+
+	public:
+		//flat-combining send queues, one per priority class; see sendPacket()
+		std::deque<PendingPacket*> sendQueues[RMAPTransaction::NumberOfPriorityClasses];
+		size_t priorityClassWeights[RMAPTransaction::NumberOfPriorityClasses];
+		SendQueueStatistics sendQueueStatistics[RMAPTransaction::NumberOfPriorityClasses];
+		std::mutex sendQueueMutex;
+		std::condition_variable sendCompletedCondition;
+		bool sendInProgress;
+		std::vector<PendingPacket*> sendBatch;
+		std::vector<std::vector<uint8_t>*> sendBatchBytes;
+
+	public:
+		//epoch of the dispatch index when the receive thread started a lookup (0 while not looking up)
+		std::atomic<uint64_t> rmapTargetDispatchIndexEpoch;
+		//set when the receive thread finished due to disconnection or an error; cleared by start()
+		std::atomic<bool> failed;
+
+	public:
+		size_t nReceivedPackets;
+		//send batching counters (updated while holding sendQueueMutex)
+		size_t nSentPackets;
+		size_t nSendBatches;
+		size_t maxSendBatchSize;
+
+	public:
+		Link(size_t index, SpaceWireIF* spwif) {
+			this->index = index;
+			this->spwif = spwif;
+			receiveThreadCPUCore = -1;
+			receiveThread = NULL;
+			firstTransactionID = 0;
+			nTransactionIDs = 0;
+			sendInProgress = false;
+			rmapTargetDispatchIndexEpoch = 0;
+			failed = false;
+			priorityClassWeights[RMAPTransaction::HighPriorityClass] = DefaultHighPriorityClassWeight;
+			priorityClassWeights[RMAPTransaction::NormalPriorityClass] = DefaultNormalPriorityClassWeight;
+			priorityClassWeights[RMAPTransaction::BulkPriorityClass] = DefaultBulkPriorityClassWeight;
+			initializeCounters();
+		}
+
+	public:
+		void initializeCounters() {
+			nReceivedPackets = 0;
+			nSentPackets = 0;
+			nSendBatches = 0;
+			maxSendBatchSize = 0;
+			for (size_t i = 0; i < RMAPTransaction::NumberOfPriorityClasses; i++) {
+				sendQueueStatistics[i].depth = 0;
+				sendQueueStatistics[i].maxDepth = 0;
+				sendQueueStatistics[i].nSentPackets = 0;
+				sendQueueStatistics[i].totalWaitTime = 0;
+				sendQueueStatistics[i].maxWaitTime = 0;
+			}
+		}
+	};
+
+private:
+	//links[0] is the primary link set via the constructor or setSpaceWireIF()
+	std::vector<Link*> links;
 
 private:
 	RMAPEngineSpaceWireIFActionCloseAction* spacewireIFActionCloseAction;
 
 public:
-	bool stopped;
-	bool hasStopped;
+	std::atomic<bool> stopped;
+	std::atomic<bool> hasStopped;
 	CxxUtilities::Actions<void> rmapEngineStoppedActions;
 
 public:
-	size_t nDiscardedReceivedPackets;
-	size_t nErrorneousReplyPackets;
-	size_t nErrorneousCommandPackets;
-	size_t nTransactionsAbortedWhenReplying;
-	size_t nErrorInRMAPReplyPacketProcessing;
+	//incremented by the receive threads of all the links
+	std::atomic<size_t> nDiscardedReceivedPackets;
+	std::atomic<size_t> nErrorneousReplyPackets;
+	std::atomic<size_t> nErrorneousCommandPackets;
+	std::atomic<size_t> nTransactionsAbortedWhenReplying;
+	std::atomic<size_t> nErrorInRMAPReplyPacketProcessing;
+	//RMAP target backpressure counters
+	std::atomic<size_t> nRMAPTargetCommandsProcessedInline;
+	std::atomic<size_t> nRMAPTargetCommandsQueued;
+	std::atomic<size_t> nRMAPTargetCommandsRejectedDueToFullQueue;
+	std::atomic<size_t> maxRMAPTargetCommandQueueDepth;
+	//transactions expired by the timer wheel
+	std::atomic<size_t> nTimedOutTransactions;
+	//links whose receive thread finished due to disconnection or an error (see isLinkFailed())
+	std::atomic<size_t> nFailedLinks;
 
 private:
 	bool stopActionsHasBeenExecuted;
 
 public:
 	RMAPEngine() {
-		spwif = NULL;
 		initialize();
 	}
 
@@ -256,23 +615,51 @@ public:
 
 public:
 	~RMAPEngine() {
-		if(spwif!=NULL){
-			spwif->cancelReceive();
+		for (size_t i = 0; i < links.size(); i++) {
+			if (links[i]->spwif != NULL) {
+				links[i]->spwif->cancelReceive();
+			}
+		}
+		for (size_t i = 0; i < links.size(); i++) {
+			delete links[i];
+		}
+		for (size_t i = 0; i < rmapTargets.size(); i++) {
+			rmapTargets[i]->removeModifiedAction(rmapTargetModifiedAction);
+		}
+		delete rmapTargetModifiedAction;
+		delete rmapTargetDispatchIndex.load();
+		for (size_t i = 0; i < retiredRMAPTargetDispatchIndices.size(); i++) {
+			delete retiredRMAPTargetDispatchIndices[i].first;
 		}
 	}
 
 private:
 	void initialize() {
-		transactionIDMutex.lock();
-		latestAssignedTransactionID = 0;
+		transactions.reset(new std::atomic<RMAPTransaction*>[MaximumTIDNumber]);
+		transactionIDIsInRing.reset(new std::atomic<bool>[MaximumTIDNumber]);
 		for (size_t i = 0; i < MaximumTIDNumber; i++) {
-			availableTransactionIDList.push_back(i);
+			transactions[i].store(NULL, std::memory_order_relaxed);
+			transactionIDIsInRing[i].store(true, std::memory_order_relaxed);
 		}
-		transactionIDMutex.unlock();
+		links.push_back(new Link(0, NULL));
+		partitionTransactionIDs();
+		rmapTargetsVersion = 0;
+		rmapTargetModifiedAction = new RMAPEngineRMAPTargetModifiedAction(this);
+		rmapTargetDispatchIndex = NULL;
+		rmapTargetDispatchIndexEpoch = 1;
+		nTransactions = 0;
 		stopped = true;
 		spacewireIFActionCloseAction = NULL;
 		stopActionsHasBeenExecuted = false;
 		useDraftECRC = false;
+		nRMAPTargetProcessThreads = DefaultNumberOfRMAPTargetProcessThreads;
+		rmapTargetCommandQueueCapacity = DefaultRMAPTargetCommandQueueCapacity;
+		rmapTargetProcessThreadsStopped = true;
+		timerWheelEpoch = std::chrono::steady_clock::now();
+		timerWheelWakeUpTick = 0;
+		transactionTimeoutThread = NULL;
+		transactionTimeoutThreadStopped = true;
+		discardedRMAPReplyPacketsCapacity = DefaultDiscardedRMAPReplyPacketsCapacity;
 		//initialize counters
 		initializeCounters();
 	}
@@ -284,6 +671,32 @@ private:
 		nErrorneousCommandPackets = 0;
 		nTransactionsAbortedWhenReplying = 0;
 		nErrorInRMAPReplyPacketProcessing = 0;
+		nRMAPTargetCommandsProcessedInline = 0;
+		nRMAPTargetCommandsQueued = 0;
+		nRMAPTargetCommandsRejectedDueToFullQueue = 0;
+		maxRMAPTargetCommandQueueDepth = 0;
+		nTimedOutTransactions = 0;
+		nFailedLinks = 0;
+		for (size_t i = 0; i < links.size(); i++) {
+			links[i]->initializeCounters();
+		}
+	}
+
+private:
+	/** Divides the transaction ID space equally among the links, and refills the rings of free IDs.
+	 * Invoked only while no transaction is outstanding (i.e. the engine is stopped).
+	 */
+	void partitionTransactionIDs() {
+		transactionIDPartitionSize = (MaximumTIDNumber + links.size() - 1) / links.size();
+		for (size_t i = 0; i < links.size(); i++) {
+			Link* link = links[i];
+			link->firstTransactionID = i * transactionIDPartitionSize;
+			link->nTransactionIDs = std::min(transactionIDPartitionSize, MaximumTIDNumber - link->firstTransactionID);
+			link->availableTransactionIDRing.reset(link->firstTransactionID, link->nTransactionIDs);
+		}
+		for (size_t i = 0; i < MaximumTIDNumber; i++) {
+			transactionIDIsInRing[i].store(true, std::memory_order_relaxed);
+		}
 	}
 
 public:
@@ -292,39 +705,116 @@ public:
 		stopped = false;
 		hasStopped = false;
 		stopActionsHasBeenExecuted = false;
-		spwif->setTimeoutDuration(DefaultReceiveTimeoutDurationInMicroSec);
+		for (size_t i = 0; i < links.size(); i++) {
+			links[i]->spwif->setTimeoutDuration(DefaultReceiveTimeoutDurationInMicroSec);
+		}
+		startRMAPTargetProcessThreads();
+		startTransactionTimeoutThread();
+		startLinkReceiveThreads();
+		//the primary link is served by this thread; the engine stops when it is disconnected
+		receivePackets(links[0]);
+		stopped = true;
+		stopLinkReceiveThreads();
+		stopTransactionTimeoutThread();
+		stopRMAPTargetProcessThreads();
+		invokeRegisteredStopActions();
+		hasStopped = true;
+	}
+
+private:
+	/** Receives and dispatches packets from a link until the engine is stopped or the link is disconnected. */
+	void receivePackets(Link* link) {
+		using namespace std;
+		if (link->receiveThreadCPUCore >= 0) {
+			pinCurrentThreadToCPUCore(link->receiveThreadCPUCore);
+		}
 		while (!stopped) {
 			try {
-				RMAPPacket* rmapPacket = receivePacket();
+				RMAPPacket* rmapPacket = receivePacket(link);
 				if (rmapPacket == NULL) {
 					//do nothing
 				} else if (rmapPacket->isCommand()) {
-					rmapCommandPacketReceived(rmapPacket);
+					rmapCommandPacketReceived(rmapPacket, link);
 				} else {
 					rmapReplyPacketReceived(rmapPacket);
 				}
 			} catch (RMAPPacketException& e) {
-				cerr << "RMAPEngine::run() got RMAPPacketException " << e.toString() << endl;
+				cerr << "RMAPEngine::run() got RMAPPacketException " << e.toString() << " (link " << link->index << ")"
+						<< endl;
+				linkFailed(link);
 				break;
 			} catch (RMAPEngineException& e) {
-				cerr << "RMAPEngine::run() got RMAPEngineException " << e.toString() << endl;
+				cerr << "RMAPEngine::run() got RMAPEngineException " << e.toString() << " (link " << link->index << ")"
+						<< endl;
+				linkFailed(link);
 				break;
 			}
 		}
-		stopped = true;
-		invokeRegisteredStopActions();
-		hasStopped = true;
+	}
+
+private:
+	/** Marks a link whose receive thread is finishing. Transactions are not initiated via the link any more
+	 * (initiateTransaction() throws LinkHasFailed), while the other links keep being served.
+	 */
+	void linkFailed(Link* link) {
+		if (!stopped && !link->failed.exchange(true)) {
+			nFailedLinks++;
+		}
+	}
+
+public:
+	/** Returns true if the receive thread of a link finished due to disconnection or an error
+	 * while the engine was running.
+	 */
+	bool isLinkFailed(size_t linkIndex) throw (RMAPEngineException) {
+		return getLink(linkIndex)->failed;
+	}
+
+private:
+	/** Pins the calling thread to a CPU core. Ignored on platforms other than Linux. */
+	static void pinCurrentThreadToCPUCore(int cpuCore) {
+#ifdef __linux__
+		cpu_set_t cpuSet;
+		CPU_ZERO(&cpuSet);
+		CPU_SET(cpuCore, &cpuSet);
+		if (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuSet) != 0) {
+			std::cerr << "RMAPEngine: receive thread could not be pinned to CPU core " << cpuCore << std::endl;
+		}
+#endif
+	}
+
+private:
+	void startLinkReceiveThreads() {
+		links[0]->failed = false;
+		for (size_t i = 1; i < links.size(); i++) {
+			links[i]->failed = false;
+			links[i]->receiveThread = new RMAPLinkReceiveThread(this, links[i]);
+			links[i]->receiveThread->start();
+		}
+	}
+
+private:
+	void stopLinkReceiveThreads() {
+		for (size_t i = 1; i < links.size(); i++) {
+			if (links[i]->receiveThread != NULL) {
+				links[i]->spwif->cancelReceive();
+				links[i]->receiveThread->waitUntilRunMethodComplets();
+				delete links[i]->receiveThread;
+				links[i]->receiveThread = NULL;
+			}
+		}
 	}
 
 public:
 	void stop() {
 		using namespace std;
-		if (stopped == false) {
-			stopped = true;
-			spwif->cancelReceive();
+		if (!stopped.exchange(true)) {
+			for (size_t i = 0; i < links.size(); i++) {
+				links[i]->spwif->cancelReceive();
+			}
 			do {
 				CxxUtilities::Condition c;
-				c.wait(spwif->getTimeoutDurationInMicroSec() / 1000.0 /* in milli sec */);
+				c.wait(links[0]->spwif->getTimeoutDurationInMicroSec() / 1000.0 /* in milli sec */);
 			} while (hasStopped != true);
 		}
 	}
@@ -344,49 +834,307 @@ public:
 	}
 
 private:
-	void rmapCommandPacketReceived(RMAPPacket* commandPacket) throw (RMAPEngineException) {
+	void rmapCommandPacketReceived(RMAPPacket* commandPacket, Link* link) throw (RMAPEngineException) {
 		using namespace std;
-		//first cleanup completed threads
-		std::vector<RMAPTargetProcessThread*> newRMAPTargetProcessThreads;
-		for (size_t i = 0; i < rmapTargetProcessThreads.size(); i++) {
-			if (rmapTargetProcessThreads[i]->isCompleted()) {
-				delete rmapTargetProcessThreads[i];
+		//find an RMAPTarget instance which can accept the accessed address range
+		RMAPTargetAccessAction* rmapTargetAcessAction = findRMAPTargetAccessAction(commandPacket, link);
+		if (rmapTargetAcessAction == NULL) {
+			rmapPacketPool.release(commandPacket);
+			receivedCommandPacketDiscarded();
+			return;
+		}
+		RMAPTransaction* rmapTransaction = acquireRMAPTargetTransaction(commandPacket, link);
+		if (nRMAPTargetProcessThreads == 0 || rmapTargetAcessAction->isInlineProcessingAllowed()) {
+			//fast actions are processed in the receive thread without a thread hand-over
+			nRMAPTargetCommandsProcessedInline++;
+			processRMAPTargetTransaction(rmapTransaction, rmapTargetAcessAction);
+		} else if (!pushRMAPTargetCommand(rmapTransaction, rmapTargetAcessAction)) {
+			//backpressure: the command is discarded when all workers are busy and the queue is full
+			nRMAPTargetCommandsRejectedDueToFullQueue++;
+			releaseRMAPTargetTransaction(rmapTransaction);
+			receivedCommandPacketDiscarded();
+		}
+	}
+
+private:
+	/** Searches the dispatch index for the action of a command received via a link.
+	 * During the search, the link holds the epoch at which the search started, so that an index
+	 * replaced meanwhile is not deleted while it is being searched.
+	 */
+	RMAPTargetAccessAction* findRMAPTargetAccessAction(RMAPPacket* commandPacket, Link* link) {
+		link->rmapTargetDispatchIndexEpoch.store(rmapTargetDispatchIndexEpoch.load());
+		RMAPTargetAccessAction* rmapTargetAccessAction = getRMAPTargetDispatchIndex()->find(commandPacket);
+		link->rmapTargetDispatchIndexEpoch.store(0, std::memory_order_release);
+		return rmapTargetAccessAction;
+	}
+
+private:
+	/** Returns the dispatch index of the registered targets, rebuilding it if a target has been added,
+	 * removed, or modified. Invoked only via findRMAPTargetAccessAction().
+	 */
+	RMAPTargetDispatchIndex* getRMAPTargetDispatchIndex() {
+		RMAPTargetDispatchIndex* index = rmapTargetDispatchIndex.load();
+		if (index != NULL && index->getVersion() == rmapTargetsVersion.load()) {
+			return index;
+		}
+		std::lock_guard<std::mutex> guard(rmapTargetsMutex);
+		index = rmapTargetDispatchIndex.load();
+		size_t version = rmapTargetsVersion.load();
+		if (index != NULL && index->getVersion() == version) {
+			return index;
+		}
+		RMAPTargetDispatchIndex* newIndex = new RMAPTargetDispatchIndex(rmapTargets, version);
+		rmapTargetDispatchIndex.store(newIndex);
+		if (index != NULL) {
+			//a search which loaded the replaced index started at this epoch or earlier
+			retiredRMAPTargetDispatchIndices.push_back(std::make_pair(index, rmapTargetDispatchIndexEpoch.load()));
+		}
+		rmapTargetDispatchIndexEpoch++;
+		deleteUnusedRMAPTargetDispatchIndices();
+		return newIndex;
+	}
+
+private:
+	/** Deletes retired indices which were replaced before the oldest search in progress started.
+	 * Invoked while holding rmapTargetsMutex. Links are not added while the engine is running.
+	 */
+	void deleteUnusedRMAPTargetDispatchIndices() {
+		uint64_t oldestEpochInUse = std::numeric_limits<uint64_t>::max();
+		for (size_t i = 0; i < links.size(); i++) {
+			uint64_t epoch = links[i]->rmapTargetDispatchIndexEpoch.load();
+			if (epoch != 0 && epoch < oldestEpochInUse) {
+				oldestEpochInUse = epoch;
+			}
+		}
+		size_t nRetained = 0;
+		for (size_t i = 0; i < retiredRMAPTargetDispatchIndices.size(); i++) {
+			if (retiredRMAPTargetDispatchIndices[i].second < oldestEpochInUse) {
+				delete retiredRMAPTargetDispatchIndices[i].first;
 			} else {
-				newRMAPTargetProcessThreads.push_back(rmapTargetProcessThreads[i]);
+				retiredRMAPTargetDispatchIndices[nRetained++] = retiredRMAPTargetDispatchIndices[i];
 			}
 		}
-		rmapTargetProcessThreads = newRMAPTargetProcessThreads;
+		retiredRMAPTargetDispatchIndices.resize(nRetained);
+	}
 
-		//find an RMAPTarget instance which can accept the accessed address range
-		auto rmapTransaction = std::unique_ptr<RMAPTransaction>(new RMAPTransaction);
+public:
+	/** Returns the number of replaced dispatch indices which have not been deleted yet. */
+	size_t getNRetiredRMAPTargetDispatchIndices() {
+		std::lock_guard<std::mutex> guard(rmapTargetsMutex);
+		return retiredRMAPTargetDispatchIndices.size();
+	}
+
+private:
+	/** Takes a recycled transaction from the pool, and resets the fields used by the target side.
+	 * The reply is sent via the link which received the command.
+	 */
+	RMAPTransaction* acquireRMAPTargetTransaction(RMAPPacket* commandPacket, Link* link) {
+		RMAPTransaction* rmapTransaction = rmapTransactionPool.acquire();
 		rmapTransaction->commandPacket = commandPacket;
+		rmapTransaction->linkIndex = link->index;
+		rmapTransaction->replyPacket = NULL;
+		rmapTransaction->packetPool = &rmapPacketPool;
+		rmapTransaction->completionAction = NULL;
 		rmapTransaction->setState(RMAPTransaction::CommandPacketReceived);
-		for (size_t i = 0; i < rmapTargets.size(); i++) {
-			RMAPTargetAccessAction* rmapTargetAcessAction = rmapTargets[i]->getCorrespondingRMAPTargetAccessAction(
-					rmapTransaction.get());
-			if (rmapTargetAcessAction != NULL) {
-				RMAPTargetProcessThread* aThread =
-						new RMAPTargetProcessThread(this, std::move(rmapTransaction), rmapTargetAcessAction);
-				aThread->start();
-				rmapTargetProcessThreads.push_back(aThread);
-				return;
+		return rmapTransaction;
+	}
+
+private:
+	/** Returns the command packet and the transaction to the pools. */
+	void releaseRMAPTargetTransaction(RMAPTransaction* rmapTransaction) {
+		rmapPacketPool.release(rmapTransaction->commandPacket);
+		rmapTransaction->commandPacket = NULL;
+		rmapTransactionPool.release(rmapTransaction);
+	}
+
+private:
+	bool pushRMAPTargetCommand(RMAPTransaction* rmapTransaction, RMAPTargetAccessAction* rmapTargetAcessAction) {
+		{
+			std::lock_guard<std::mutex> guard(rmapTargetCommandQueueMutex);
+			if (rmapTargetCommandQueue.size() >= rmapTargetCommandQueueCapacity) {
+				return false;
+			}
+			rmapTargetCommandQueue.push_back(std::make_pair(rmapTransaction, rmapTargetAcessAction));
+			nRMAPTargetCommandsQueued++;
+			if (maxRMAPTargetCommandQueueDepth < rmapTargetCommandQueue.size()) {
+				maxRMAPTargetCommandQueueDepth = rmapTargetCommandQueue.size();
 			}
 		}
-		delete commandPacket;
-		receivedCommandPacketDiscarded();
+		rmapTargetCommandQueueCondition.notify_one();
+		return true;
 	}
 
 private:
+	/** Waits for a queued command. Returns false when the worker threads are being stopped. */
+	bool popRMAPTargetCommand(RMAPTransaction*& rmapTransaction, RMAPTargetAccessAction*& rmapTargetAcessAction) {
+		std::unique_lock<std::mutex> lock(rmapTargetCommandQueueMutex);
+		while (rmapTargetCommandQueue.empty() && !rmapTargetProcessThreadsStopped) {
+			rmapTargetCommandQueueCondition.wait(lock);
+		}
+		if (rmapTargetCommandQueue.empty()) {
+			return false;
+		}
+		rmapTransaction = rmapTargetCommandQueue.front().first;
+		rmapTargetAcessAction = rmapTargetCommandQueue.front().second;
+		rmapTargetCommandQueue.pop_front();
+		return true;
+	}
+
+private:
+	/** Processes an RMAP command, and sends a reply. The transaction is returned to the pool in this method. */
+	void processRMAPTargetTransaction(RMAPTransaction* rmapTransaction, RMAPTargetAccessAction* rmapTargetAcessAction) {
+		using namespace std;
+		try {
+			rmapTargetAcessAction->processTransaction(rmapTransaction);
+			rmapTransaction->setState(RMAPTransaction::ReplySet);
+		} catch (...) {
+			releaseRMAPTargetTransaction(rmapTransaction);
+			receivedCommandPacketDiscarded();
+			return;
+		}
+		if (!rmapTransaction->commandPacket->isReplyFlagSet()) {
+			//no reply is sent for a command without the reply flag (e.g. a write without reply)
+			try {
+				rmapTargetAcessAction->transactionWillComplete(rmapTransaction);
+			} catch (...) {
+			}
+			rmapTransaction->setState(RMAPTransaction::ReplyCompleted);
+			releaseRMAPTargetTransaction(rmapTransaction);
+			return;
+		}
+		try {
+			//getPacketBufferPointer() constructs the packet
+			sendPacket(rmapTransaction->replyPacket->getPacketBufferPointer(), RMAPTransaction::NormalPriorityClass,
+					rmapTransaction->linkIndex);
+			rmapTransaction->setState(RMAPTransaction::ReplySent);
+		} catch (...) {
+			try {
+				rmapTargetAcessAction->transactionReplyCouldNotBeSent(rmapTransaction);
+			} catch (...) {
+			}
+			replyToReceivedCommandPacketCouldNotBeSent();
+			releaseRMAPTargetTransaction(rmapTransaction);
+			return;
+		}
+		try {
+			rmapTargetAcessAction->transactionWillComplete(rmapTransaction);
+		} catch (...) {
+		}
+		rmapTransaction->setState(RMAPTransaction::ReplyCompleted);
+		releaseRMAPTargetTransaction(rmapTransaction);
+	}
+
+private:
+	void startRMAPTargetProcessThreads() {
+		rmapTargetProcessThreadsStopped = false;
+		for (size_t i = 0; i < nRMAPTargetProcessThreads; i++) {
+			RMAPTargetProcessThread* aThread = new RMAPTargetProcessThread(this);
+			aThread->start();
+			rmapTargetProcessThreads.push_back(aThread);
+		}
+	}
+
+private:
+	/** Stops worker threads after they have processed queued commands. */
+	void stopRMAPTargetProcessThreads() {
+		{
+			std::lock_guard<std::mutex> guard(rmapTargetCommandQueueMutex);
+			rmapTargetProcessThreadsStopped = true;
+			for (size_t i = 0; i < rmapTargetProcessThreads.size(); i++) {
+				rmapTargetProcessThreads[i]->stop();
+			}
+		}
+		rmapTargetCommandQueueCondition.notify_all();
+		for (size_t i = 0; i < rmapTargetProcessThreads.size(); i++) {
+			rmapTargetProcessThreads[i]->waitUntilRunMethodComplets();
+			delete rmapTargetProcessThreads[i];
+		}
+		rmapTargetProcessThreads.clear();
+	}
+
+public:
+	/** Sets the number of worker threads which process RMAP commands received by RMAPTarget instances.
+	 * If 0, all commands are processed in the receive thread of RMAPEngine.
+	 * Effective when RMAPEngine is started next time.
+	 */
+	void setNumberOfRMAPTargetProcessThreads(size_t nThreads) {
+		nRMAPTargetProcessThreads = nThreads;
+	}
+
+public:
+	size_t getNumberOfRMAPTargetProcessThreads() {
+		return nRMAPTargetProcessThreads;
+	}
+
+public:
+	/** Sets the maximum number of commands waiting for a worker thread.
+	 * Commands received while the queue is full are discarded and counted
+	 * in nRMAPTargetCommandsRejectedDueToFullQueue.
+	 */
+	void setRMAPTargetCommandQueueCapacity(size_t capacity) {
+		std::lock_guard<std::mutex> guard(rmapTargetCommandQueueMutex);
+		rmapTargetCommandQueueCapacity = capacity;
+	}
+
+public:
+	size_t getRMAPTargetCommandQueueCapacity() {
+		return rmapTargetCommandQueueCapacity;
+	}
+
+public:
+	size_t getRMAPTargetCommandQueueDepth() {
+		std::lock_guard<std::mutex> guard(rmapTargetCommandQueueMutex);
+		return rmapTargetCommandQueue.size();
+	}
+
+private:
+	//the latest late (or unexpected) reply packets, bounded by discardedRMAPReplyPacketsCapacity
 	std::vector<RMAPPacket*> discardedRMAPReplyPackets;
+	size_t discardedRMAPReplyPacketsCapacity;
+	//replies are received by the receive threads of all the links
+	std::mutex discardedRMAPReplyPacketsMutex;
 
 private:
 	size_t getNDiscardedRMAPReplyPackets(){
+		std::lock_guard<std::mutex> guard(discardedRMAPReplyPacketsMutex);
 		return discardedRMAPReplyPackets.size();
 	}
 
 public:
-	std::vector<RMAPPacket*>* getDiscardedRMAPReplyPackets(){
-		return &discardedRMAPReplyPackets;
+	/** Returns the retained late reply packets, oldest first.
+	 * The packets remain owned by the engine, and are recycled when evicted by newer late replies.
+	 */
+	std::vector<RMAPPacket*> getDiscardedRMAPReplyPackets(){
+		std::lock_guard<std::mutex> guard(discardedRMAPReplyPacketsMutex);
+		return discardedRMAPReplyPackets;
+	}
+
+public:
+	/** Sets the number of late reply packets retained for inspection.
+	 * When more are received, the oldest one is deleted. If 0, late replies are deleted immediately.
+	 * All late replies are counted in nErrorneousReplyPackets regardless of this setting.
+	 */
+	void setDiscardedRMAPReplyPacketsCapacity(size_t capacity) {
+		discardedRMAPReplyPacketsCapacity = capacity;
+	}
+
+public:
+	size_t getDiscardedRMAPReplyPacketsCapacity() {
+		return discardedRMAPReplyPacketsCapacity;
+	}
+
+private:
+	void retainDiscardedRMAPReplyPacket(RMAPPacket* packet) {
+		std::lock_guard<std::mutex> guard(discardedRMAPReplyPacketsMutex);
+		if (discardedRMAPReplyPacketsCapacity == 0) {
+			rmapPacketPool.release(packet);
+			return;
+		}
+		while (discardedRMAPReplyPackets.size() >= discardedRMAPReplyPacketsCapacity) {
+			rmapPacketPool.release(discardedRMAPReplyPackets.front());
+			discardedRMAPReplyPackets.erase(discardedRMAPReplyPackets.begin());
+		}
+		discardedRMAPReplyPackets.push_back(packet);
 	}
 
 private:
@@ -403,20 +1151,14 @@ private:
 			} catch (RMAPEngineException& e) {
 				//if not found, increment error counter
 				nErrorneousReplyPackets++;
-				discardedRMAPReplyPackets.push_back(packet);
-				std::cerr << "RMAP Reply packet (dataLength="<< packet->getLength() <<  "bytes) was received but no corresponding transaction was found. The size of discardedRMAPReplyPackets = " << discardedRMAPReplyPackets.size() << std::endl;
+				std::cerr << "RMAP Reply packet (dataLength="<< packet->getLength() <<  "bytes) was received but no corresponding transaction was found. The number of discarded reply packets = " << nErrorneousReplyPackets << std::endl;
+				retainDiscardedRMAPReplyPacket(packet);
 				return;
 			}
 			//register reply packet to the resolved transaction
 			transaction->replyPacket = packet;
 			//update transaction state
-			{
-				std::lock_guard<std::mutex> stateGuard(transaction->stateMutex);
-				transaction->setState(RMAPTransaction::ReplyReceived);
-			}
-			if (!transaction->isNonblockingMode) {
-				transaction->getCondition()->signal();
-			}
+			transactionFinished(transaction, RMAPTransaction::ReplyReceived);
 		} catch (CxxUtilities::MutexException& e) {
 			std::cerr << "Fatal error in RMAPEngine::rmapReplyPacketReceived()... :-(" << std::endl;
 			std::cerr << "RMAPEngine tries to recover normal operation, but may fail continuously." << std::endl;
@@ -446,13 +1188,38 @@ private:
 	bool useDraftECRC;
 
 private:
-	RMAPPacket* receivePacket() throw (RMAPEngineException) {
+	//received packets and target-side transactions are recycled instead of being allocated per packet
+	RMAPObjectPool<RMAPPacket> rmapPacketPool;
+	RMAPObjectPool<RMAPTransaction> rmapTransactionPool;
+
+public:
+	/** Returns a reply packet handed over via RMAPTransaction::replyPacket to the packet pool.
+	 * The packet should not be used after this call. Deleting the packet instead is also allowed.
+	 */
+	void releaseRMAPPacket(RMAPPacket* packet) {
+		rmapPacketPool.release(packet);
+	}
+
+public:
+	/** Returns the pool of received packets (and reply packets of RMAPTarget).
+	 * nAllocatedObjects of the pool does not increase once traffic reaches a steady state.
+	 */
+	RMAPObjectPool<RMAPPacket>* getRMAPPacketPool() {
+		return &rmapPacketPool;
+	}
+
+public:
+	/** Returns the pool of transactions used for received RMAP commands. */
+	RMAPObjectPool<RMAPTransaction>* getRMAPTransactionPool() {
+		return &rmapTransactionPool;
+	}
+
+private:
+	RMAPPacket* receivePacket(Link* link) throw (RMAPEngineException) {
 		using namespace std;
-		std::vector<uint8_t>* buffer = new std::vector<uint8_t>;
 		try {
-			spwif->receive(buffer);
+			link->spwif->receive(&(link->receiveBuffer));
 		} catch (SpaceWireIFException& e) {
-			delete buffer;
 			//cout << e.toString() << endl;
 			if (e.status == SpaceWireIFException::Disconnected) {
 				//tell run() that SpaceWireIF is disconnected
@@ -467,41 +1234,57 @@ private:
 				}
 			}
 		}
-		RMAPPacket* packet = new RMAPPacket();
+		RMAPPacket* packet = rmapPacketPool.acquire();
 		if (!useDraftECRC) {
 			packet->setUseDraftECRC(false);
 		} else {
 			packet->setUseDraftECRC(true);
 		}
 		try {
-			packet->interpretAsAnRMAPPacket(buffer);
+			//the packet takes over the received bytes, and receiveBuffer gets the packet's empty buffer
+			packet->interpretAsAnRMAPPacketInPlace(link->receiveBuffer);
 		} catch (RMAPPacketException& e) {
-			delete packet;
-			delete buffer;
+			rmapPacketPool.release(packet);
 			receivedPacketDiscarded();
 			return NULL;
 		}
-		delete buffer;
+		link->nReceivedPackets++;
 		return packet;
 	}
 
 private:
 	RMAPTransaction* resolveTransaction(RMAPPacket* packet) throw (RMAPEngineException) {
 		using namespace std;
-		transactionIDMutex.lock();
 		uint16_t transactionID = packet->getTransactionID();
-		if (isTransactionIDAvailable(transactionID) == true) { //if tid is not in use
-			transactionIDMutex.unlock();
+		//resolve and unregister the transaction in one step
+		RMAPTransaction* transaction = transactions[transactionID].exchange(NULL);
+		if (transaction == NULL) { //if tid is not in use
 			throw RMAPEngineException(RMAPEngineException::UnexpectedRMAPReplyPacketWasReceived, packet);
-		} else { //if tid is registered to tid db
-			//resolve transaction
-			RMAPTransaction* transaction = transactions[transactionID];
-			//delete registered tid
-			deleteTransactionIDFromDB(transactionID);
-			//unlock mutex
-			transactionIDMutex.unlock();
-			//return resolved transaction
-			return transaction;
+		}
+		nTransactions--;
+		pushBackUtilizedTransactionID(transactionID);
+		unscheduleTransactionTimeout(transaction);
+		return transaction;
+	}
+
+private:
+	/** Updates the state of a resolved or expired transaction, and notifies the initiator.
+	 * The condition is signaled while holding stateMutex so that a waiting initiator,
+	 * which takes stateMutex after waking up, does not reuse the transaction before this returns.
+	 */
+	void transactionFinished(RMAPTransaction* transaction, uint32_t state) {
+		if (transaction->completionAction != NULL) {
+			{
+				std::lock_guard<std::mutex> stateGuard(transaction->stateMutex);
+				transaction->setState(state);
+			}
+			transaction->completionAction->doAction(transaction);
+		} else {
+			std::lock_guard<std::mutex> stateGuard(transaction->stateMutex);
+			transaction->setState(state);
+			if (!transaction->isNonblockingMode) {
+				transaction->getCondition()->signal();
+			}
 		}
 	}
 
@@ -514,133 +1297,473 @@ public:
 	void initiateTransaction(RMAPTransaction* transaction) throw (RMAPEngineException) {
 		using namespace std;
 		transaction->state = RMAPTransaction::NotInitiated;
+		if (!isStarted()) {
+			throw RMAPEngineException(RMAPEngineException::RMAPEngineIsNotStarted);
+		}
+		if (transaction->linkIndex >= links.size()) {
+			throw RMAPEngineException(RMAPEngineException::NoSuchLink);
+		}
+		if (links[transaction->linkIndex]->failed) {
+			throw RMAPEngineException(RMAPEngineException::LinkHasFailed);
+		}
+		//published before registering so that the state set by a reply (or expiry) is not overwritten,
+		//and stateMutex is not held while the packet waits in the send queue
+		{
+			std::lock_guard<std::mutex> stateGuard(transaction->stateMutex);
+			transaction->state = RMAPTransaction::Initiated;
+		}
 		uint16_t transactionID;
 		RMAPPacket* commandPacket = transaction->getCommandPacket();
-		if (transaction->getTransactionIDMode() == RMAPTransaction::AutoTransactionID) {
-			transactionID = getNextAvailableTransactionID();
-		} else {
-			//check if the TID specified in RMAPCommandPacket is
-			//available or already used by another transaction
-			transactionID = transaction->getTransactionID();
-			if (isTransactionIDAvailable(transactionID) == false) {
-				throw RMAPEngineException(RMAPEngineException::SpecifiedTransactionIDIsAlreadyInUse);
+		//register the transaction to the transaction table
+		try {
+			if (transaction->getTransactionIDMode() == RMAPTransaction::AutoTransactionID) {
+				transactionID = getNextAvailableTransactionID(transaction, links[transaction->linkIndex]);
+			} else {
+				//check if the TID specified in RMAPCommandPacket is
+				//available or already used by another transaction
+				transactionID = transaction->getTransactionID();
+				RMAPTransaction* expected = NULL;
+				if (!transactions[transactionID].compare_exchange_strong(expected, transaction)) {
+					throw RMAPEngineException(RMAPEngineException::SpecifiedTransactionIDIsAlreadyInUse);
+				}
+				nTransactions++;
 			}
+		} catch (RMAPEngineException& e) {
+			std::lock_guard<std::mutex> stateGuard(transaction->stateMutex);
+			transaction->state = RMAPTransaction::NotInitiated;
+			throw e;
 		}
-		//register the transaction to management list
-		//if Reply is required
-		if (transaction->commandPacket->isReplyFlagSet()) {
-			transactionIDMutex.lock();
-			transactions[transactionID] = transaction;
-			transactionIDMutex.unlock();
+		commandPacket->setTransactionID(transactionID);
+		//if Reply is not required, put back transaction Id to available id list
+		if (!transaction->commandPacket->isReplyFlagSet()) {
+			deleteTransactionIDFromDB(transactionID);
 		} else {
-			//otherwise put back transaction Id to available id list
-			pushBackUtilizedTransactionID(transactionID);
+			//scheduled before sending so that a reply never precedes the registration
+			scheduleTransactionTimeout(transaction);
 		}
 		//send a command packet
-		commandPacket->setTransactionID(transactionID);
-		commandPacket->constructPacket();
-		if (isStarted()) {
-			{
+		try {
+			sendPacket(commandPacket->getPacketBufferPointer(), transaction->priorityClass, transaction->linkIndex);
+		} catch (RMAPEngineException& e) {
+			if (cancelTransaction(transaction) || !transaction->commandPacket->isReplyFlagSet()) {
 				std::lock_guard<std::mutex> stateGuard(transaction->stateMutex);
-				sendPacket(commandPacket->getPacketBufferPointer());
-				transaction->state = RMAPTransaction::Initiated;
+				transaction->state = RMAPTransaction::NotInitiated;
 			}
-		} else {
-			throw RMAPEngineException(RMAPEngineException::RMAPEngineIsNotStarted);
+			throw e;
 		}
 	}
 
 public:
 	inline void deleteTransactionIDFromDB(uint16_t transactionID) {
-		//remove tid from management list
-		transactionIDMutex.lock();
-		std::map<uint16_t, RMAPTransaction*>::iterator it = transactions.find(transactionID);
-		if (it != transactions.end()) { //found
-			transactions.erase(it);
+		//remove tid from the transaction table
+		if (transactions[transactionID].exchange(NULL) != NULL) { //found
+			nTransactions--;
 			//put back the transaction id to the available list
 			pushBackUtilizedTransactionID(transactionID);
 		}
-		transactionIDMutex.unlock();
 	}
 
 public:
-	void cancelTransaction(RMAPTransaction* transaction) throw (RMAPEngineException) {
+	/** Unregisters a transaction.
+	 * @returns true if the transaction was unregistered, or false if it had
+	 * already been resolved by a reply (or was not registered).
+	 */
+	bool cancelTransaction(RMAPTransaction* transaction) throw (RMAPEngineException) {
 		using namespace std;
 		RMAPPacket* commandPacket = transaction->getCommandPacket();
 		uint16_t transactionID = commandPacket->getTransactionID();
-		deleteTransactionIDFromDB(transactionID);
+		//unregister only if the ID has not been reused by another transaction
+		RMAPTransaction* expected = transaction;
+		if (transactions[transactionID].compare_exchange_strong(expected, NULL)) {
+			nTransactions--;
+			pushBackUtilizedTransactionID(transactionID);
+			unscheduleTransactionTimeout(transaction);
+			return true;
+		}
+		return false;
+	}
+
+private:
+	uint64_t getCurrentTick() {
+		return std::chrono::duration_cast<std::chrono::milliseconds>(
+				std::chrono::steady_clock::now() - timerWheelEpoch).count();
+	}
+
+private:
+	void scheduleTransactionTimeout(RMAPTransaction* transaction) {
+		//rounded up so that a transaction never expires earlier than its timeout duration
+		uint64_t expiryTick = getCurrentTick() + (uint64_t) (transaction->getTimeoutDuration()) + 1;
+		bool wakeUp;
+		{
+			std::lock_guard<std::mutex> guard(timerWheelMutex);
+			wakeUp = timerWheel.empty() || expiryTick < timerWheelWakeUpTick;
+			timerWheel.add(transaction, expiryTick);
+		}
+		if (wakeUp) {
+			timerWheelCondition.notify_one();
+		}
+	}
+
+private:
+	void unscheduleTransactionTimeout(RMAPTransaction* transaction) {
+		std::lock_guard<std::mutex> guard(timerWheelMutex);
+		timerWheel.remove(transaction);
+	}
+
+private:
+	/** Run by RMAPTransactionTimeoutThread. Sleeps until the earliest deadline in the timer wheel,
+	 * and expires transactions whose deadline has passed.
+	 * An expired transaction is unregistered (its ID is reused), its state becomes
+	 * RMAPTransaction::Timeout, and the initiator is notified in the same way as a reply.
+	 */
+	void processTransactionTimeouts() {
+		std::vector<RMAPTransaction*> expiredTransactions;
+		std::vector<RMAPTransaction*> timedOutTransactions;
+		std::unique_lock<std::mutex> lock(timerWheelMutex);
+		while (!transactionTimeoutThreadStopped) {
+			if (timerWheel.empty()) {
+				timerWheelWakeUpTick = 0;
+				timerWheelCondition.wait(lock);
+			} else {
+				timerWheelWakeUpTick = timerWheel.getNextExpiryTick();
+				timerWheelCondition.wait_until(lock,
+						timerWheelEpoch + std::chrono::milliseconds(timerWheelWakeUpTick));
+			}
+			timerWheel.advance(getCurrentTick(), expiredTransactions);
+			claimExpiredTransactions(expiredTransactions, timedOutTransactions);
+			if (!timedOutTransactions.empty()) {
+				lock.unlock();
+				finishTimedOutTransactions(timedOutTransactions);
+				lock.lock();
+			}
+		}
+		//no reply arrives after the engine stops, so expire all outstanding transactions
+		timerWheel.clear(expiredTransactions);
+		claimExpiredTransactions(expiredTransactions, timedOutTransactions);
+		lock.unlock();
+		finishTimedOutTransactions(timedOutTransactions);
+	}
+
+private:
+	/** Unregisters expired transactions which have not been resolved by a reply or canceled.
+	 * Invoked while holding timerWheelMutex, so that a resolved transaction is not touched after it is unscheduled.
+	 */
+	void claimExpiredTransactions(std::vector<RMAPTransaction*>& expiredTransactions,
+			std::vector<RMAPTransaction*>& timedOutTransactions) {
+		for (size_t i = 0; i < expiredTransactions.size(); i++) {
+			RMAPTransaction* transaction = expiredTransactions[i];
+			uint16_t transactionID = transaction->getCommandPacket()->getTransactionID();
+			RMAPTransaction* expected = transaction;
+			if (transactions[transactionID].compare_exchange_strong(expected, NULL)) {
+				nTransactions--;
+				pushBackUtilizedTransactionID(transactionID);
+				timedOutTransactions.push_back(transaction);
+			}
+		}
+		expiredTransactions.clear();
+	}
+
+private:
+	void finishTimedOutTransactions(std::vector<RMAPTransaction*>& timedOutTransactions) {
+		for (size_t i = 0; i < timedOutTransactions.size(); i++) {
+			nTimedOutTransactions++;
+			transactionFinished(timedOutTransactions[i], RMAPTransaction::Timeout);
+		}
+		timedOutTransactions.clear();
+	}
+
+private:
+	void startTransactionTimeoutThread() {
+		transactionTimeoutThreadStopped = false;
+		transactionTimeoutThread = new RMAPTransactionTimeoutThread(this);
+		transactionTimeoutThread->start();
+	}
+
+private:
+	/** Stops the timeout thread. Transactions still outstanding are expired by the thread before it exits. */
+	void stopTransactionTimeoutThread() {
+		{
+			std::lock_guard<std::mutex> guard(timerWheelMutex);
+			transactionTimeoutThreadStopped = true;
+			transactionTimeoutThread->stop();
+		}
+		timerWheelCondition.notify_all();
+		transactionTimeoutThread->waitUntilRunMethodComplets();
+		delete transactionTimeoutThread;
+		transactionTimeoutThread = NULL;
+	}
+
+public:
+	/** Returns the number of transactions waiting for a reply in the timer wheel. */
+	size_t getNTransactionsWaitingForReply() {
+		std::lock_guard<std::mutex> guard(timerWheelMutex);
+		return timerWheel.size();
 	}
 
 public:
-	void sendPacket(std::vector<uint8_t>* bytes) {
+	/** Sends a packet, and returns after it has been written to SpaceWireIF.
+	 * Threads sending concurrently are combined: the packet is queued, and whichever thread
+	 * finds no send in progress becomes the combiner, which takes queued packets
+	 * (up to MaximumPacketsPerSendBatch) and writes them with one SpaceWireIF::sendMany() call
+	 * on behalf of the other threads. Other threads sleep until their packet has been written.
+	 * Since the combiner is one of the sending threads, a packet sent on an idle link
+	 * does not need a hand-over to another thread. Each link has its own send queues.
+	 * @param[in] priorityClass one of RMAPTransaction::HighPriorityClass/NormalPriorityClass/BulkPriorityClass
+	 * @param[in] linkIndex link via which the packet is sent
+	 */
+	void sendPacket(std::vector<uint8_t>* bytes, uint32_t priorityClass = RMAPTransaction::NormalPriorityClass,
+			size_t linkIndex = 0) throw (RMAPEngineException) {
 		using namespace std;
-		spwSendMutex.lock();
+		if (linkIndex >= links.size()) {
+			throw RMAPEngineException(RMAPEngineException::NoSuchLink);
+		}
+		Link* link = links[linkIndex];
+		PendingPacket pendingPacket;
+		pendingPacket.bytes = bytes;
+		pendingPacket.priorityClass =
+				(priorityClass < RMAPTransaction::NumberOfPriorityClasses) ?
+						priorityClass : (uint32_t) RMAPTransaction::BulkPriorityClass;
+		pendingPacket.enqueuedTime = std::chrono::steady_clock::now();
+		pendingPacket.sent = false;
+		pendingPacket.failed = false;
+		std::unique_lock<std::mutex> lock(link->sendQueueMutex);
+		std::deque<PendingPacket*>& sendQueue = link->sendQueues[pendingPacket.priorityClass];
+		sendQueue.push_back(&pendingPacket);
+		SendQueueStatistics& statistics = link->sendQueueStatistics[pendingPacket.priorityClass];
+		statistics.depth = sendQueue.size();
+		if (statistics.maxDepth < statistics.depth) {
+			statistics.maxDepth = statistics.depth;
+		}
+		while (!pendingPacket.sent) {
+			if (link->sendInProgress) {
+				link->sendCompletedCondition.wait(lock);
+			} else {
+				sendQueuedPackets(link, lock);
+			}
+		}
+		if (pendingPacket.failed) {
+			throw RMAPEngineException(RMAPEngineException::PacketWasNotSentCorrectly);
+		}
+	}
+
+private:
+	/** Writes queued packets as a batch. Invoked by the combiner thread while holding sendQueueMutex,
+	 * which is released during the write.
+	 * The batch is filled by weighted round robin: in each round, up to the weight of
+	 * a priority class is taken from its queue, starting from the highest class.
+	 */
+	void sendQueuedPackets(Link* link, std::unique_lock<std::mutex>& lock) {
+		link->sendInProgress = true;
+		link->sendBatch.clear();
+		link->sendBatchBytes.clear();
+		size_t batchBytes = 0;
+		bool taken = true;
+		while (taken && link->sendBatch.size() < MaximumPacketsPerSendBatch && batchBytes < MaximumBytesPerSendBatch) {
+			taken = false;
+			for (size_t c = 0; c < RMAPTransaction::NumberOfPriorityClasses; c++) {
+				std::deque<PendingPacket*>& sendQueue = link->sendQueues[c];
+				for (size_t n = 0; n < link->priorityClassWeights[c] && !sendQueue.empty(); n++) {
+					if (link->sendBatch.size() >= MaximumPacketsPerSendBatch || batchBytes >= MaximumBytesPerSendBatch) {
+						break;
+					}
+					link->sendBatch.push_back(sendQueue.front());
+					link->sendBatchBytes.push_back(sendQueue.front()->bytes);
+					batchBytes += sendQueue.front()->bytes->size();
+					sendQueue.pop_front();
+					taken = true;
+				}
+				link->sendQueueStatistics[c].depth = sendQueue.size();
+			}
+		}
+		lock.unlock();
+		bool failed = false;
 		try {
-			spwif->send(bytes);
+			link->spwif->sendMany(link->sendBatchBytes);
 		} catch (...) {
-			spwSendMutex.unlock();
-			throw RMAPEngineException(RMAPEngineException::PacketWasNotSentCorrectly);
+			failed = true;
+		}
+		std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+		lock.lock();
+		for (size_t i = 0; i < link->sendBatch.size(); i++) {
+			SendQueueStatistics& statistics = link->sendQueueStatistics[link->sendBatch[i]->priorityClass];
+			double waitTime = std::chrono::duration<double, std::micro>(now - link->sendBatch[i]->enqueuedTime).count();
+			statistics.nSentPackets++;
+			statistics.totalWaitTime += waitTime;
+			if (statistics.maxWaitTime < waitTime) {
+				statistics.maxWaitTime = waitTime;
+			}
+			link->sendBatch[i]->failed = failed;
+			link->sendBatch[i]->sent = true;
+		}
+		link->nSentPackets += link->sendBatch.size();
+		link->nSendBatches++;
+		if (link->maxSendBatchSize < link->sendBatch.size()) {
+			link->maxSendBatchSize = link->sendBatch.size();
+		}
+		link->sendInProgress = false;
+		link->sendCompletedCondition.notify_all();
+	}
+
+public:
+	/** Sets the number of packets taken from the send queue of a priority class per scheduling round.
+	 * A class with a larger weight gets a larger share of the link while all classes are backlogged;
+	 * a weight of at least 1 guarantees that a class is not starved. The weight is applied to all the links.
+	 */
+	void setPriorityClassWeight(uint32_t priorityClass, size_t weight) {
+		if (priorityClass < RMAPTransaction::NumberOfPriorityClasses) {
+			for (size_t i = 0; i < links.size(); i++) {
+				std::lock_guard<std::mutex> guard(links[i]->sendQueueMutex);
+				links[i]->priorityClassWeights[priorityClass] = (weight != 0) ? weight : 1;
+			}
+		}
+	}
+
+public:
+	size_t getPriorityClassWeight(uint32_t priorityClass) {
+		if (priorityClass >= RMAPTransaction::NumberOfPriorityClasses) {
+			return 0;
 		}
-		spwSendMutex.unlock();
+		std::lock_guard<std::mutex> guard(links[0]->sendQueueMutex);
+		return links[0]->priorityClassWeights[priorityClass];
+	}
 
+public:
+	/** Returns the number of packets waiting in the send queue of a priority class. */
+	size_t getSendQueueDepth(uint32_t priorityClass, size_t linkIndex = 0) {
+		if (priorityClass >= RMAPTransaction::NumberOfPriorityClasses || linkIndex >= links.size()) {
+			return 0;
+		}
+		std::lock_guard<std::mutex> guard(links[linkIndex]->sendQueueMutex);
+		return links[linkIndex]->sendQueues[priorityClass].size();
 	}
 
 public:
+	/** Returns depth and wait-time statistics of the send queue of a priority class. */
+	SendQueueStatistics getSendQueueStatistics(uint32_t priorityClass, size_t linkIndex = 0)
+			throw (RMAPEngineException) {
+		Link* link = getLink(linkIndex);
+		std::lock_guard<std::mutex> guard(link->sendQueueMutex);
+		if (priorityClass >= RMAPTransaction::NumberOfPriorityClasses) {
+			priorityClass = RMAPTransaction::BulkPriorityClass;
+		}
+		return link->sendQueueStatistics[priorityClass];
+	}
+
+public:
+	/** Sets the SpaceWireIF of the primary link (link 0). The engine stops when it is closed. */
 	void setSpaceWireIF(SpaceWireIF* spwif) {
 		using namespace std;
-		this->spwif = spwif;
+		links[0]->spwif = spwif;
 		if (spacewireIFActionCloseAction == NULL) {
 			spacewireIFActionCloseAction = new RMAPEngineSpaceWireIFActionCloseAction(this);
 		}
-		this->spwif->addSpaceWireIFCloseAction(spacewireIFActionCloseAction);
+		spwif->addSpaceWireIFCloseAction(spacewireIFActionCloseAction);
 	}
 
 	SpaceWireIF * getSpaceWireIF() {
-		return spwif;
+		return links[0]->spwif;
+	}
+
+public:
+	/** Adds a link served by this engine, and returns its index, which is set to
+	 * RMAPTargetNode::setLinkIndex() of the target nodes reached via the link.
+	 * Received packets are processed by a receive thread per link, and the transaction ID space
+	 * is re-partitioned equally among the links so that links do not contend for IDs.
+	 * Links should be added before start(). If a link other than the primary one is disconnected,
+	 * its receive thread finishes, the link is marked as failed (see isLinkFailed() and nFailedLinks), and
+	 * the engine keeps serving the other links; transactions via the failed link are rejected with LinkHasFailed.
+	 */
+	size_t addSpaceWireIF(SpaceWireIF* spwif) throw (RMAPEngineException) {
+		if (isStarted()) {
+			throw RMAPEngineException(RMAPEngineException::LinkCanNotBeAddedWhileRunning);
+		}
+		if (links[0]->spwif == NULL) {
+			setSpaceWireIF(spwif);
+			return 0;
+		}
+		Link* link = new Link(links.size(), spwif);
+		for (size_t c = 0; c < RMAPTransaction::NumberOfPriorityClasses; c++) {
+			link->priorityClassWeights[c] = links[0]->priorityClassWeights[c];
+		}
+		links.push_back(link);
+		partitionTransactionIDs();
+		return link->index;
+	}
+
+public:
+	SpaceWireIF* getSpaceWireIF(size_t linkIndex) throw (RMAPEngineException) {
+		return getLink(linkIndex)->spwif;
+	}
+
+public:
+	size_t getNLinks() {
+		return links.size();
+	}
+
+public:
+	/** Returns a link, e.g. to read its counters (nReceivedPackets, nSentPackets, nSendBatches). */
+	Link* getLink(size_t linkIndex) throw (RMAPEngineException) {
+		if (linkIndex >= links.size()) {
+			throw RMAPEngineException(RMAPEngineException::NoSuchLink);
+		}
+		return links[linkIndex];
+	}
+
+public:
+	/** Pins the receive thread of a link to a CPU core (Linux only). Takes effect at the next start().
+	 * @param[in] cpuCore core number, or -1 not to pin the thread
+	 */
+	void setReceiveThreadCPUCore(size_t linkIndex, int cpuCore) throw (RMAPEngineException) {
+		getLink(linkIndex)->receiveThreadCPUCore = cpuCore;
+	}
+
+public:
+	int getReceiveThreadCPUCore(size_t linkIndex) throw (RMAPEngineException) {
+		return getLink(linkIndex)->receiveThreadCPUCore;
 	}
 
 private:
-	uint16_t getNextAvailableTransactionID() throw (RMAPEngineException) {
-		transactionIDMutex.lock();
-		if (availableTransactionIDList.size() != 0) {
-			unsigned int tid = *(availableTransactionIDList.begin());
-			availableTransactionIDList.pop_front();
-			transactionIDMutex.unlock();
-			return tid;
-		} else {
-			transactionIDMutex.unlock();
-			throw RMAPEngineException(RMAPEngineException::TooManyConcurrentTransactions);
+	/** Pops a free transaction ID of the link and registers the transaction to it.
+	 * An ID taken by a manual-TID transaction while it was still in the ring
+	 * is dropped here, and pushed back when that transaction releases it.
+	 */
+	uint16_t getNextAvailableTransactionID(RMAPTransaction* transaction, Link* link) throw (RMAPEngineException) {
+		uint16_t tid;
+		while (link->availableTransactionIDRing.pop(tid)) {
+			transactionIDIsInRing[tid].store(false);
+			RMAPTransaction* expected = NULL;
+			if (transactions[tid].compare_exchange_strong(expected, transaction)) {
+				nTransactions++;
+				return tid;
+			}
 		}
+		throw RMAPEngineException(RMAPEngineException::TooManyConcurrentTransactions);
 	}
 
 private:
 	void pushBackUtilizedTransactionID(uint16_t transactionID) {
-		transactionIDMutex.lock();
-		availableTransactionIDList.push_back(transactionID);
-		transactionIDMutex.unlock();
+		//only the thread which flips the flag pushes, so that an ID is never held twice
+		if (!transactionIDIsInRing[transactionID].exchange(true)) {
+			links[transactionID / transactionIDPartitionSize]->availableTransactionIDRing.push(transactionID);
+		}
 	}
 
 public:
 	bool isTransactionIDAvailable(uint16_t transactionID) {
-		transactionIDMutex.lock();
-		if (transactions.find(transactionID) != transactions.end()) {
-			transactionIDMutex.unlock();
-			//already in use
-			return false;
-		} else {
-			transactionIDMutex.unlock();
-			//not used
-			return true;
-		}
+		return transactions[transactionID].load() == NULL;
 	}
 
 public:
 	void addRMAPTarget(RMAPTarget* rmapTarget) {
+		std::lock_guard<std::mutex> guard(rmapTargetsMutex);
 		rmapTargets.push_back(rmapTarget);
+		rmapTarget->addModifiedAction(rmapTargetModifiedAction);
+		rmapTargetsVersion++;
 	}
 
 public:
 	void removeRMAPTarget(RMAPTarget* rmapTarget) {
+		std::lock_guard<std::mutex> guard(rmapTargetsMutex);
 		std::vector<RMAPTarget*> aVector;
 		for (size_t i = 0; i < rmapTargets.size(); i++) {
 			if (rmapTargets[i] != rmapTarget) {
@@ -648,6 +1771,8 @@ public:
 			}
 		}
 		rmapTargets = aVector;
+		rmapTarget->removeModifiedAction(rmapTargetModifiedAction);
+		rmapTargetsVersion++;
 	}
 
 public:
@@ -686,12 +1811,16 @@ public:
 
 public:
 	size_t getNTransactions() {
-		return transactions.size();
+		return nTransactions;
 	}
 
 public:
 	size_t getNAvailableTransactionIDs() {
-		return availableTransactionIDList.size();
+		size_t nAvailableTransactionIDs = 0;
+		for (size_t i = 0; i < links.size(); i++) {
+			nAvailableTransactionIDs += links[i]->availableTransactionIDRing.size();
+		}
+		return nAvailableTransactionIDs;
 	}
 
 };
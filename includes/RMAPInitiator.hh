@@ -40,91 +40,11 @@
 #include "RMAPTargetNode.hh"
 #include "RMAPReplyStatus.hh"
 #include "RMAPReplyException.hh"
+#include "RMAPInitiatorException.hh"
+#include "RMAPAsyncInitiator.hh"
 #include "RMAPProtocol.hh"
 #include "RMAPMemoryObject.hh"
 
-class RMAPInitiatorException: public CxxUtilities::Exception {
-public:
-	enum {
-		Timeout = 0x100,
-		Aborted = 0x200,
-		ReadReplyWithInsufficientData,
-		ReadReplyWithTooMuchData,
-		UnexpectedWriteReplyReceived,
-		NoSuchRMAPMemoryObject,
-		NoSuchRMAPTargetNode,
-		RMAPTransactionCouldNotBeInitiated,
-		SpecifiedRMAPMemoryObjectIsNotReadable,
-		SpecifiedRMAPMemoryObjectIsNotWritable,
-		SpecifiedRMAPMemoryObjectIsNotRMWable,
-		RMAPTargetNodeDBIsNotRegistered,
-		NonblockingTransactionHasNotBeenInitiated,
-		NonblockingTransactionHasNotBeenCompleted
-	};
-
-public:
-	RMAPInitiatorException(uint32_t status) :
-			CxxUtilities::Exception(status) {
-	}
-
-public:
-	virtual ~RMAPInitiatorException() {
-	}
-
-public:
-	std::string toString() {
-		std::string result;
-		switch (status) {
-		case Timeout:
-			result = "Timeout";
-			break;
-		case Aborted:
-			result = "Aborted";
-			break;
-		case ReadReplyWithInsufficientData:
-			result = "ReadReplyWithInsufficientData";
-			break;
-		case ReadReplyWithTooMuchData:
-			result = "ReadReplyWithTooMuchData";
-			break;
-		case UnexpectedWriteReplyReceived:
-			result = "UnexpectedWriteReplyReceived";
-			break;
-		case NoSuchRMAPMemoryObject:
-			result = "NoSuchRMAPMemoryObject";
-			break;
-		case NoSuchRMAPTargetNode:
-			result = "NoSuchRMAPTargetNode";
-			break;
-		case RMAPTransactionCouldNotBeInitiated:
-			result = "RMAPTransactionCouldNotBeInitiated";
-			break;
-		case SpecifiedRMAPMemoryObjectIsNotReadable:
-			result = "SpecifiedRMAPMemoryObjectIsNotReadable";
-			break;
-		case SpecifiedRMAPMemoryObjectIsNotWritable:
-			result = "SpecifiedRMAPMemoryObjectIsNotWritable";
-			break;
-		case SpecifiedRMAPMemoryObjectIsNotRMWable:
-			result = "SpecifiedRMAPMemoryObjectIsNotRMWable";
-			break;
-		case RMAPTargetNodeDBIsNotRegistered:
-			result = "RMAPTargetNodeDBIsNotRegistered";
-			break;
-		case NonblockingTransactionHasNotBeenInitiated:
-			result = "NonblockingTransactionHasNotBeenInitiated";
-			break;
-		case NonblockingTransactionHasNotBeenCompleted:
-			result = "NonblockingTransactionHasNotBeenCompleted";
-			break;
-		default:
-			result = "Undefined status";
-			break;
-		}
-		return result;
-	}
-};
-
 class RMAPInitiator {
 public:
 	static const uint16_t DefaultTransactionID = 0x00;
@@ -163,6 +83,11 @@ private:
 private:
 	bool useDraftECRC;
 
+private:
+	//created when a range read/write is performed for the first time
+	RMAPAsyncInitiator* asyncInitiator;
+	std::mutex asyncInitiatorMutex;
+
 public:
 	RMAPInitiator(RMAPEngine* rmapEngine) {
 		this->rmapEngine = rmapEngine;
@@ -172,7 +97,9 @@ public:
 		isVerifyModeSet_ = false;
 		isReplyModeSet_ = false;
 		isTransactionIDSet_ = false;
+		isInitiatorLogicalAddressSet_ = false;
 		useDraftECRC = false;
+		asyncInitiator = NULL;
 
 		transactionID = DefaultTransactionID;
 		incrementMode = DefaultIncrementMode;
@@ -181,21 +108,32 @@ public:
 	}
 
 	~RMAPInitiator() {
+		{
+			//quiesced before deletion, since threads of RMAPEngine may still be completing its transactions
+			std::lock_guard<std::mutex> guard(asyncInitiatorMutex);
+			if (asyncInitiator != NULL) {
+				asyncInitiator->cancelAllTransactions();
+				delete asyncInitiator;
+				asyncInitiator = NULL;
+			}
+		}
 		if (commandPacket != NULL) {
 			delete commandPacket;
 		}
 		if (replyPacket != NULL) {
-			deleteReplyPacket();
+			//not returned to the pool because RMAPEngine might have already been deleted
+			delete replyPacket;
 		}
 	}
 
 public:
+	/** Returns the reply packet to the packet pool of RMAPEngine. */
 	void deleteReplyPacket() {
 		std::lock_guard<std::mutex> guard(deleteReplyPacketMutex);
 		if (replyPacket == NULL) {
 			return;
 		}
-		delete replyPacket;
+		rmapEngine->releaseRMAPPacket(replyPacket);
 		replyPacket = NULL;
 	}
 
@@ -278,11 +216,39 @@ public:
 		read(rmapTargetNode, memoryObject->getAddress(), memoryObject->getLength(), buffer, timeoutDuration);
 	}
 
+	/** Reads a memory object resolved via resolveMemoryObject() without string lookups. */
+	void read(RMAPMemoryObjectHandle memoryObjectHandle, uint8_t* buffer, double timeoutDuration =
+			DefaultTimeoutDuration) throw (RMAPEngineException, RMAPInitiatorException, RMAPReplyException) {
+		RMAPTargetNode* targetNode;
+		RMAPMemoryObject* memoryObject;
+		getRMAPTargetNodeAndMemoryObject(memoryObjectHandle, targetNode, memoryObject);
+		if (!memoryObject->isReadable()) {
+			throw RMAPInitiatorException(RMAPInitiatorException::SpecifiedRMAPMemoryObjectIsNotReadable);
+		}
+		read(targetNode, memoryObject->getAddress(), memoryObject->getLength(), buffer, timeoutDuration);
+	}
+
+	void read(RMAPTargetNodeHandle targetNodeHandle, uint32_t memoryAddress, uint32_t length, uint8_t* buffer,
+			double timeoutDuration = DefaultTimeoutDuration) throw (RMAPEngineException, RMAPInitiatorException,
+					RMAPReplyException) {
+		read(getRMAPTargetNode(targetNodeHandle), memoryAddress, length, buffer, timeoutDuration);
+	}
+
 	/** Reads remote memory. This method blocks the current thread. For non-blocking access, use the nonblockingRead() method.
 	 */
 	void read(RMAPTargetNode* rmapTargetNode, uint32_t memoryAddress, uint32_t length, uint8_t *buffer,
 			double timeoutDuration = DefaultTimeoutDuration) throw (RMAPEngineException, RMAPInitiatorException,
 					RMAPReplyException) {
+		read(rmapTargetNode, 0x00, memoryAddress, length, buffer, rmapTargetNode->getDefaultKey(), incrementMode,
+				timeoutDuration);
+	}
+
+	/** Reads remote memory using the specified extended address, key, and increment mode
+	 * instead of 0x00, the default key of rmapTargetNode, and the increment mode of this instance.
+	 */
+	void read(RMAPTargetNode* rmapTargetNode, uint8_t extendedAddress, uint32_t memoryAddress, uint32_t length,
+			uint8_t *buffer, uint8_t key, bool increment, double timeoutDuration = DefaultTimeoutDuration)
+					throw (RMAPEngineException, RMAPInitiatorException, RMAPReplyException) {
 		using namespace std;
 		std::lock_guard<std::mutex> guard(transactionMutex);
 		transaction.isNonblockingMode = false;
@@ -293,20 +259,22 @@ public:
 		commandPacket->setInitiatorLogicalAddress(this->getInitiatorLogicalAddress());
 		commandPacket->setRead();
 		commandPacket->setCommand();
-		if (incrementMode) {
+		if (increment) {
 			commandPacket->setIncrementMode();
 		} else {
 			commandPacket->setNoIncrementMode();
 		}
 		commandPacket->setNoVerifyMode();
 		commandPacket->setReplyMode();
-		commandPacket->setExtendedAddress(0x00);
+		commandPacket->setExtendedAddress(extendedAddress);
 		commandPacket->setAddress(memoryAddress);
 		commandPacket->setDataLength(length);
 		commandPacket->clearData();
 		/** InitiatorLogicalAddress might be updated in commandPacket->setRMAPTargetInformation(rmapTargetNode) below */
 		commandPacket->setRMAPTargetInformation(rmapTargetNode);
+		commandPacket->setKey(key);
 		transaction.commandPacket = this->commandPacket;
+		transaction.linkIndex = rmapTargetNode->getLinkIndex();
 		//tid
 		if (isTransactionIDSet_) {
 			transaction.setTransactionID(transactionID);
@@ -320,7 +288,7 @@ public:
 			transaction.state = RMAPTransaction::NotInitiated;
 			throw RMAPInitiatorException(RMAPInitiatorException::RMAPTransactionCouldNotBeInitiated);
 		}
-		transaction.condition.wait(timeoutDuration);
+		waitForReply(timeoutDuration);
 		if (transaction.state == RMAPTransaction::ReplyReceived) {
 			replyPacket = transaction.replyPacket;
 			transaction.replyPacket = NULL;
@@ -330,7 +298,7 @@ public:
 				deleteReplyPacket();
 				throw RMAPReplyException(replyStatus);
 			}
-			if (length < replyPacket->getDataBuffer()->size()) {
+			if (length < replyPacket->getDataSize()) {
 				transaction.state = RMAPTransaction::NotInitiated;
 				deleteReplyPacket();
 				throw RMAPInitiatorException(RMAPInitiatorException::ReadReplyWithInsufficientData);
@@ -341,8 +309,6 @@ public:
 			//deleteReplyPacket();
 			return;
 		} else {
-			//cancel transaction (return transaction ID)
-			rmapEngine->cancelTransaction(&transaction);
 			transaction.state = RMAPTransaction::NotInitiated;
 			deleteReplyPacket();
 			throw RMAPInitiatorException(RMAPInitiatorException::Timeout);
@@ -428,6 +394,7 @@ public:
 		/** InitiatorLogicalAddress might be updated in commandPacket->setRMAPTargetInformation(rmapTargetNode) below */
 		commandPacket->setRMAPTargetInformation(rmapTargetNode);
 		transaction.commandPacket = this->commandPacket;
+		transaction.linkIndex = rmapTargetNode->getLinkIndex();
 		//tid
 		if (isTransactionIDSet_) {
 			transaction.setTransactionID(transactionID);
@@ -464,7 +431,7 @@ public:
 				deleteReplyPacket();
 				throw RMAPReplyException(replyStatus);
 			}
-			if (length < replyPacket->getDataBuffer()->size()) {
+			if (length < replyPacket->getDataSize()) {
 				deleteReplyPacket();
 				throw RMAPInitiatorException(RMAPInitiatorException::ReadReplyWithInsufficientData);
 			}
@@ -485,6 +452,68 @@ public:
 		}
 	}
 
+public:
+	/** Reads a memory range of arbitrary length into buffer.
+	 * The range is split by rmapTargetNode->getMaximumDataLengthPerTransaction(), and
+	 * several chunks are kept outstanding (see RMAPAsyncInitiator::setWindowSize() via getAsyncInitiator()).
+	 * @return throughput statistics of the range read
+	 */
+	RMAPRangeTransferStatistics readRange(RMAPTargetNode* rmapTargetNode, uint32_t memoryAddress, size_t length,
+			uint8_t* buffer, double timeoutDuration = DefaultTimeoutDuration) throw (RMAPInitiatorException,
+					RMAPReplyException) {
+		return prepareAsyncInitiator()->readRange(rmapTargetNode, memoryAddress, length, buffer,
+				timeoutDuration);
+	}
+
+public:
+	/** Reads a memory range of arbitrary length, and writes the data to os (e.g. std::ofstream) in the order of address. */
+	RMAPRangeTransferStatistics readRange(RMAPTargetNode* rmapTargetNode, uint32_t memoryAddress, size_t length,
+			std::ostream& os, double timeoutDuration = DefaultTimeoutDuration) throw (RMAPInitiatorException,
+					RMAPReplyException) {
+		return prepareAsyncInitiator()->readRange(rmapTargetNode, memoryAddress, length, os, timeoutDuration);
+	}
+
+public:
+	/** Writes data of arbitrary length to a memory range, splitting and pipelining it as readRange(). */
+	RMAPRangeTransferStatistics writeRange(RMAPTargetNode* rmapTargetNode, uint32_t memoryAddress, uint8_t* data,
+			size_t length, double timeoutDuration = DefaultTimeoutDuration) throw (RMAPInitiatorException,
+					RMAPReplyException) {
+		return prepareAsyncInitiator()->writeRange(rmapTargetNode, memoryAddress, data, length,
+				timeoutDuration);
+	}
+
+public:
+	/** Writes length bytes read from is (e.g. std::ifstream) to a memory range. */
+	RMAPRangeTransferStatistics writeRange(RMAPTargetNode* rmapTargetNode, uint32_t memoryAddress, std::istream& is,
+			size_t length, double timeoutDuration = DefaultTimeoutDuration) throw (RMAPInitiatorException,
+					RMAPReplyException) {
+		return prepareAsyncInitiator()->writeRange(rmapTargetNode, memoryAddress, is, length,
+				timeoutDuration);
+	}
+
+public:
+	/** Returns RMAPAsyncInitiator used by readRange()/writeRange(), e.g. to change its window size. */
+	RMAPAsyncInitiator* getAsyncInitiator() {
+		std::lock_guard<std::mutex> guard(asyncInitiatorMutex);
+		if (asyncInitiator == NULL) {
+			asyncInitiator = new RMAPAsyncInitiator(rmapEngine);
+		}
+		return asyncInitiator;
+	}
+
+private:
+	/** Applies the logical address and CRC settings of this instance to RMAPAsyncInitiator.
+	 * Range operations always use the increment mode.
+	 */
+	RMAPAsyncInitiator* prepareAsyncInitiator() {
+		RMAPAsyncInitiator* asyncInitiator = getAsyncInitiator();
+		asyncInitiator->setInitiatorLogicalAddress(getInitiatorLogicalAddress());
+		asyncInitiator->setUseDraftECRC(useDraftECRC);
+		asyncInitiator->setIncrementMode(true);
+		asyncInitiator->setPriorityClass(transaction.getPriorityClass());
+		return asyncInitiator;
+	}
+
 public:
 	void write(std::string targetNodeID, uint32_t memoryAddress, uint8_t *data, uint32_t length, double timeoutDuration =
 			DefaultTimeoutDuration) throw (RMAPEngineException, RMAPInitiatorException, RMAPReplyException) {
@@ -559,11 +588,39 @@ public:
 		write(rmapTargetNode, memoryAddress, pointer, data->size(), timeoutDuration);
 	}
 
+	/** Writes a memory object resolved via resolveMemoryObject() without string lookups. */
+	void write(RMAPMemoryObjectHandle memoryObjectHandle, uint8_t* data, double timeoutDuration =
+			DefaultTimeoutDuration) throw (RMAPEngineException, RMAPInitiatorException, RMAPReplyException) {
+		RMAPTargetNode* targetNode;
+		RMAPMemoryObject* memoryObject;
+		getRMAPTargetNodeAndMemoryObject(memoryObjectHandle, targetNode, memoryObject);
+		if (!memoryObject->isWritable()) {
+			throw RMAPInitiatorException(RMAPInitiatorException::SpecifiedRMAPMemoryObjectIsNotWritable);
+		}
+		write(targetNode, memoryObject->getAddress(), data, memoryObject->getLength(), timeoutDuration);
+	}
+
+	void write(RMAPTargetNodeHandle targetNodeHandle, uint32_t memoryAddress, uint8_t *data, uint32_t length,
+			double timeoutDuration = DefaultTimeoutDuration) throw (RMAPEngineException, RMAPInitiatorException,
+					RMAPReplyException) {
+		write(getRMAPTargetNode(targetNodeHandle), memoryAddress, data, length, timeoutDuration);
+	}
+
 	/** Writes remote memory. This method blocks the current thread. For non-blocking access, use the writeAsynchronouly() method.
 	 */
 	void write(RMAPTargetNode *rmapTargetNode, uint32_t memoryAddress, uint8_t *data, uint32_t length,
 			double timeoutDuration = DefaultTimeoutDuration) throw (RMAPEngineException, RMAPInitiatorException,
 					RMAPReplyException) {
+		write(rmapTargetNode, 0x00, memoryAddress, data, length, rmapTargetNode->getDefaultKey(), incrementMode,
+				timeoutDuration);
+	}
+
+	/** Writes remote memory using the specified extended address, key, and increment mode
+	 * instead of 0x00, the default key of rmapTargetNode, and the increment mode of this instance.
+	 */
+	void write(RMAPTargetNode *rmapTargetNode, uint8_t extendedAddress, uint32_t memoryAddress, uint8_t *data,
+			uint32_t length, uint8_t key, bool increment, double timeoutDuration = DefaultTimeoutDuration)
+					throw (RMAPEngineException, RMAPInitiatorException, RMAPReplyException) {
 		std::lock_guard<std::mutex> guard(transactionMutex);
 		transaction.isNonblockingMode = false;
 		if (replyPacket != NULL) {
@@ -573,7 +630,7 @@ public:
 		commandPacket->setInitiatorLogicalAddress(this->getInitiatorLogicalAddress());
 		commandPacket->setWrite();
 		commandPacket->setCommand();
-		if (incrementMode) {
+		if (increment) {
 			commandPacket->setIncrementMode();
 		} else {
 			commandPacket->setNoIncrementMode();
@@ -588,12 +645,14 @@ public:
 		} else {
 			commandPacket->setNoReplyMode();
 		}
-		commandPacket->setExtendedAddress(0x00);
+		commandPacket->setExtendedAddress(extendedAddress);
 		commandPacket->setAddress(memoryAddress);
 		commandPacket->setDataLength(length);
 		commandPacket->setRMAPTargetInformation(rmapTargetNode);
+		commandPacket->setKey(key);
 		commandPacket->setData(data, length);
 		transaction.commandPacket = this->commandPacket;
+		transaction.linkIndex = rmapTargetNode->getLinkIndex();
 		setRMAPTransactionOptions(transaction);
 		rmapEngine->initiateTransaction(transaction);
 
@@ -607,24 +666,10 @@ public:
 				throw RMAPInitiatorException(RMAPInitiatorException::RMAPTransactionCouldNotBeInitiated);
 			}
 		}
-		transaction.state = RMAPTransaction::CommandSent;
 
 		//if reply is expected
-		transaction.condition.wait(timeoutDuration);
+		waitForReply(timeoutDuration);
 		switch(transaction.state){
-		case RMAPTransaction::CommandSent:
-			if (replyMode) {
-				//cancel transaction (return transaction ID)
-				rmapEngine->cancelTransaction(&transaction);
-				//reply packet is not created, and therefore the line below is not necessary
-				//deleteReplyPacket();
-				transaction.state = RMAPTransaction::Initiated;
-				throw RMAPInitiatorException(RMAPInitiatorException::Timeout);
-			} else {
-				transaction.state = RMAPTransaction::NotInitiated;
-				return;
-			}
-			break;
 		case RMAPTransaction::ReplyReceived:
 			replyPacket = transaction.replyPacket;
 			transaction.replyPacket = NULL;
@@ -648,8 +693,6 @@ public:
 			break;
 		case RMAPTransaction::Timeout: // fallthrough
 		default:
-			//cancel transaction (return transaction ID)
-			rmapEngine->cancelTransaction(&transaction);
 			deleteReplyPacket();
 			transaction.state = RMAPTransaction::NotInitiated;
 			throw RMAPInitiatorException(RMAPInitiatorException::Timeout);
@@ -657,6 +700,33 @@ public:
 		}
 	}
 
+private:
+	/** Waits until the transaction is resolved by a reply or expired by RMAPEngine.
+	 * If neither has happened within timeoutDuration (e.g. the signal was missed),
+	 * the transaction is canceled here. On return, the state of the transaction is either
+	 * ReplyReceived or Timeout, and RMAPEngine no longer accesses the transaction.
+	 */
+	void waitForReply(double timeoutDuration) {
+		transaction.condition.wait(timeoutDuration);
+		if (isTransactionFinished()) {
+			return;
+		}
+		if (rmapEngine->cancelTransaction(&transaction)) {
+			transaction.state = RMAPTransaction::Timeout;
+			return;
+		}
+		//the receive thread or the timeout thread of RMAPEngine is finishing the transaction
+		while (!isTransactionFinished()) {
+			transaction.condition.wait(1);
+		}
+	}
+
+private:
+	bool isTransactionFinished() {
+		std::lock_guard<std::mutex> stateGuard(transaction.stateMutex);
+		return transaction.state == RMAPTransaction::ReplyReceived || transaction.state == RMAPTransaction::Timeout;
+	}
+
 private:
 	void setRMAPTransactionOptions(RMAPTransaction& transaction) {
 		//increment mode
@@ -793,6 +863,19 @@ public:
 		return isTransactionIDSet_;
 	}
 
+public:
+	/** Sets the priority class of transactions initiated by this instance.
+	 * @param[in] priorityClass RMAPTransaction::HighPriorityClass, NormalPriorityClass (default), or BulkPriorityClass
+	 */
+	void setPriorityClass(uint32_t priorityClass) {
+		std::lock_guard<std::mutex> guard(transactionMutex);
+		transaction.setPriorityClass(priorityClass);
+	}
+
+	uint32_t getPriorityClass() {
+		return transaction.getPriorityClass();
+	}
+
 public:
 	RMAPPacket* getCommandPacketPointer() {
 		return commandPacket;
@@ -811,6 +894,59 @@ public:
 		return targetNodeDB;
 	}
 
+public:
+	/** Resolves a target node ID once. The returned handle can be passed to read()/write()
+	 * to avoid string lookups on every access.
+	 */
+	RMAPTargetNodeHandle resolveRMAPTargetNode(std::string targetNodeID) throw (RMAPInitiatorException) {
+		if (targetNodeDB == NULL) {
+			throw RMAPInitiatorException(RMAPInitiatorException::RMAPTargetNodeDBIsNotRegistered);
+		}
+		try {
+			return targetNodeDB->resolveRMAPTargetNode(targetNodeID);
+		} catch (RMAPTargetNodeDBException& e) {
+			throw RMAPInitiatorException(RMAPInitiatorException::NoSuchRMAPTargetNode);
+		}
+	}
+
+public:
+	/** Resolves a memory object ID once. The returned handle can be passed to read()/write(). */
+	RMAPMemoryObjectHandle resolveMemoryObject(std::string targetNodeID, std::string memoryObjectID)
+			throw (RMAPInitiatorException) {
+		RMAPTargetNodeHandle targetNodeHandle = resolveRMAPTargetNode(targetNodeID);
+		try {
+			return targetNodeDB->resolveMemoryObject(targetNodeHandle, memoryObjectID);
+		} catch (RMAPTargetNodeDBException& e) {
+			throw RMAPInitiatorException(RMAPInitiatorException::NoSuchRMAPMemoryObject);
+		}
+	}
+
+private:
+	RMAPTargetNode* getRMAPTargetNode(RMAPTargetNodeHandle targetNodeHandle) throw (RMAPInitiatorException) {
+		if (targetNodeDB == NULL) {
+			throw RMAPInitiatorException(RMAPInitiatorException::RMAPTargetNodeDBIsNotRegistered);
+		}
+		try {
+			return targetNodeDB->getRMAPTargetNode(targetNodeHandle);
+		} catch (RMAPTargetNodeDBException& e) {
+			throw RMAPInitiatorException(RMAPInitiatorException::NoSuchRMAPTargetNode);
+		}
+	}
+
+private:
+	void getRMAPTargetNodeAndMemoryObject(RMAPMemoryObjectHandle memoryObjectHandle, RMAPTargetNode*& targetNode,
+			RMAPMemoryObject*& memoryObject) throw (RMAPInitiatorException) {
+		if (targetNodeDB == NULL) {
+			throw RMAPInitiatorException(RMAPInitiatorException::RMAPTargetNodeDBIsNotRegistered);
+		}
+		try {
+			targetNode = targetNodeDB->getRMAPTargetNode(memoryObjectHandle);
+			memoryObject = targetNodeDB->getMemoryObject(memoryObjectHandle);
+		} catch (RMAPTargetNodeDBException& e) {
+			throw RMAPInitiatorException(RMAPInitiatorException::NoSuchRMAPMemoryObject);
+		}
+	}
+
 public:
 	bool isUseDraftECRC() const {
 		return useDraftECRC;
@@ -0,0 +1,124 @@
+/* 
+============================================================================
+SpaceWire/RMAP Library is provided under the MIT License.
+============================================================================
+
+Copyright (c) 2006-2013 Takayuki Yuasa and The Open-source SpaceWire Project
+
+Permission is hereby granted, free of charge, to any person obtaining a 
+copy of this software and associated documentation files (the 
+"Software"), to deal in the Software without restriction, including 
+without limitation the rights to use, copy, modify, merge, publish, 
+distribute, sublicense, and/or sell copies of the Software, and to 
+permit persons to whom the Software is furnished to do so, subject to 
+the following conditions:
+
+The above copyright notice and this permission notice shall be included 
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. 
+*/
+/*
+ * RMAPInitiatorException.hh
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef RMAPINITIATOREXCEPTION_HH_
+#define RMAPINITIATOREXCEPTION_HH_
+
+#include "CxxUtilities/CxxUtilities.hh"
+
+class RMAPInitiatorException: public CxxUtilities::Exception {
+public:
+	enum {
+		Timeout = 0x100,
+		Aborted = 0x200,
+		ReadReplyWithInsufficientData,
+		ReadReplyWithTooMuchData,
+		UnexpectedWriteReplyReceived,
+		NoSuchRMAPMemoryObject,
+		NoSuchRMAPTargetNode,
+		RMAPTransactionCouldNotBeInitiated,
+		SpecifiedRMAPMemoryObjectIsNotReadable,
+		SpecifiedRMAPMemoryObjectIsNotWritable,
+		SpecifiedRMAPMemoryObjectIsNotRMWable,
+		RMAPTargetNodeDBIsNotRegistered,
+		NonblockingTransactionHasNotBeenInitiated,
+		NonblockingTransactionHasNotBeenCompleted,
+		MaximumDataLengthPerTransactionIsZero
+	};
+
+public:
+	RMAPInitiatorException(uint32_t status) :
+			CxxUtilities::Exception(status) {
+	}
+
+public:
+	virtual ~RMAPInitiatorException() {
+	}
+
+public:
+	std::string toString() {
+		std::string result;
+		switch (status) {
+		case Timeout:
+			result = "Timeout";
+			break;
+		case Aborted:
+			result = "Aborted";
+			break;
+		case ReadReplyWithInsufficientData:
+			result = "ReadReplyWithInsufficientData";
+			break;
+		case ReadReplyWithTooMuchData:
+			result = "ReadReplyWithTooMuchData";
+			break;
+		case UnexpectedWriteReplyReceived:
+			result = "UnexpectedWriteReplyReceived";
+			break;
+		case NoSuchRMAPMemoryObject:
+			result = "NoSuchRMAPMemoryObject";
+			break;
+		case NoSuchRMAPTargetNode:
+			result = "NoSuchRMAPTargetNode";
+			break;
+		case RMAPTransactionCouldNotBeInitiated:
+			result = "RMAPTransactionCouldNotBeInitiated";
+			break;
+		case SpecifiedRMAPMemoryObjectIsNotReadable:
+			result = "SpecifiedRMAPMemoryObjectIsNotReadable";
+			break;
+		case SpecifiedRMAPMemoryObjectIsNotWritable:
+			result = "SpecifiedRMAPMemoryObjectIsNotWritable";
+			break;
+		case SpecifiedRMAPMemoryObjectIsNotRMWable:
+			result = "SpecifiedRMAPMemoryObjectIsNotRMWable";
+			break;
+		case RMAPTargetNodeDBIsNotRegistered:
+			result = "RMAPTargetNodeDBIsNotRegistered";
+			break;
+		case NonblockingTransactionHasNotBeenInitiated:
+			result = "NonblockingTransactionHasNotBeenInitiated";
+			break;
+		case NonblockingTransactionHasNotBeenCompleted:
+			result = "NonblockingTransactionHasNotBeenCompleted";
+			break;
+		case MaximumDataLengthPerTransactionIsZero:
+			result = "MaximumDataLengthPerTransactionIsZero";
+			break;
+		default:
+			result = "Undefined status";
+			break;
+		}
+		return result;
+	}
+};
+
+#endif /* RMAPINITIATOREXCEPTION_HH_ */
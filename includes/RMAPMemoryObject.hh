@@ -102,6 +102,11 @@ private:
 
 public:
 	RMAPMemoryObject() {
+		extendedAddress = 0x00;
+		address = 0x00000000;
+		length = 0;
+		key = 0x00;
+		increment = Increment;
 		accessMode = Readable | Writable | RMWable;
 		isAccessModeSet_ = false;
 		isKeySet_ = false;
@@ -138,6 +143,7 @@ public:
 	}
 
 	void setKey(uint8_t key) {
+		this->isKeySet_ = true;
 		this->key = key;
 	}
 
@@ -304,6 +310,12 @@ public:
 		}
 	}
 
+	/** @param[in] increment RMAPMemoryObject::Increment or RMAPMemoryObject::NonIncrement */
+	void setIncrementMode(uint32_t increment) {
+		isIncrementModeSet_ = true;
+		this->increment = increment;
+	}
+
 	bool isReadable() {
 		if ((accessMode & Readable) == 0) {
 			return false;
@@ -0,0 +1,409 @@
+/* 
+============================================================================
+SpaceWire/RMAP Library is provided under the MIT License.
+============================================================================
+
+Copyright (c) 2006-2013 Takayuki Yuasa and The Open-source SpaceWire Project
+
+Permission is hereby granted, free of charge, to any person obtaining a 
+copy of this software and associated documentation files (the 
+"Software"), to deal in the Software without restriction, including 
+without limitation the rights to use, copy, modify, merge, publish, 
+distribute, sublicense, and/or sell copies of the Software, and to 
+permit persons to whom the Software is furnished to do so, subject to 
+the following conditions:
+
+The above copyright notice and this permission notice shall be included 
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. 
+*/
+/*
+ * RMAPMemoryTarget.hh
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef RMAPMEMORYTARGET_HH_
+#define RMAPMEMORYTARGET_HH_
+
+#include "RMAPPacket.hh"
+#include "RMAPReplyStatus.hh"
+#include "RMAPTarget.hh"
+
+#include <atomic>
+#include <mutex>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+class RMAPMemoryTargetException: public CxxUtilities::Exception {
+public:
+	enum {
+		InvalidMemorySize, //
+		FileCouldNotBeOpened, //
+		FileCouldNotBeResized, //
+		MemoryCouldNotBeMapped
+	};
+
+public:
+	RMAPMemoryTargetException(int status) :
+			CxxUtilities::Exception(status) {
+	}
+
+	virtual ~RMAPMemoryTargetException() {
+	}
+
+public:
+	std::string toString() {
+		std::string result;
+		switch (status) {
+		case InvalidMemorySize:
+			result = "InvalidMemorySize";
+			break;
+		case FileCouldNotBeOpened:
+			result = "FileCouldNotBeOpened";
+			break;
+		case FileCouldNotBeResized:
+			result = "FileCouldNotBeResized";
+			break;
+		case MemoryCouldNotBeMapped:
+			result = "MemoryCouldNotBeMapped";
+			break;
+		default:
+			result = "Undefined status";
+			break;
+		}
+		return result;
+	}
+};
+
+/** An RMAPTargetAccessAction which executes read, write, and read-modify-write commands
+ * directly on a memory region. Replies are constructed in pooled RMAPPacket instances,
+ * and therefore no memory is allocated per command once the pools are warmed up.
+ */
+class RMAPMemoryAccessAction: public RMAPTargetAccessAction {
+private:
+	uint8_t* memory;
+	uint32_t baseAddress;
+	size_t memorySize;
+
+private:
+	size_t nonIncrementWordWidth;
+	size_t maximumVerifiedWriteLength;
+	//serializes read-modify-write commands (plain reads and writes are not serialized)
+	std::mutex readModifyWriteMutex;
+
+public:
+	std::atomic<size_t> nReadCommands;
+	std::atomic<size_t> nWriteCommands;
+	std::atomic<size_t> nReadModifyWriteCommands;
+	std::atomic<size_t> nReadBytes;
+	std::atomic<size_t> nWrittenBytes;
+	std::atomic<size_t> nErrorReplies;
+
+public:
+	static const size_t DefaultNonIncrementWordWidth = 4;
+	static const size_t DefaultMaximumVerifiedWriteLength = 0x00FFFFFF;
+
+public:
+	/** @param[in] memory a memory region which is mapped to baseAddress
+	 * @param[in] baseAddress RMAP address of memory[0]
+	 * @param[in] memorySize size of the region in bytes
+	 */
+	RMAPMemoryAccessAction(uint8_t* memory, uint32_t baseAddress, size_t memorySize) :
+			memory(memory), baseAddress(baseAddress), memorySize(memorySize) {
+		nonIncrementWordWidth = DefaultNonIncrementWordWidth;
+		maximumVerifiedWriteLength = DefaultMaximumVerifiedWriteLength;
+		resetCounters();
+	}
+
+public:
+	void resetCounters() {
+		nReadCommands = 0;
+		nWriteCommands = 0;
+		nReadModifyWriteCommands = 0;
+		nReadBytes = 0;
+		nWrittenBytes = 0;
+		nErrorReplies = 0;
+	}
+
+public:
+	/** Memory copies do not block, and are always executed in the receive thread. */
+	bool isInlineProcessingAllowed() {
+		return true;
+	}
+
+public:
+	void processTransaction(RMAPTransaction* rmapTransaction) throw (RMAPTargetAccessActionException) {
+		RMAPPacket* commandPacket = rmapTransaction->getCommandPacket();
+		uint8_t status;
+		if (commandPacket->isWrite()) {
+			nWriteCommands++;
+			status = write(rmapTransaction);
+		} else if (commandPacket->isVerifyFlagSet()) {
+			nReadModifyWriteCommands++;
+			status = readModifyWrite(rmapTransaction);
+		} else {
+			nReadCommands++;
+			status = read(rmapTransaction);
+		}
+		if (status != RMAPReplyStatus::CommandExcecutedSuccessfully) {
+			nErrorReplies++;
+			if (commandPacket->isReplyFlagSet()) {
+				setReplyWithStatus(rmapTransaction, status);
+				rmapTransaction->replyPacket->setLength(0);
+			}
+		}
+	}
+
+private:
+	/** Returns the offset in memory of an access, or returns false if the access is out of the region.
+	 * In the non-increment mode, all data are transferred from/to the same word.
+	 */
+	bool getOffset(RMAPPacket* commandPacket, size_t length, size_t& offset) {
+		size_t accessedLength = commandPacket->isIncrementFlagSet() ? length : std::min(length, nonIncrementWordWidth);
+		uint32_t address = commandPacket->getAddress();
+		if (address < baseAddress || memorySize < accessedLength) {
+			return false;
+		}
+		offset = address - baseAddress;
+		return offset <= memorySize - accessedLength;
+	}
+
+private:
+	uint8_t write(RMAPTransaction* rmapTransaction) {
+		RMAPPacket* commandPacket = rmapTransaction->getCommandPacket();
+		size_t length = commandPacket->getLength();
+		if (commandPacket->getDataSize() < length) {
+			return RMAPReplyStatus::EarlyEOP;
+		} else if (length < commandPacket->getDataSize()) {
+			return RMAPReplyStatus::CargoTooLarge;
+		}
+		if (commandPacket->isVerifyFlagSet() && maximumVerifiedWriteLength < length) {
+			//the data CRC of a verified write has been checked when the packet was interpreted
+			return RMAPReplyStatus::VerifyBufferOverrun;
+		}
+		size_t offset;
+		if (!getOffset(commandPacket, length, offset)) {
+			return RMAPReplyStatus::CommandNotImplementedOrNotAuthorized;
+		}
+		uint8_t* data = commandPacket->getDataBufferAsArrayPointer();
+		if (commandPacket->isIncrementFlagSet()) {
+			if (length != 0) {
+				memcpy(memory + offset, data, length);
+			}
+		} else {
+			for (size_t i = 0; i < length; i++) {
+				memory[offset + i % nonIncrementWordWidth] = data[i];
+			}
+		}
+		nWrittenBytes += length;
+		if (commandPacket->isReplyFlagSet()) {
+			setReplyWithStatus(rmapTransaction, RMAPReplyStatus::CommandExcecutedSuccessfully);
+		}
+		return RMAPReplyStatus::CommandExcecutedSuccessfully;
+	}
+
+private:
+	uint8_t read(RMAPTransaction* rmapTransaction) {
+		RMAPPacket* commandPacket = rmapTransaction->getCommandPacket();
+		size_t length = commandPacket->getLength();
+		size_t offset;
+		if (!getOffset(commandPacket, length, offset)) {
+			return RMAPReplyStatus::CommandNotImplementedOrNotAuthorized;
+		}
+		RMAPPacket* replyPacket = constructReplyPacket(rmapTransaction, RMAPReplyStatus::CommandExcecutedSuccessfully);
+		rmapTransaction->replyPacket = replyPacket;
+		if (commandPacket->isIncrementFlagSet()) {
+			replyPacket->setData(memory + offset, length);
+		} else {
+			std::vector<uint8_t>* data = replyPacket->getDataBuffer();
+			data->resize(length);
+			for (size_t i = 0; i < length; i++) {
+				(*data)[i] = memory[offset + i % nonIncrementWordWidth];
+			}
+			replyPacket->setLength(length);
+		}
+		nReadBytes += length;
+		return RMAPReplyStatus::CommandExcecutedSuccessfully;
+	}
+
+private:
+	/** The data part of a read-modify-write command consists of data followed by a mask of the same length.
+	 * memory = (data & mask) | (memory & ~mask), and the original memory content is returned.
+	 */
+	uint8_t readModifyWrite(RMAPTransaction* rmapTransaction) {
+		RMAPPacket* commandPacket = rmapTransaction->getCommandPacket();
+		if (!commandPacket->isIncrementFlagSet() || !commandPacket->isReplyFlagSet()) {
+			return RMAPReplyStatus::UnusedRMAPPacketTypeOrCommandCode;
+		}
+		size_t length = commandPacket->getLength();
+		if (length != commandPacket->getDataSize() || (length != 0 && length != 2 && length != 4 && length != 6 && length != 8)) {
+			return RMAPReplyStatus::RMWDataLengthError;
+		}
+		size_t wordLength = length / 2;
+		size_t offset;
+		if (!getOffset(commandPacket, wordLength, offset)) {
+			return RMAPReplyStatus::CommandNotImplementedOrNotAuthorized;
+		}
+		RMAPPacket* replyPacket = constructReplyPacket(rmapTransaction, RMAPReplyStatus::CommandExcecutedSuccessfully);
+		rmapTransaction->replyPacket = replyPacket;
+		uint8_t* data = commandPacket->getDataBufferAsArrayPointer();
+		{
+			std::lock_guard<std::mutex> guard(readModifyWriteMutex);
+			replyPacket->setData(memory + offset, wordLength);
+			for (size_t i = 0; i < wordLength; i++) {
+				uint8_t mask = data[wordLength + i];
+				memory[offset + i] = (data[i] & mask) | (memory[offset + i] & ~mask);
+			}
+		}
+		nReadBytes += wordLength;
+		nWrittenBytes += wordLength;
+		return RMAPReplyStatus::CommandExcecutedSuccessfully;
+	}
+
+public:
+	uint8_t* getMemory() const {
+		return memory;
+	}
+
+public:
+	size_t getMemorySize() const {
+		return memorySize;
+	}
+
+public:
+	uint32_t getBaseAddress() const {
+		return baseAddress;
+	}
+
+public:
+	size_t getNonIncrementWordWidth() const {
+		return nonIncrementWordWidth;
+	}
+
+public:
+	/** Sets the width of the word accessed repeatedly by non-increment commands (default 4 bytes). */
+	void setNonIncrementWordWidth(size_t nonIncrementWordWidth) {
+		this->nonIncrementWordWidth = (nonIncrementWordWidth == 0) ? 1 : nonIncrementWordWidth;
+	}
+
+public:
+	size_t getMaximumVerifiedWriteLength() const {
+		return maximumVerifiedWriteLength;
+	}
+
+public:
+	/** Verified writes longer than this are rejected with VerifyBufferOverrun. */
+	void setMaximumVerifiedWriteLength(size_t maximumVerifiedWriteLength) {
+		this->maximumVerifiedWriteLength = maximumVerifiedWriteLength;
+	}
+};
+
+/** An RMAP target which serves an address range from anonymous memory or from a memory-mapped file.
+ * This can be used as a stand-in of an FPGA board, e.g. to load-test initiators.
+ * @code
+ * RMAPMemoryTarget* memoryTarget = new RMAPMemoryTarget(0x00000000, 64 * 1024 * 1024);
+ * rmapEngine->addRMAPTarget(memoryTarget);
+ * @endcode
+ */
+class RMAPMemoryTarget: public RMAPTarget {
+private:
+	uint8_t* memory;
+	size_t memorySize;
+	int fileDescriptor;
+	RMAPAddressRange* addressRange;
+	RMAPMemoryAccessAction* memoryAccessAction;
+
+public:
+	/** Constructs a target backed by zero-filled anonymous memory. */
+	RMAPMemoryTarget(uint32_t baseAddress, size_t memorySize) throw (RMAPMemoryTargetException) {
+		fileDescriptor = -1;
+		map(baseAddress, memorySize, MAP_PRIVATE | MAP_ANONYMOUS);
+	}
+
+public:
+	/** Constructs a target backed by a file. The file is created or extended to memorySize if necessary,
+	 * and writes are reflected to the file.
+	 */
+	RMAPMemoryTarget(uint32_t baseAddress, size_t memorySize, std::string filename) throw (RMAPMemoryTargetException) {
+		fileDescriptor = ::open(filename.c_str(), O_RDWR | O_CREAT, 0644);
+		if (fileDescriptor < 0) {
+			throw RMAPMemoryTargetException(RMAPMemoryTargetException::FileCouldNotBeOpened);
+		}
+		struct stat fileStatus;
+		if (fstat(fileDescriptor, &fileStatus) != 0
+				|| ((size_t) fileStatus.st_size < memorySize && ftruncate(fileDescriptor, memorySize) != 0)) {
+			::close(fileDescriptor);
+			throw RMAPMemoryTargetException(RMAPMemoryTargetException::FileCouldNotBeResized);
+		}
+		try {
+			map(baseAddress, memorySize, MAP_SHARED);
+		} catch (RMAPMemoryTargetException& e) {
+			::close(fileDescriptor);
+			throw e;
+		}
+	}
+
+public:
+	virtual ~RMAPMemoryTarget() {
+		munmap(memory, memorySize);
+		if (fileDescriptor >= 0) {
+			::close(fileDescriptor);
+		}
+		delete memoryAccessAction;
+		delete addressRange;
+	}
+
+private:
+	void map(uint32_t baseAddress, size_t memorySize, int flags) throw (RMAPMemoryTargetException) {
+		//the whole region should be addressable with a 32-bit address
+		if (memorySize == 0 || (uint64_t) baseAddress + memorySize > 0x100000000ULL) {
+			throw RMAPMemoryTargetException(RMAPMemoryTargetException::InvalidMemorySize);
+		}
+		void* mapped = mmap(NULL, memorySize, PROT_READ | PROT_WRITE, flags, fileDescriptor, 0);
+		if (mapped == MAP_FAILED) {
+			throw RMAPMemoryTargetException(RMAPMemoryTargetException::MemoryCouldNotBeMapped);
+		}
+		this->memory = (uint8_t*) mapped;
+		this->memorySize = memorySize;
+		addressRange = new RMAPAddressRange(baseAddress, (uint32_t) (baseAddress + memorySize - 1));
+		memoryAccessAction = new RMAPMemoryAccessAction(memory, baseAddress, memorySize);
+		addAddressRangeAndAssociatedAction(addressRange, memoryAccessAction);
+	}
+
+public:
+	/** Writes modified pages back to the file (no-op for anonymous memory). */
+	void synchronize() {
+		if (fileDescriptor >= 0) {
+			msync(memory, memorySize, MS_SYNC);
+		}
+	}
+
+public:
+	uint8_t* getMemory() const {
+		return memory;
+	}
+
+public:
+	size_t getMemorySize() const {
+		return memorySize;
+	}
+
+public:
+	RMAPMemoryAccessAction* getMemoryAccessAction() const {
+		return memoryAccessAction;
+	}
+};
+
+#endif /* RMAPMEMORYTARGET_HH_ */
@@ -0,0 +1,175 @@
+/* 
+============================================================================
+SpaceWire/RMAP Library is provided under the MIT License.
+============================================================================
+
+Copyright (c) 2006-2013 Takayuki Yuasa and The Open-source SpaceWire Project
+
+Permission is hereby granted, free of charge, to any person obtaining a 
+copy of this software and associated documentation files (the 
+"Software"), to deal in the Software without restriction, including 
+without limitation the rights to use, copy, modify, merge, publish, 
+distribute, sublicense, and/or sell copies of the Software, and to 
+permit persons to whom the Software is furnished to do so, subject to 
+the following conditions:
+
+The above copyright notice and this permission notice shall be included 
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. 
+*/
+/*
+ * RMAPObjectPool.hh
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef RMAPOBJECTPOOL_HH_
+#define RMAPOBJECTPOOL_HH_
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+/** A free list of recycled instances of T.
+ * RMAPEngine draws RMAPPacket and RMAPTransaction instances from pools instead of
+ * allocating them per packet, and returns them when a transaction completes.
+ * A recycled RMAPPacket keeps the capacity of its buffers, so that the received bytes
+ * swapped into it do not cause reallocation either.
+ * Once the pool is warmed up, nAllocatedObjects stops increasing; comparing it before and
+ * after a measurement proves that steady-state traffic does not allocate objects.
+ * acquire() returns an instance as it was released; the user should reinitialize its fields.
+ * A subclass can override createObject() to initialize newly created instances
+ * (e.g. SpaceWireReceiveBufferPool).
+ */
+template<class T>
+class RMAPObjectPool {
+public:
+	static const size_t DefaultCapacity = 1024;
+
+private:
+	std::vector<T*> freeObjects;
+	std::mutex mutex;
+	size_t capacity;
+
+public:
+	//atomic so that they can be read while other threads acquire and release instances
+	/** Number of instances created with new because the pool was empty. */
+	std::atomic<size_t> nAllocatedObjects;
+	/** Number of instances taken from the pool. */
+	std::atomic<size_t> nReusedObjects;
+	/** Number of instances returned to the pool. */
+	std::atomic<size_t> nRecycledObjects;
+	/** Number of instances deleted because the pool was full. */
+	std::atomic<size_t> nDeletedObjects;
+
+public:
+	/** @param[in] capacity maximum number of free instances retained in the pool */
+	RMAPObjectPool(size_t capacity = DefaultCapacity) {
+		this->capacity = capacity;
+		freeObjects.reserve(capacity);
+		nAllocatedObjects = 0;
+		nReusedObjects = 0;
+		nRecycledObjects = 0;
+		nDeletedObjects = 0;
+	}
+
+	virtual ~RMAPObjectPool() {
+		for (size_t i = 0; i < freeObjects.size(); i++) {
+			delete freeObjects[i];
+		}
+	}
+
+private:
+	RMAPObjectPool(const RMAPObjectPool&);
+	RMAPObjectPool& operator=(const RMAPObjectPool&);
+
+public:
+	T* acquire() {
+		{
+			std::lock_guard<std::mutex> guard(mutex);
+			if (!freeObjects.empty()) {
+				T* object = freeObjects.back();
+				freeObjects.pop_back();
+				nReusedObjects++;
+				return object;
+			}
+			nAllocatedObjects++;
+		}
+		return createObject();
+	}
+
+public:
+	/** Returns an instance to the pool. The instance should have been created with new
+	 * (by this or another pool, or by the user). NULL is ignored.
+	 */
+	void release(T* object) {
+		if (object == NULL) {
+			return;
+		}
+		{
+			std::lock_guard<std::mutex> guard(mutex);
+			if (freeObjects.size() < capacity) {
+				freeObjects.push_back(object);
+				nRecycledObjects++;
+				return;
+			}
+			nDeletedObjects++;
+		}
+		delete object;
+	}
+
+public:
+	/** Creates instances in advance so that even the first packets do not allocate. */
+	void reserve(size_t nObjects) {
+		std::lock_guard<std::mutex> guard(mutex);
+		while (freeObjects.size() < nObjects && freeObjects.size() < capacity) {
+			freeObjects.push_back(createObject());
+			nAllocatedObjects++;
+		}
+	}
+
+public:
+	size_t getNFreeObjects() {
+		std::lock_guard<std::mutex> guard(mutex);
+		return freeObjects.size();
+	}
+
+public:
+	size_t getCapacity() {
+		std::lock_guard<std::mutex> guard(mutex);
+		return capacity;
+	}
+
+public:
+	/** Changes the maximum number of free instances. Excess instances are deleted. */
+	void setCapacity(size_t capacity) {
+		std::vector<T*> excessObjects;
+		{
+			std::lock_guard<std::mutex> guard(mutex);
+			this->capacity = capacity;
+			while (freeObjects.size() > capacity) {
+				excessObjects.push_back(freeObjects.back());
+				freeObjects.pop_back();
+				nDeletedObjects++;
+			}
+		}
+		for (size_t i = 0; i < excessObjects.size(); i++) {
+			delete excessObjects[i];
+		}
+	}
+
+protected:
+	/** Creates an instance when the pool is empty (and in reserve()). */
+	virtual T* createObject() {
+		return new T();
+	}
+};
+
+#endif /* RMAPOBJECTPOOL_HH_ */
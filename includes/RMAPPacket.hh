@@ -116,13 +116,17 @@ private:
 private:
 	uint16_t transactionID;
 
-private:
-	std::vector<uint8_t> header;
-
 private:
 	std::vector<uint8_t> data;
 	uint8_t dataCRC;
 
+private:
+	//when true, the data part is not copied to data, but referred in wholePacket
+	//(set by interpretAsAnRMAPPacketInPlace(), and cleared by materializeData())
+	bool dataIsInPacketBuffer;
+	size_t dataOffsetInPacketBuffer;
+	size_t dataSizeInPacketBuffer;
+
 private:
 	uint32_t headerCRCMode;
 	uint32_t dataCRCMode;
@@ -139,6 +143,10 @@ public:
 		AutoCRC = 0x00, ManualCRC = 0x01
 	};
 
+private:
+	//headers up to this size (i.e. reply addresses up to 12 bytes) are serialized on the stack
+	static const size_t MaximumHeaderSizeOnStack = 32;
+
 public:
 	static const uint8_t BitMaskForReserved = 0x80;
 	static const uint8_t BitMaskForCommandReply = 0x40;
@@ -197,73 +205,127 @@ public:
 		extendedAddress = RMAPProtocol::DefaultExtendedAddress;
 		headerCRC = 0;
 		dataCRC = 0;
+		dataIsInPacketBuffer = false;
+		dataOffsetInPacketBuffer = 0;
+		dataSizeInPacketBuffer = 0;
 	}
 
 public:
-	void constructHeader() {
-		using namespace std;
+	/** Returns the size of the header including the Header CRC. */
+	size_t getHeaderSize() {
+		if (isCommand()) {
+			size_t paddedReplyAddressLength = (replyAddress.size() + 3) / 4 * 4;
+			return 4 + paddedReplyAddressLength + 12;
+		} else if (isRead()) {
+			return 12;
+		} else {
+			return 8;
+		}
+	}
 
-		header.clear();
+public:
+	/** Returns the size of the whole packet (path address, header, data, and Data CRC)
+	 * which will be constructed by constructPacket() or constructPacketInto().
+	 */
+	size_t getPacketSize() {
+		size_t pathAddressLength = isCommand() ? targetSpaceWireAddress.size() : replyAddress.size();
+		size_t dataPartLength = hasData() ? data.size() + 1 : 0;
+		return pathAddressLength + getHeaderSize() + dataPartLength;
+	}
+
+private:
+	/** Serializes the header and the Header CRC into a buffer of getHeaderSize() bytes.
+	 * The Header CRC is calculated over the serialized bytes if headerCRCMode is AutoCRC.
+	 */
+	void serializeHeader(uint8_t* buffer) {
+		size_t i = 0;
 		if (isCommand()) {
 			//if command packet
-			header.push_back(targetLogicalAddress);
-			header.push_back(protocolID);
-			header.push_back(instruction);
-			header.push_back(key);
-			std::vector<uint8_t> tmpvector;
-			uint8_t tmporaryCounter = replyAddress.size();
-			while (tmporaryCounter % 4 != 0) {
-				header.push_back(0x00);
-				tmporaryCounter++;
+			buffer[i++] = targetLogicalAddress;
+			buffer[i++] = protocolID;
+			buffer[i++] = instruction;
+			buffer[i++] = key;
+			size_t paddingLength = (4 - replyAddress.size() % 4) % 4;
+			for (size_t j = 0; j < paddingLength; j++) {
+				buffer[i++] = 0x00;
 			}
-			for (size_t i = 0; i < replyAddress.size(); i++) {
-				header.push_back(replyAddress.at(i));
+			for (size_t j = 0; j < replyAddress.size(); j++) {
+				buffer[i++] = replyAddress[j];
 			}
-			header.push_back(initiatorLogicalAddress);
-			header.push_back((uint8_t) ((((((transactionID & 0xff00) >> 8))))));
-			header.push_back((uint8_t) ((((((transactionID & 0x00ff) >> 0))))));
-			header.push_back(extendedAddress);
-			header.push_back((uint8_t) ((((((address & 0xff000000) >> 24))))));
-			header.push_back((uint8_t) ((((((address & 0x00ff0000) >> 16))))));
-			header.push_back((uint8_t) ((((((address & 0x0000ff00) >> 8))))));
-			header.push_back((uint8_t) ((((((address & 0x000000ff) >> 0))))));
-			header.push_back((uint8_t) ((((((dataLength & 0x00ff0000) >> 16))))));
-			header.push_back((uint8_t) ((((((dataLength & 0x0000ff00) >> 8))))));
-			header.push_back((uint8_t) ((((((dataLength & 0x000000ff) >> 0))))));
+			buffer[i++] = initiatorLogicalAddress;
+			buffer[i++] = (uint8_t) ((transactionID & 0xff00) >> 8);
+			buffer[i++] = (uint8_t) ((transactionID & 0x00ff) >> 0);
+			buffer[i++] = extendedAddress;
+			buffer[i++] = (uint8_t) ((address & 0xff000000) >> 24);
+			buffer[i++] = (uint8_t) ((address & 0x00ff0000) >> 16);
+			buffer[i++] = (uint8_t) ((address & 0x0000ff00) >> 8);
+			buffer[i++] = (uint8_t) ((address & 0x000000ff) >> 0);
+			buffer[i++] = (uint8_t) ((dataLength & 0x00ff0000) >> 16);
+			buffer[i++] = (uint8_t) ((dataLength & 0x0000ff00) >> 8);
+			buffer[i++] = (uint8_t) ((dataLength & 0x000000ff) >> 0);
 		} else {
 			//if reply packet
-			header.push_back(initiatorLogicalAddress);
-			header.push_back(protocolID);
-			header.push_back(instruction);
-			header.push_back(status);
-			header.push_back(targetLogicalAddress);
-			header.push_back((uint8_t) ((((((transactionID & 0xff00) >> 8))))));
-			header.push_back((uint8_t) ((((((transactionID & 0x00ff) >> 0))))));
+			buffer[i++] = initiatorLogicalAddress;
+			buffer[i++] = protocolID;
+			buffer[i++] = instruction;
+			buffer[i++] = status;
+			buffer[i++] = targetLogicalAddress;
+			buffer[i++] = (uint8_t) ((transactionID & 0xff00) >> 8);
+			buffer[i++] = (uint8_t) ((transactionID & 0x00ff) >> 0);
 			if (isRead()) {
-				header.push_back(0);
-				header.push_back((uint8_t) ((((((dataLength & 0x00ff0000) >> 16))))));
-				header.push_back((uint8_t) ((((((dataLength & 0x0000ff00) >> 8))))));
-				header.push_back((uint8_t) ((((((dataLength & 0x000000ff) >> 0))))));
+				buffer[i++] = 0;
+				buffer[i++] = (uint8_t) ((dataLength & 0x00ff0000) >> 16);
+				buffer[i++] = (uint8_t) ((dataLength & 0x0000ff00) >> 8);
+				buffer[i++] = (uint8_t) ((dataLength & 0x000000ff) >> 0);
 			}
 		}
 
 		if (headerCRCMode == RMAPPacket::AutoCRC) {
-			calculateHeaderCRC();
+			if (!useDraftECRC) {
+				headerCRC = RMAPUtilities::calculateCRC(buffer, i);
+			} else {
+				headerCRC = RMAPUtilities::calculateCRCBasedOnDraftESpecification(buffer, i);
+			}
 		}
-		header.push_back(headerCRC);
+		buffer[i] = headerCRC;
 	}
 
 public:
-	inline void calculateHeaderCRC() {
-		if (!useDraftECRC) {
-			headerCRC = RMAPUtilities::calculateCRC(header);
+	/** Serializes the header from the current fields, and updates the Header CRC
+	 * if headerCRCMode is AutoCRC. The header is not kept, so that it never
+	 * goes stale; use getHeader() to obtain it.
+	 */
+	void constructHeader() {
+		size_t headerSize = getHeaderSize();
+		if (headerSize <= MaximumHeaderSizeOnStack) {
+			uint8_t buffer[MaximumHeaderSizeOnStack];
+			serializeHeader(buffer);
 		} else {
-			headerCRC = RMAPUtilities::calculateCRCBasedOnDraftESpecification(header);
+			std::vector<uint8_t> buffer(headerSize);
+			serializeHeader(&(buffer[0]));
 		}
 	}
 
+public:
+	/** Returns the header including the Header CRC, serialized from the current fields. */
+	std::vector<uint8_t> getHeader() {
+		std::vector<uint8_t> header(getHeaderSize());
+		serializeHeader(&(header[0]));
+		return header;
+	}
+
+public:
+	/** Calculates the Header CRC from the current fields regardless of headerCRCMode. */
+	inline void calculateHeaderCRC() {
+		uint32_t previousHeaderCRCMode = headerCRCMode;
+		headerCRCMode = RMAPPacket::AutoCRC;
+		constructHeader();
+		headerCRCMode = previousHeaderCRCMode;
+	}
+
 public:
 	inline void calculateDataCRC() {
+		materializeData();
 		if (!useDraftECRC) {
 			dataCRC = RMAPUtilities::calculateCRC(data);
 		} else {
@@ -272,29 +334,102 @@ public:
 	}
 
 public:
+	/** Constructs the packet into the internal buffer returned by getPacketBufferPointer().
+	 * The buffer is resized to the exact packet size and reused, so that
+	 * repeated construction does not allocate once the buffer has grown.
+	 */
 	void constructPacket() {
-		using namespace std;
+		materializeData();
+		wholePacket.resize(getPacketSize());
+		constructPacketInto(&(wholePacket[0]), wholePacket.size());
+	}
 
-		constructHeader();
-		if (dataCRCMode == RMAPPacket::AutoCRC) {
-			calculateDataCRC();
+public:
+	/** Serializes the path address, header, Header CRC, data, and Data CRC
+	 * into a caller-provided buffer in one pass.
+	 * @param[out] buffer destination of the packet.
+	 * @param[in] bufferSize the size of the buffer.
+	 * @returns the size of the constructed packet (same as getPacketSize()).
+	 * @throws RMAPPacketException::InsufficientBufferSize if the buffer is smaller than the packet.
+	 */
+	size_t constructPacketInto(uint8_t* buffer, size_t bufferSize) throw (RMAPPacketException) {
+		materializeData();
+		size_t packetSize = getPacketSize();
+		if (bufferSize < packetSize) {
+			throw RMAPPacketException(RMAPPacketException::InsufficientBufferSize);
 		}
-		wholePacket.clear();
-		if (isCommand() == true) {
-			SpaceWireUtilities::concatenateTo(wholePacket, targetSpaceWireAddress);
-		} else {
-			SpaceWireUtilities::concatenateTo(wholePacket, replyAddress);
+		std::vector<uint8_t>& pathAddress = isCommand() ? targetSpaceWireAddress : replyAddress;
+		size_t i = 0;
+		if (pathAddress.size() != 0) {
+			memcpy(buffer, &(pathAddress[0]), pathAddress.size());
+			i += pathAddress.size();
 		}
-		SpaceWireUtilities::concatenateTo(wholePacket, header);
-		SpaceWireUtilities::concatenateTo(wholePacket, data);
+		serializeHeader(buffer + i);
+		i += getHeaderSize();
 		if (hasData()) {
-			wholePacket.push_back(dataCRC);
+			//a zero-length write command/read reply still carries a data CRC
+			if (data.size() != 0) {
+				memcpy(buffer + i, &(data[0]), data.size());
+			}
+			if (dataCRCMode == RMAPPacket::AutoCRC) {
+				if (!useDraftECRC) {
+					dataCRC = RMAPUtilities::calculateCRC(buffer + i, data.size());
+				} else {
+					dataCRC = RMAPUtilities::calculateCRCBasedOnDraftESpecification(buffer + i, data.size());
+				}
+			}
+			i += data.size();
+			buffer[i++] = dataCRC;
+		} else if (dataCRCMode == RMAPPacket::AutoCRC) {
+			calculateDataCRC();
 		}
+		return i;
 	}
 
 public:
 	void interpretAsAnRMAPPacket(uint8_t *packet, size_t length) throw (RMAPPacketException) {
+		interpret(packet, length, true);
+	}
+
+public:
+	/** Interprets a received packet without copying its data part.
+	 * The content of receivedPacket is swapped into this instance (receivedPacket
+	 * receives the previous packet buffer of this instance, which can be reused
+	 * for the next receive), and the data part is referred in place via
+	 * getDataBufferAsArrayPointer() and getDataSize(). Accessors returning the
+	 * data vector copy the data part on first use.
+	 * @param[in,out] receivedPacket a received packet.
+	 */
+	void interpretAsAnRMAPPacketInPlace(std::vector<uint8_t>& receivedPacket) throw (RMAPPacketException) {
+		if (receivedPacket.size() == 0) {
+			throw RMAPPacketException(RMAPPacketException::PacketInterpretationFailed);
+		}
+		dataIsInPacketBuffer = false;
+		wholePacket.swap(receivedPacket);
+		interpret(&(wholePacket[0]), wholePacket.size(), false);
+	}
+
+private:
+	inline uint8_t calculateCRCOfArray(uint8_t* array, size_t length) {
+		if (!useDraftECRC) {
+			return RMAPUtilities::calculateCRC(array, length);
+		} else {
+			return RMAPUtilities::calculateCRCBasedOnDraftESpecification(array, length);
+		}
+	}
+
+private:
+	/** Interprets a packet. If copyData is false, packet should point wholePacket,
+	 * and the data part is left there.
+	 */
+	void interpret(uint8_t *packet, size_t length, bool copyData) throw (RMAPPacketException) {
 		using namespace std;
+		dataIsInPacketBuffer = false;
+		//a write reply carries neither data length nor data part, so that those of a previously
+		//interpreted packet are cleared for instances reused via RMAPObjectPool
+		data.clear();
+		dataLength = 0;
+		dataCRC = 0;
 
 		if (length < 8) {
 			throw(RMAPPacketException(RMAPPacketException::PacketInterpretationFailed));
@@ -367,22 +502,15 @@ public:
 				dataIndex = rmapIndexAfterSourcePathAddress + 12;
 				data.clear();
 				if (isWrite()) {
-					for (uint32_t i = 0; i < lengthSpecifiedInPacket; i++) {
-						if ((dataIndex + i) < (length - 1)) {
-							data.push_back(packet[dataIndex + i]);
-						} else {
-							throw(RMAPPacketException(RMAPPacketException::DataLengthMismatch));
-						}
-					}
-
-					//length check for DataCRC
+					//length check for data and DataCRC
 					uint8_t temporaryDataCRC = 0x00;
 					if ((dataIndex + lengthSpecifiedInPacket) == (length - 1)) {
 						temporaryDataCRC = packet[dataIndex + lengthSpecifiedInPacket];
 					} else {
 						throw(RMAPPacketException(RMAPPacketException::DataLengthMismatch));
 					}
-					calculateDataCRC();
+					setDataPart(packet, dataIndex, lengthSpecifiedInPacket, copyData);
+					dataCRC = calculateCRCOfArray(packet + dataIndex, lengthSpecifiedInPacket);
 					if (dataCRCIsChecked == true) {
 						if (dataCRC != temporaryDataCRC) {
 							throw(RMAPPacketException(RMAPPacketException::InvalidDataCRC));
@@ -434,23 +562,18 @@ public:
 					}
 					dataIndex = rmapIndex + 12;
 					data.clear();
-					for (uint32_t i = 0; i < lengthSpecifiedInPacket; i++) {
-						if ((dataIndex + i) < (length - 1)) {
-							data.push_back(packet[dataIndex + i]);
-						} else {
-							dataCRC = 0x00; //initialized
-							throw(RMAPPacketException(RMAPPacketException::DataLengthMismatch));
-						}
-					}
-
-					//length check for DataCRC
+					//length check for data and DataCRC
 					uint8_t temporaryDataCRC = 0x00;
 					if ((dataIndex + lengthSpecifiedInPacket) == (length - 1)) {
 						temporaryDataCRC = packet[dataIndex + lengthSpecifiedInPacket];
 					} else {
+						if ((dataIndex + lengthSpecifiedInPacket) > (length - 1)) {
+							dataCRC = 0x00; //initialized
+						}
 						throw(RMAPPacketException(RMAPPacketException::DataLengthMismatch));
 					}
-					calculateDataCRC();
+					setDataPart(packet, dataIndex, lengthSpecifiedInPacket, copyData);
+					dataCRC = calculateCRCOfArray(packet + dataIndex, lengthSpecifiedInPacket);
 					if (dataCRCIsChecked == true) {
 						if (dataCRC != temporaryDataCRC) {
 							throw(RMAPPacketException(RMAPPacketException::InvalidDataCRC));
@@ -465,6 +588,10 @@ public:
 		} catch (exception& e) {
 			throw(RMAPPacketException(RMAPPacketException::PacketInterpretationFailed));
 		}
+		if (!copyData) {
+			//wholePacket already holds the interpreted packet
+			return;
+		}
 		uint32_t previousHeaderCRCMode = headerCRCMode;
 		uint32_t previousDataCRCMode = dataCRCMode;
 		headerCRCMode = RMAPPacket::ManualCRC;
@@ -474,6 +601,27 @@ public:
 		dataCRCMode = previousDataCRCMode;
 	}
 
+private:
+	void setDataPart(uint8_t* packet, size_t dataIndex, size_t dataSize, bool copyData) {
+		if (copyData) {
+			data.assign(packet + dataIndex, packet + dataIndex + dataSize);
+		} else {
+			dataIsInPacketBuffer = true;
+			dataOffsetInPacketBuffer = dataIndex;
+			dataSizeInPacketBuffer = dataSize;
+		}
+	}
+
+private:
+	/** Copies the data part referred in wholePacket to data. */
+	void materializeData() {
+		if (dataIsInPacketBuffer) {
+			dataIsInPacketBuffer = false;
+			data.assign(wholePacket.begin() + dataOffsetInPacketBuffer,
+					wholePacket.begin() + dataOffsetInPacketBuffer + dataSizeInPacketBuffer);
+		}
+	}
+
 public:
 	void interpretAsAnRMAPPacket(std::vector<uint8_t> & data) throw (RMAPPacketException) {
 		if (data.size() == 0) {
@@ -667,7 +815,7 @@ public:
 
 public:
 	bool hasData() {
-		if (data.size() != 0) {
+		if (getDataSize() != 0) {
 			return true;
 		} else {
 			if ((isCommand() && isWrite()) || (isReply() && isRead())) {
@@ -680,47 +828,68 @@ public:
 	}
 
 public:
+	/** Returns a copy of the data part. This does not modify the instance, so that
+	 * concurrent calls on a packet interpreted in place are safe.
+	 */
 	std::vector<uint8_t> getData() const {
+		if (dataIsInPacketBuffer) {
+			return std::vector<uint8_t>(wholePacket.begin() + dataOffsetInPacketBuffer,
+					wholePacket.begin() + dataOffsetInPacketBuffer + dataSizeInPacketBuffer);
+		}
 		return data;
 	}
 
 public:
 	void getData(uint8_t *buffer, size_t maxLength) throw (RMAPPacketException) {
-		size_t length = data.size();
+		size_t length = getDataSize();
 		if (maxLength < length) {
 			throw RMAPPacketException(RMAPPacketException::InsufficientBufferSize);
 		}
-		for (uint32_t i = 0; i < length; i++) {
-			buffer[i] = data[i];
+		if (length != 0) {
+			memcpy(buffer, getDataBufferAsArrayPointer(), length);
 		}
 	}
 
 public:
 	void getData(std::vector<uint8_t> & buffer) {
-		size_t length = data.size();
+		size_t length = getDataSize();
 		buffer.resize(length);
 		getData(&(buffer[0]), length);
 	}
 
 public:
 	void getData(std::vector<uint8_t> *buffer) {
-		size_t length = data.size();
+		size_t length = getDataSize();
 		buffer->resize(length);
 		getData(&(buffer->at(0)), length);
 	}
 
 public:
+	/** Returns the size of the data part without copying it. */
+	size_t getDataSize() const {
+		return dataIsInPacketBuffer ? dataSizeInPacketBuffer : data.size();
+	}
+
+public:
+	/** Returns a pointer to the data part. For a packet interpreted via
+	 * interpretAsAnRMAPPacketInPlace(), this points into the received packet buffer.
+	 */
 	uint8_t* getDataBufferAsArrayPointer() {
+		if (dataIsInPacketBuffer) {
+			return (dataSizeInPacketBuffer != 0) ? &(wholePacket[dataOffsetInPacketBuffer]) : NULL;
+		}
 		return (data.size()!=0)? (uint8_t*) (&data[0]):NULL;
 	}
 
 public:
 	std::vector<uint8_t>* getDataBuffer() {
+		materializeData();
 		return &data;
 	}
 
 public:
 	std::vector<uint8_t>* getDataBufferAsVectorPointer() {
+		materializeData();
 		return &data;
 	}
 
@@ -781,16 +950,15 @@ public:
 
 public:
 	void setData(std::vector<uint8_t> & data) {
+		dataIsInPacketBuffer = false;
 		this->data = data;
 		this->dataLength = data.size();
 	}
 
 public:
 	void setData(uint8_t *data, size_t length) {
-		this->data.clear();
-		for (size_t i = 0; i < length; i++) {
-			this->data.push_back(data[i]);
-		}
+		dataIsInPacketBuffer = false;
+		this->data.assign(data, data + length);
 		this->dataLength = length;
 	}
 
@@ -885,16 +1053,19 @@ public:
 
 public:
 	inline void addData(uint8_t oneByte) {
+		materializeData();
 		this->data.push_back(oneByte);
 	}
 
 public:
 	inline void clearData() {
+		dataIsInPacketBuffer = false;
 		data.clear();
 	}
 
 public:
 	inline void addData(std::vector<uint8_t> array) {
+		materializeData();
 		size_t size = array.size();
 		for (size_t i = 0; i < size; i++) {
 			data.push_back(array[i]);
@@ -941,6 +1112,7 @@ public:
 
 private:
 	std::string toStringCommandPacket() {
+		materializeData();
 		using namespace std;
 
 		stringstream ss;
@@ -1004,6 +1176,7 @@ private:
 
 public:
 	std::string toStringReplyPacket() {
+		materializeData();
 		using namespace std;
 
 		stringstream ss;
@@ -1131,6 +1304,7 @@ public:
 
 public:
 	std::string toXMLStringCommandPacket(int nTabs = 0) {
+		materializeData();
 		this->constructPacket();
 		using namespace std;
 
@@ -1209,6 +1383,7 @@ public:
 
 public:
 	std::string toXMLStringReplyPacket(int nTabs = 0) {
+		materializeData();
 		this->constructPacket();
 		using namespace std;
 
@@ -1357,7 +1532,17 @@ public:
 	 */
 	static RMAPPacket* constructReplyForCommand(RMAPPacket* commandPacket, uint8_t status =
 			RMAPReplyStatus::CommandExcecutedSuccessfully) {
-		RMAPPacket* replyPacket = new RMAPPacket();
+		return constructReplyForCommand(commandPacket, new RMAPPacket(), status);
+	}
+
+public:
+	/** Constructs a reply packet for a corresponding command packet in an existing instance
+	 * (e.g. one recycled via RMAPObjectPool).
+	 * @param[in] commandPacket a command packet of which reply packet will be constructed
+	 * @param[out] replyPacket an instance which is overwritten with the reply
+	 * @return replyPacket
+	 */
+	static RMAPPacket* constructReplyForCommand(RMAPPacket* commandPacket, RMAPPacket* replyPacket, uint8_t status) {
 		*replyPacket = *commandPacket;
 
 		//remove leading zeros in the Reply Address (Reply SpaceWire Address)
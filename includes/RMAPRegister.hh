@@ -0,0 +1,157 @@
+/* 
+============================================================================
+SpaceWire/RMAP Library is provided under the MIT License.
+============================================================================
+
+Copyright (c) 2006-2013 Takayuki Yuasa and The Open-source SpaceWire Project
+
+Permission is hereby granted, free of charge, to any person obtaining a 
+copy of this software and associated documentation files (the 
+"Software"), to deal in the Software without restriction, including 
+without limitation the rights to use, copy, modify, merge, publish, 
+distribute, sublicense, and/or sell copies of the Software, and to 
+permit persons to whom the Software is furnished to do so, subject to 
+the following conditions:
+
+The above copyright notice and this permission notice shall be included 
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. 
+*/
+/*
+ * RMAPRegister.hh
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef RMAPREGISTER_HH_
+#define RMAPREGISTER_HH_
+
+#include "RMAPInitiator.hh"
+#include "RMAPMemoryObject.hh"
+#include "RMAPTargetNode.hh"
+
+/** Unsigned integer type which holds a register of a given length.
+ * Registers of other lengths are accessed only via byte buffers.
+ */
+template<uint32_t Length>
+class RMAPRegisterValueType {
+public:
+	class NoValue {
+	};
+	typedef NoValue Type;
+	static const bool IsDefined = false;
+};
+
+template<>
+class RMAPRegisterValueType<1> {
+public:
+	typedef uint8_t Type;
+	static const bool IsDefined = true;
+};
+
+template<>
+class RMAPRegisterValueType<2> {
+public:
+	typedef uint16_t Type;
+	static const bool IsDefined = true;
+};
+
+template<>
+class RMAPRegisterValueType<4> {
+public:
+	typedef uint32_t Type;
+	static const bool IsDefined = true;
+};
+
+template<>
+class RMAPRegisterValueType<8> {
+public:
+	typedef uint64_t Type;
+	static const bool IsDefined = true;
+};
+
+/** A memory object whose address, length, key, and access mode are compile-time constants.
+ * Register classes are generated from RMAPTargetNode XML files by main_RMAP_generateRegisterAccessors.
+ * read()/write() are direct raw-address transactions without memory object lookups, which carry
+ * the extended address and key of the register, and accessing a register in a way which its access mode
+ * does not permit is a compile error.
+ * @code
+ * uint32_t value = ShimafujiDIO::Status::readValue(rmapInitiator, rmapTargetNode);
+ * ShimafujiDIO::Command::write(rmapInitiator, rmapTargetNode, data);
+ * @endcode
+ * Register values of 1/2/4/8-byte registers are converted from/to the big endian byte order of RMAP.
+ */
+template<uint32_t Address, uint32_t Length, uint8_t Key, uint32_t AccessMode, uint8_t ExtendedAddress = 0x00,
+		bool Increment = true>
+class RMAPRegister {
+public:
+	static constexpr uint32_t address = Address;
+	static constexpr uint32_t length = Length;
+	static constexpr uint8_t key = Key;
+	static constexpr uint32_t accessMode = AccessMode;
+	static constexpr uint8_t extendedAddress = ExtendedAddress;
+	static constexpr bool increment = Increment;
+	static constexpr bool isReadable = (AccessMode & RMAPMemoryObject::Readable) != 0;
+	static constexpr bool isWritable = (AccessMode & RMAPMemoryObject::Writable) != 0;
+
+	typedef typename RMAPRegisterValueType<Length>::Type ValueType;
+
+	static_assert(Length != 0, "RMAPRegister: length should not be zero");
+	static_assert((uint64_t) Address + Length <= 0x100000000ULL, "RMAPRegister: address range exceeds 32 bits");
+	static_assert((AccessMode & ~(uint32_t) (RMAPMemoryObject::Readable | RMAPMemoryObject::Writable
+			| RMAPMemoryObject::RMWable)) == 0, "RMAPRegister: invalid access mode");
+	static_assert(Length <= 0x00FFFFFF, "RMAPRegister: length exceeds the RMAP data length field");
+
+public:
+	static void read(RMAPInitiator* rmapInitiator, RMAPTargetNode* rmapTargetNode, uint8_t* buffer,
+			double timeoutDuration = RMAPInitiator::DefaultTimeoutDuration) throw (RMAPEngineException,
+					RMAPInitiatorException, RMAPReplyException) {
+		static_assert(isReadable, "RMAPRegister: this register is not readable");
+		rmapInitiator->read(rmapTargetNode, ExtendedAddress, Address, Length, buffer, Key, Increment, timeoutDuration);
+	}
+
+public:
+	static void write(RMAPInitiator* rmapInitiator, RMAPTargetNode* rmapTargetNode, uint8_t* data,
+			double timeoutDuration = RMAPInitiator::DefaultTimeoutDuration) throw (RMAPEngineException,
+					RMAPInitiatorException, RMAPReplyException) {
+		static_assert(isWritable, "RMAPRegister: this register is not writable");
+		rmapInitiator->write(rmapTargetNode, ExtendedAddress, Address, data, Length, Key, Increment, timeoutDuration);
+	}
+
+public:
+	static ValueType readValue(RMAPInitiator* rmapInitiator, RMAPTargetNode* rmapTargetNode, double timeoutDuration =
+			RMAPInitiator::DefaultTimeoutDuration) throw (RMAPEngineException, RMAPInitiatorException,
+					RMAPReplyException) {
+		static_assert(RMAPRegisterValueType<Length>::IsDefined,
+				"RMAPRegister: readValue() is available only for 1/2/4/8-byte registers");
+		uint8_t buffer[Length];
+		read(rmapInitiator, rmapTargetNode, buffer, timeoutDuration);
+		ValueType value = 0;
+		for (uint32_t i = 0; i < Length; i++) {
+			value = (ValueType) ((value << 8) | buffer[i]);
+		}
+		return value;
+	}
+
+public:
+	static void writeValue(RMAPInitiator* rmapInitiator, RMAPTargetNode* rmapTargetNode, ValueType value,
+			double timeoutDuration = RMAPInitiator::DefaultTimeoutDuration) throw (RMAPEngineException,
+					RMAPInitiatorException, RMAPReplyException) {
+		static_assert(RMAPRegisterValueType<Length>::IsDefined,
+				"RMAPRegister: writeValue() is available only for 1/2/4/8-byte registers");
+		uint8_t buffer[Length];
+		for (uint32_t i = 0; i < Length; i++) {
+			buffer[Length - 1 - i] = (uint8_t) (value >> (8 * i));
+		}
+		write(rmapInitiator, rmapTargetNode, buffer, timeoutDuration);
+	}
+};
+
+#endif /* RMAPREGISTER_HH_ */
@@ -34,8 +34,12 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #ifndef RMAPTARGET_HH_
 #define RMAPTARGET_HH_
 
+#include "RMAPAddressRangeIndex.hh"
 #include "RMAPTransaction.hh"
 
+#include <algorithm>
+#include <mutex>
+
 class RMAPAddressRange {
 public:
 	uint32_t addressFrom;
@@ -113,25 +117,52 @@ public:
 	virtual void processTransaction(RMAPTransaction* rmapTransaction) throw (RMAPTargetAccessActionException)= 0;
 
 	virtual void transactionWillComplete(RMAPTransaction* rmapTransaction) throw (RMAPTargetAccessActionException) {
-		delete rmapTransaction->replyPacket;
+		releaseReplyPacket(rmapTransaction);
 	}
 
 	virtual void transactionReplyCouldNotBeSent(RMAPTransaction* rmapTransaction)
 			throw (RMAPTargetAccessActionException) {
-		delete rmapTransaction->replyPacket;
+		releaseReplyPacket(rmapTransaction);
+	}
+
+	/** Returns true if processTransaction() completes quickly without blocking.
+	 * RMAPEngine then processes the transaction in its receive thread instead of
+	 * handing it over to a worker thread.
+	 */
+	virtual bool isInlineProcessingAllowed() {
+		return false;
 	}
 
 public:
 	void setReplyWithDataWithStatus(RMAPTransaction* rmapTransaction, std::vector<uint8_t>* data, uint8_t status) {
-		rmapTransaction->replyPacket = RMAPPacket::constructReplyForCommand(rmapTransaction->commandPacket, status);
+		rmapTransaction->replyPacket = constructReplyPacket(rmapTransaction, status);
 		rmapTransaction->replyPacket->setData(*data);
 	}
 
 	void setReplyWithStatus(RMAPTransaction* rmapTransaction, uint8_t status) {
-		rmapTransaction->replyPacket = RMAPPacket::constructReplyForCommand(rmapTransaction->commandPacket, status);
+		rmapTransaction->replyPacket = constructReplyPacket(rmapTransaction, status);
 		rmapTransaction->replyPacket->clearData();
 	}
 
+	/** Constructs a reply packet, recycling an instance from the packet pool of RMAPEngine if available. */
+	RMAPPacket* constructReplyPacket(RMAPTransaction* rmapTransaction, uint8_t status) {
+		if (rmapTransaction->packetPool == NULL) {
+			return RMAPPacket::constructReplyForCommand(rmapTransaction->commandPacket, status);
+		}
+		return RMAPPacket::constructReplyForCommand(rmapTransaction->commandPacket,
+				rmapTransaction->packetPool->acquire(), status);
+	}
+
+	/** Returns the reply packet to the packet pool of RMAPEngine (or deletes it if there is no pool). */
+	void releaseReplyPacket(RMAPTransaction* rmapTransaction) {
+		if (rmapTransaction->packetPool == NULL) {
+			delete rmapTransaction->replyPacket;
+		} else {
+			rmapTransaction->packetPool->release(rmapTransaction->replyPacket);
+		}
+		rmapTransaction->replyPacket = NULL;
+	}
+
 };
 
 class RMAPTargetException: public CxxUtilities::Exception {
@@ -150,24 +181,146 @@ public:
 
 };
 
+class RMAPTarget;
+
+/** Invoked when an RMAPTarget instance is modified (see RMAPTarget::addModifiedAction()). */
+class RMAPTargetModifiedAction {
+public:
+	virtual ~RMAPTargetModifiedAction() {
+	}
+
+public:
+	virtual void doAction(RMAPTarget* rmapTarget) = 0;
+};
+
 class RMAPTarget {
+public:
+	/** Set to targetLogicalAddress/key/extendedAddress to accept commands with any value (default). */
+	static const uint32_t AnyValue = 0x100;
+
 private:
 	std::map<RMAPAddressRange*, RMAPTargetAccessAction*> actions;
 	std::vector<RMAPAddressRange*> addressRanges;
 
+private:
+	uint32_t targetLogicalAddress;
+	uint32_t key;
+	uint32_t extendedAddress;
+
+private:
+	//sorted index of addressRanges, rebuilt when a range is added
+	RMAPAddressRangeIndex addressRangeIndex;
+	bool addressRangeIndexIsValid;
+	std::mutex addressRangeIndexMutex;
+
+private:
+	std::vector<RMAPTargetModifiedAction*> modifiedActions;
+	std::mutex modifiedActionsMutex;
+
 public:
 	RMAPTarget() {
+		targetLogicalAddress = AnyValue;
+		key = AnyValue;
+		extendedAddress = AnyValue;
+		addressRangeIndexIsValid = false;
+	}
+
+	virtual ~RMAPTarget() {
+
+	}
 
+public:
+	/** Registers an action which is invoked whenever this target is modified.
+	 * RMAPEngine registers an action to each of its targets so that it can tell that its dispatch index
+	 * has become stale.
+	 */
+	void addModifiedAction(RMAPTargetModifiedAction* action) {
+		std::lock_guard<std::mutex> guard(modifiedActionsMutex);
+		if (std::find(modifiedActions.begin(), modifiedActions.end(), action) == modifiedActions.end()) {
+			modifiedActions.push_back(action);
+		}
 	}
 
-	~RMAPTarget() {
+public:
+	void removeModifiedAction(RMAPTargetModifiedAction* action) {
+		std::lock_guard<std::mutex> guard(modifiedActionsMutex);
+		modifiedActions.erase(std::remove(modifiedActions.begin(), modifiedActions.end(), action),
+				modifiedActions.end());
+	}
 
+protected:
+	void modified() {
+		{
+			std::lock_guard<std::mutex> guard(addressRangeIndexMutex);
+			addressRangeIndexIsValid = false;
+		}
+		std::lock_guard<std::mutex> guard(modifiedActionsMutex);
+		for (size_t i = 0; i < modifiedActions.size(); i++) {
+			modifiedActions[i]->doAction(this);
+		}
 	}
 
 public:
+	/** Registers an address range. The range should not be modified after registration.
+	 * Command packets are dispatched to the action of the first registered range which contains
+	 * the accessed range.
+	 */
 	void addAddressRangeAndAssociatedAction(RMAPAddressRange* addressRange, RMAPTargetAccessAction* action) {
 		actions[addressRange] = action;
 		addressRanges.push_back(addressRange);
+		modified();
+	}
+
+public:
+	std::vector<RMAPAddressRange*>* getAddressRanges() {
+		return &addressRanges;
+	}
+
+public:
+	RMAPTargetAccessAction* getAction(RMAPAddressRange* addressRange) {
+		std::map<RMAPAddressRange*, RMAPTargetAccessAction*>::iterator it = actions.find(addressRange);
+		return (it != actions.end()) ? it->second : NULL;
+	}
+
+public:
+	/** Restricts this target to commands addressed to a logical address (AnyValue to accept any). */
+	void setTargetLogicalAddress(uint32_t targetLogicalAddress) {
+		this->targetLogicalAddress = targetLogicalAddress;
+		modified();
+	}
+
+	uint32_t getTargetLogicalAddress() const {
+		return targetLogicalAddress;
+	}
+
+public:
+	/** Restricts this target to commands with a key (AnyValue to accept any). */
+	void setKey(uint32_t key) {
+		this->key = key;
+		modified();
+	}
+
+	uint32_t getKey() const {
+		return key;
+	}
+
+public:
+	/** Restricts this target to commands with an extended address (AnyValue to accept any). */
+	void setExtendedAddress(uint32_t extendedAddress) {
+		this->extendedAddress = extendedAddress;
+		modified();
+	}
+
+	uint32_t getExtendedAddress() const {
+		return extendedAddress;
+	}
+
+public:
+	/** Returns true if the logical address, key, and extended address of a command match this target. */
+	bool acceptsCommand(RMAPPacket* commandPacket) const {
+		return (targetLogicalAddress == AnyValue || targetLogicalAddress == commandPacket->getTargetLogicalAddress())
+				&& (key == AnyValue || key == commandPacket->getKey())
+				&& (extendedAddress == AnyValue || extendedAddress == commandPacket->getExtendedAddress());
 	}
 
 	bool doesAcceptAddressRange(RMAPAddressRange addressRange) {
@@ -211,15 +364,29 @@ public:
 	/** Can return NULL. */
 	RMAPTargetAccessAction* getCorrespondingRMAPTargetAccessAction(RMAPTransaction* rmapTransaction) {
 		using namespace std;
+		if (!acceptsCommand(rmapTransaction->commandPacket)) {
+			return NULL;
+		}
 		uint32_t addressFrom = rmapTransaction->commandPacket->getAddress();
 		uint32_t addressTo = addressFrom + rmapTransaction->commandPacket->getLength() - 1;
-		RMAPAddressRange addressRange(addressFrom, addressTo);
+		std::lock_guard<std::mutex> guard(addressRangeIndexMutex);
+		if (!addressRangeIndexIsValid) {
+			addressRangeIndex = RMAPAddressRangeIndex();
+			addRangesTo(addressRangeIndex, 0);
+			addressRangeIndex.build();
+			addressRangeIndexIsValid = true;
+		}
+		const RMAPAddressRangeIndex::Entry* entry = addressRangeIndex.find(addressFrom, addressTo);
+		return (entry != NULL) ? entry->action : NULL;
+	}
+
+public:
+	/** Adds the address ranges of this target to an index. The order of the i-th range is firstOrder+i. */
+	void addRangesTo(RMAPAddressRangeIndex& index, uint64_t firstOrder) {
 		for (size_t i = 0; i < addressRanges.size(); i++) {
-			if (addressRanges[i]->contains(addressRange) == true) {
-				return actions[addressRanges[i]];
-			}
+			index.add(addressRanges[i]->addressFrom, addressRanges[i]->addressTo, firstOrder + i,
+					actions[addressRanges[i]]);
 		}
-		return NULL;
 	}
 
 };
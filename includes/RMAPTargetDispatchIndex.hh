@@ -0,0 +1,133 @@
+/* 
+============================================================================
+SpaceWire/RMAP Library is provided under the MIT License.
+============================================================================
+
+Copyright (c) 2006-2013 Takayuki Yuasa and The Open-source SpaceWire Project
+
+Permission is hereby granted, free of charge, to any person obtaining a 
+copy of this software and associated documentation files (the 
+"Software"), to deal in the Software without restriction, including 
+without limitation the rights to use, copy, modify, merge, publish, 
+distribute, sublicense, and/or sell copies of the Software, and to 
+permit persons to whom the Software is furnished to do so, subject to 
+the following conditions:
+
+The above copyright notice and this permission notice shall be included 
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. 
+*/
+/*
+ * RMAPTargetDispatchIndex.hh
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef RMAPTARGETDISPATCHINDEX_HH_
+#define RMAPTARGETDISPATCHINDEX_HH_
+
+#include "RMAPAddressRangeIndex.hh"
+#include "RMAPPacket.hh"
+#include "RMAPTarget.hh"
+
+#include <unordered_map>
+#include <vector>
+
+/** An immutable index used by RMAPEngine to find the RMAPTargetAccessAction of a received command
+ * without scanning all RMAPTarget instances and their address ranges.
+ * Address ranges are grouped by (target logical address, key, extended address) of their RMAPTarget,
+ * and each group is an RMAPAddressRangeIndex. A lookup probes one hash table entry per combination
+ * of wildcards (RMAPTarget::AnyValue) actually used by the targets (usually one), followed by
+ * a binary search. The result is the same as checking targets in registration order and
+ * their ranges in registration order.
+ */
+class RMAPTargetDispatchIndex {
+private:
+	enum {
+		AnyTargetLogicalAddress = 0x01, AnyKey = 0x02, AnyExtendedAddress = 0x04
+	};
+
+private:
+	std::unordered_map<uint32_t, RMAPAddressRangeIndex> addressRangeIndices;
+	//combinations of wildcards used by the targets
+	std::vector<uint32_t> wildcardPatterns;
+	//version of the target list of RMAPEngine when this index was built
+	size_t version;
+
+public:
+	RMAPTargetDispatchIndex(const std::vector<RMAPTarget*>& rmapTargets, size_t version) {
+		this->version = version;
+		bool patternIsUsed[8] = { false, false, false, false, false, false, false, false };
+		for (size_t i = 0; i < rmapTargets.size(); i++) {
+			RMAPTarget* rmapTarget = rmapTargets[i];
+			uint32_t pattern = 0;
+			if (rmapTarget->getTargetLogicalAddress() == RMAPTarget::AnyValue) {
+				pattern |= AnyTargetLogicalAddress;
+			}
+			if (rmapTarget->getKey() == RMAPTarget::AnyValue) {
+				pattern |= AnyKey;
+			}
+			if (rmapTarget->getExtendedAddress() == RMAPTarget::AnyValue) {
+				pattern |= AnyExtendedAddress;
+			}
+			patternIsUsed[pattern] = true;
+			uint32_t key = toKey(rmapTarget->getTargetLogicalAddress(), rmapTarget->getKey(),
+					rmapTarget->getExtendedAddress());
+			//ranges of an earlier target precede those of a later one
+			rmapTarget->addRangesTo(addressRangeIndices[key], (uint64_t) i << 32);
+		}
+		for (uint32_t pattern = 0; pattern < 8; pattern++) {
+			if (patternIsUsed[pattern]) {
+				wildcardPatterns.push_back(pattern);
+			}
+		}
+		std::unordered_map<uint32_t, RMAPAddressRangeIndex>::iterator it = addressRangeIndices.begin();
+		for (; it != addressRangeIndices.end(); it++) {
+			it->second.build();
+		}
+	}
+
+private:
+	static uint32_t toKey(uint32_t targetLogicalAddress, uint32_t key, uint32_t extendedAddress) {
+		//each field has 9 bits so that RMAPTarget::AnyValue (0x100) is distinguished
+		return (targetLogicalAddress << 18) | (key << 9) | extendedAddress;
+	}
+
+public:
+	/** Returns the action which processes a command, or NULL if no RMAPTarget accepts it. */
+	RMAPTargetAccessAction* find(RMAPPacket* commandPacket) const {
+		uint32_t addressFrom = commandPacket->getAddress();
+		uint32_t addressTo = addressFrom + commandPacket->getLength() - 1;
+		const RMAPAddressRangeIndex::Entry* found = NULL;
+		for (size_t i = 0; i < wildcardPatterns.size(); i++) {
+			uint32_t pattern = wildcardPatterns[i];
+			uint32_t key = toKey(
+					(pattern & AnyTargetLogicalAddress) ? RMAPTarget::AnyValue : commandPacket->getTargetLogicalAddress(),
+					(pattern & AnyKey) ? RMAPTarget::AnyValue : commandPacket->getKey(),
+					(pattern & AnyExtendedAddress) ? RMAPTarget::AnyValue : commandPacket->getExtendedAddress());
+			std::unordered_map<uint32_t, RMAPAddressRangeIndex>::const_iterator it = addressRangeIndices.find(key);
+			if (it == addressRangeIndices.end()) {
+				continue;
+			}
+			const RMAPAddressRangeIndex::Entry* entry = it->second.find(addressFrom, addressTo);
+			if (entry != NULL && (found == NULL || entry->order < found->order)) {
+				found = entry;
+			}
+		}
+		return (found != NULL) ? found->action : NULL;
+	}
+
+public:
+	size_t getVersion() const {
+		return version;
+	}
+};
+
+#endif /* RMAPTARGETDISPATCHINDEX_HH_ */
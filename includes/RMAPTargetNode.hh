@@ -93,12 +93,16 @@ private:
 	uint8_t targetLogicalAddress;
 	uint8_t initiatorLogicalAddress;
 	uint8_t defaultKey;
+	uint32_t maximumDataLengthPerTransaction;
+	size_t linkIndex;
 
 	bool isInitiatorLogicalAddressSet_;
 
 public:
 	static const uint8_t DefaultLogicalAddress = 0xFE;
 	static const uint8_t DefaultKey = 0x20;
+	/** Data length of a single transaction used when a range read/write is split into chunks. */
+	static const uint32_t DefaultMaximumDataLengthPerTransaction = 1024;
 
 private:
 	std::map<std::string, RMAPMemoryObject*> memoryObjects;
@@ -108,6 +112,8 @@ public:
 		targetLogicalAddress = 0xFE;
 		initiatorLogicalAddress = 0xFE;
 		defaultKey = DefaultKey;
+		maximumDataLengthPerTransaction = DefaultMaximumDataLengthPerTransaction;
+		linkIndex = 0;
 		isInitiatorLogicalAddressSet_ = false;
 	}
 
@@ -229,6 +235,13 @@ public:
 			using namespace std;
 			targetNode->setInitiatorLogicalAddress(node->getChild("InitiatorLogicalAddress")->getValueAsUInt8());
 		}
+		if (node->getChild("MaximumDataLengthPerTransaction") != NULL) {
+			targetNode->setMaximumDataLengthPerTransaction(
+					String::toInteger(node->getChild("MaximumDataLengthPerTransaction")->getValue()));
+		}
+		if (node->getChild("LinkIndex") != NULL) {
+			targetNode->setLinkIndex(String::toInteger(node->getChild("LinkIndex")->getValue()));
+		}
 		constructRMAPMemoryObjectFromXMLFile(node, targetNode);
 
 		return targetNode;
@@ -358,6 +371,33 @@ public:
 		return initiatorLogicalAddress;
 	}
 
+public:
+	/** Returns the maximum data length of a single transaction.
+	 * readRange()/writeRange() of RMAPInitiator split a memory range into chunks of this size.
+	 */
+	uint32_t getMaximumDataLengthPerTransaction() const {
+		return maximumDataLengthPerTransaction;
+	}
+
+public:
+	void setMaximumDataLengthPerTransaction(uint32_t maximumDataLengthPerTransaction) {
+		this->maximumDataLengthPerTransaction =
+				(maximumDataLengthPerTransaction != 0) ? maximumDataLengthPerTransaction : 1;
+	}
+
+public:
+	/** Returns the index of the RMAPEngine link via which this node is accessed
+	 * (see RMAPEngine::addSpaceWireIF()). 0 (the primary link) by default.
+	 */
+	size_t getLinkIndex() const {
+		return linkIndex;
+	}
+
+public:
+	void setLinkIndex(size_t linkIndex) {
+		this->linkIndex = linkIndex;
+	}
+
 public:
 	void addMemoryObject(RMAPMemoryObject* memoryObject) {
 		memoryObjects[memoryObject->getID()] = memoryObject;
@@ -409,6 +449,12 @@ public:
 		ss << "Target SpaceWire Address  : " << SpaceWireUtilities::packetToString(&targetSpaceWireAddress) << endl;
 		ss << "Reply Address             : " << SpaceWireUtilities::packetToString(&replyAddress) << endl;
 		ss << "Default Key               : 0x" << right << hex << setw(2) << setfill('0') << (uint32_t) defaultKey << endl;
+		if (maximumDataLengthPerTransaction != DefaultMaximumDataLengthPerTransaction) {
+			ss << "Max Data Length/Trans.    : " << dec << maximumDataLengthPerTransaction << endl;
+		}
+		if (linkIndex != 0) {
+			ss << "Link Index                : " << dec << linkIndex << endl;
+		}
 		std::map<std::string, RMAPMemoryObject*>::iterator it = memoryObjects.begin();
 		for (; it != memoryObjects.end(); it++) {
 			ss << it->second->toString(nTabs + 1);
@@ -441,6 +487,13 @@ public:
 		ss << "	<ReplyAddress>" << SpaceWireUtilities::packetToString(&replyAddress) << "</ReplyAddress>" << endl;
 		ss << "	<DefaultKey>" << "0x" << hex << right << setw(2) << setfill('0') << (uint32_t) defaultKey << "</DefaultKey>"
 				<< endl;
+		if (maximumDataLengthPerTransaction != DefaultMaximumDataLengthPerTransaction) {
+			ss << "	<MaximumDataLengthPerTransaction>" << dec << maximumDataLengthPerTransaction
+					<< "</MaximumDataLengthPerTransaction>" << endl;
+		}
+		if (linkIndex != 0) {
+			ss << "	<LinkIndex>" << dec << linkIndex << "</LinkIndex>" << endl;
+		}
 		std::map<std::string, RMAPMemoryObject*>::iterator it = memoryObjects.begin();
 		for (; it != memoryObjects.end(); it++) {
 			ss << it->second->toXMLString(nTabs + 1);
@@ -463,7 +516,9 @@ public:
 class RMAPTargetNodeDBException: public CxxUtilities::Exception {
 public:
 	enum {
-		NoSuchRMAPTargetNode
+		NoSuchRMAPTargetNode, //
+		NoSuchRMAPMemoryObject, //
+		InvalidHandle
 	};
 
 public:
@@ -479,6 +534,12 @@ public:
 		case NoSuchRMAPTargetNode:
 			result = "NoSuchRMAPTargetNode";
 			break;
+		case NoSuchRMAPMemoryObject:
+			result = "NoSuchRMAPMemoryObject";
+			break;
+		case InvalidHandle:
+			result = "InvalidHandle";
+			break;
 		default:
 			result = "Undefined status";
 			break;
@@ -487,22 +548,101 @@ public:
 	}
 };
 
+/** A compact handle of an RMAPTargetNode in an RMAPTargetNodeDB.
+ * Obtained once via RMAPTargetNodeDB::resolveRMAPTargetNode(), and then used without string lookups.
+ */
+class RMAPTargetNodeHandle {
+public:
+	static const uint32_t InvalidIndex = 0xFFFFFFFF;
+
+public:
+	uint32_t index;
+
+public:
+	RMAPTargetNodeHandle() :
+			index(InvalidIndex) {
+	}
+
+	explicit RMAPTargetNodeHandle(uint32_t index) :
+			index(index) {
+	}
+
+public:
+	bool isValid() const {
+		return index != InvalidIndex;
+	}
+};
+
+/** A compact handle of an RMAPMemoryObject of an RMAPTargetNode in an RMAPTargetNodeDB.
+ * Obtained once via RMAPTargetNodeDB::resolveMemoryObject().
+ */
+class RMAPMemoryObjectHandle {
+public:
+	static const uint32_t InvalidIndex = 0xFFFFFFFF;
+
+public:
+	uint32_t index;
+
+public:
+	RMAPMemoryObjectHandle() :
+			index(InvalidIndex) {
+	}
+
+	explicit RMAPMemoryObjectHandle(uint32_t index) :
+			index(index) {
+	}
+
+public:
+	bool isValid() const {
+		return index != InvalidIndex;
+	}
+};
+
+/** A set of RMAPTargetNode instances keyed by their IDs.
+ * IDs are interned when nodes are added, so that handles resolved via resolveRMAPTargetNode()
+ * and resolveMemoryObject() refer to nodes and memory objects by array indices.
+ * A handle remains valid when a node is replaced by another node with the same ID
+ * (memory object handles then refer to the memory object with the same ID in the new node).
+ * Like the other methods of this class, resolving handles is not thread safe; resolve them
+ * before accessing the DB from multiple threads.
+ */
 class RMAPTargetNodeDB {
 private:
 	std::map<std::string, RMAPTargetNode*> db; //targetNodeID-RMAPTargetNodeInstance
 
+private:
+	//interned target node IDs; targetNodesByHandle[targetNodeHandles[id]] is db[id]
+	std::map<std::string, uint32_t> targetNodeHandles;
+	std::vector<RMAPTargetNode*> targetNodesByHandle;
+
+private:
+	class MemoryObjectEntry {
+	public:
+		uint32_t targetNodeIndex;
+		std::string memoryObjectID;
+		RMAPMemoryObject* memoryObject;
+	};
+	std::map<std::pair<uint32_t, std::string>, uint32_t> memoryObjectHandles;
+	std::vector<MemoryObjectEntry> memoryObjectEntries;
+
+private:
+	//for each logical address, the node with the smallest ID (same as scanning db in order)
+	RMAPTargetNode* targetNodesByLogicalAddress[256];
+
 public:
 	RMAPTargetNodeDB() {
-
+		updateLogicalAddressIndex();
 	}
 
 public:
 	RMAPTargetNodeDB(std::vector<RMAPTargetNode*> rmapTargetNodes) {
+		updateLogicalAddressIndex();
 		addRMAPTargetNodes(rmapTargetNodes);
 	}
 
 public:
 	RMAPTargetNodeDB(std::string filename) {
+		updateLogicalAddressIndex();
 		try {
 			addRMAPTargetNodes(RMAPTargetNode::constructFromXMLFile(filename));
 		} catch (...) {
@@ -517,7 +657,27 @@ public:
 
 public:
 	void addRMAPTargetNode(RMAPTargetNode* rmapTargetNode) {
-		db[rmapTargetNode->getID()] = rmapTargetNode;
+		std::string id = rmapTargetNode->getID();
+		db[id] = rmapTargetNode;
+		std::map<std::string, uint32_t>::iterator it = targetNodeHandles.find(id);
+		if (it == targetNodeHandles.end()) {
+			targetNodeHandles[id] = targetNodesByHandle.size();
+			targetNodesByHandle.push_back(rmapTargetNode);
+			RMAPTargetNode*& indexedNode = targetNodesByLogicalAddress[rmapTargetNode->getTargetLogicalAddress()];
+			if (indexedNode == NULL || id < indexedNode->getID()) {
+				indexedNode = rmapTargetNode;
+			}
+		} else {
+			//replaced; re-resolve memory objects of the node
+			targetNodesByHandle[it->second] = rmapTargetNode;
+			for (size_t i = 0; i < memoryObjectEntries.size(); i++) {
+				if (memoryObjectEntries[i].targetNodeIndex == it->second) {
+					memoryObjectEntries[i].memoryObject = rmapTargetNode->findMemoryObject(
+							memoryObjectEntries[i].memoryObjectID);
+				}
+			}
+			updateLogicalAddressIndex();
+		}
 	}
 
 public:
@@ -567,13 +727,91 @@ public:
 	/** This method can return NULL when an RMAPTargetNode with a specified logical address is not found.
 	 */
 	RMAPTargetNode* findRMAPTargetNode(uint8_t logicalAddress) {
-		std::map<std::string, RMAPTargetNode*>::iterator it = db.begin();
-		for (; it != db.end(); it++) {
-			if (it->second->getTargetLogicalAddress() == logicalAddress) {
-				return it->second;
-			}
+		return targetNodesByLogicalAddress[logicalAddress];
+	}
+
+public:
+	/** Rebuilds the index used by findRMAPTargetNode(uint8_t). Call this after changing
+	 * the target logical address of a registered RMAPTargetNode.
+	 */
+	void updateLogicalAddressIndex() {
+		for (size_t i = 0; i < 256; i++) {
+			targetNodesByLogicalAddress[i] = NULL;
+		}
+		std::map<std::string, RMAPTargetNode*>::reverse_iterator it = db.rbegin();
+		for (; it != db.rend(); it++) {
+			targetNodesByLogicalAddress[it->second->getTargetLogicalAddress()] = it->second;
+		}
+	}
+
+public:
+	/** Returns a handle of an RMAPTargetNode. */
+	RMAPTargetNodeHandle resolveRMAPTargetNode(std::string id) throw (RMAPTargetNodeDBException) {
+		std::map<std::string, uint32_t>::iterator it = targetNodeHandles.find(id);
+		if (it == targetNodeHandles.end()) {
+			throw RMAPTargetNodeDBException(RMAPTargetNodeDBException::NoSuchRMAPTargetNode);
+		}
+		return RMAPTargetNodeHandle(it->second);
+	}
+
+public:
+	/** Returns a handle of an RMAPMemoryObject. Resolving the same memory object again returns the same handle. */
+	RMAPMemoryObjectHandle resolveMemoryObject(RMAPTargetNodeHandle targetNodeHandle, std::string memoryObjectID)
+			throw (RMAPTargetNodeDBException) {
+		RMAPTargetNode* rmapTargetNode = getRMAPTargetNode(targetNodeHandle);
+		std::pair<uint32_t, std::string> key(targetNodeHandle.index, memoryObjectID);
+		std::map<std::pair<uint32_t, std::string>, uint32_t>::iterator it = memoryObjectHandles.find(key);
+		if (it != memoryObjectHandles.end()) {
+			return RMAPMemoryObjectHandle(it->second);
+		}
+		RMAPMemoryObject* memoryObject = rmapTargetNode->findMemoryObject(memoryObjectID);
+		if (memoryObject == NULL) {
+			throw RMAPTargetNodeDBException(RMAPTargetNodeDBException::NoSuchRMAPMemoryObject);
+		}
+		MemoryObjectEntry entry;
+		entry.targetNodeIndex = targetNodeHandle.index;
+		entry.memoryObjectID = memoryObjectID;
+		entry.memoryObject = memoryObject;
+		uint32_t index = memoryObjectEntries.size();
+		memoryObjectEntries.push_back(entry);
+		memoryObjectHandles[key] = index;
+		return RMAPMemoryObjectHandle(index);
+	}
+
+public:
+	RMAPMemoryObjectHandle resolveMemoryObject(std::string targetNodeID, std::string memoryObjectID)
+			throw (RMAPTargetNodeDBException) {
+		return resolveMemoryObject(resolveRMAPTargetNode(targetNodeID), memoryObjectID);
+	}
+
+public:
+	RMAPTargetNode* getRMAPTargetNode(RMAPTargetNodeHandle handle) throw (RMAPTargetNodeDBException) {
+		if (targetNodesByHandle.size() <= handle.index) {
+			throw RMAPTargetNodeDBException(RMAPTargetNodeDBException::InvalidHandle);
+		}
+		return targetNodesByHandle[handle.index];
+	}
+
+public:
+	/** Returns the RMAPTargetNode which has the memory object. */
+	RMAPTargetNode* getRMAPTargetNode(RMAPMemoryObjectHandle handle) throw (RMAPTargetNodeDBException) {
+		if (memoryObjectEntries.size() <= handle.index) {
+			throw RMAPTargetNodeDBException(RMAPTargetNodeDBException::InvalidHandle);
+		}
+		return targetNodesByHandle[memoryObjectEntries[handle.index].targetNodeIndex];
+	}
+
+public:
+	RMAPMemoryObject* getMemoryObject(RMAPMemoryObjectHandle handle) throw (RMAPTargetNodeDBException) {
+		if (memoryObjectEntries.size() <= handle.index) {
+			throw RMAPTargetNodeDBException(RMAPTargetNodeDBException::InvalidHandle);
+		}
+		RMAPMemoryObject* memoryObject = memoryObjectEntries[handle.index].memoryObject;
+		if (memoryObject == NULL) {
+			//the node has been replaced by one without this memory object
+			throw RMAPTargetNodeDBException(RMAPTargetNodeDBException::NoSuchRMAPMemoryObject);
 		}
-		return NULL;
+		return memoryObject;
 	}
 
 public:
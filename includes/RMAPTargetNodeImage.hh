@@ -0,0 +1,450 @@
+/* 
+============================================================================
+SpaceWire/RMAP Library is provided under the MIT License.
+============================================================================
+
+Copyright (c) 2006-2013 Takayuki Yuasa and The Open-source SpaceWire Project
+
+Permission is hereby granted, free of charge, to any person obtaining a 
+copy of this software and associated documentation files (the 
+"Software"), to deal in the Software without restriction, including 
+without limitation the rights to use, copy, modify, merge, publish, 
+distribute, sublicense, and/or sell copies of the Software, and to 
+permit persons to whom the Software is furnished to do so, subject to 
+the following conditions:
+
+The above copyright notice and this permission notice shall be included 
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. 
+*/
+/*
+ * RMAPTargetNodeImage.hh
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef RMAPTARGETNODEIMAGE_HH_
+#define RMAPTARGETNODEIMAGE_HH_
+
+#include "RMAPTargetNode.hh"
+
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+class RMAPTargetNodeImageException: public CxxUtilities::Exception {
+public:
+	enum {
+		FileCouldNotBeOpened, //
+		FileCouldNotBeWritten, //
+		InvalidImage
+	};
+
+public:
+	RMAPTargetNodeImageException(int status) :
+			CxxUtilities::Exception(status) {
+	}
+
+	virtual ~RMAPTargetNodeImageException() {
+	}
+
+public:
+	std::string toString() {
+		std::string result;
+		switch (status) {
+		case FileCouldNotBeOpened:
+			result = "FileCouldNotBeOpened";
+			break;
+		case FileCouldNotBeWritten:
+			result = "FileCouldNotBeWritten";
+			break;
+		case InvalidImage:
+			result = "InvalidImage";
+			break;
+		default:
+			result = "Undefined status";
+			break;
+		}
+		return result;
+	}
+};
+
+/** Precompiled binary image of RMAPTargetNode definitions.
+ * An image is generated from an XML file (see main_RMAP_compileRMAPTargetNodeDB), and is loaded by
+ * mapping the file and copying fixed-size records into RMAPTargetNode/RMAPMemoryObject instances,
+ * without XML parsing. The image records the size and a hash of its source XML file, so that
+ * a stale image can be detected (see constructFromFile()).
+ *
+ * Layout (host byte order): Header, TargetNodeRecord[nTargetNodes], MemoryObjectRecord[nMemoryObjects],
+ * and a byte pool which holds IDs and SpaceWire addresses.
+ */
+class RMAPTargetNodeImage {
+public:
+	static const uint32_t FormatVersion = 1;
+	static const uint32_t ByteOrderMark = 0x01020304;
+
+private:
+	struct Header {
+		char magic[8];
+		uint32_t formatVersion;
+		uint32_t byteOrderMark;
+		uint64_t sourceFileSize;
+		uint64_t sourceFileHash;
+		uint32_t nTargetNodes;
+		uint32_t nMemoryObjects;
+		uint64_t bytePoolSize;
+	};
+
+	struct TargetNodeRecord {
+		uint32_t idOffset;
+		uint32_t idLength;
+		uint32_t targetSpaceWireAddressOffset;
+		uint32_t targetSpaceWireAddressLength;
+		uint32_t replyAddressOffset;
+		uint32_t replyAddressLength;
+		uint32_t maximumDataLengthPerTransaction;
+		uint32_t linkIndex;
+		uint32_t firstMemoryObject;
+		uint32_t nMemoryObjects;
+		uint8_t targetLogicalAddress;
+		uint8_t initiatorLogicalAddress;
+		uint8_t defaultKey;
+		uint8_t isInitiatorLogicalAddressSet;
+	};
+
+	struct MemoryObjectRecord {
+		uint32_t idOffset;
+		uint32_t idLength;
+		uint32_t extendedAddress;
+		uint32_t address;
+		uint32_t length;
+		uint32_t accessMode;
+		uint32_t increment;
+		uint8_t key;
+		uint8_t isAccessModeSet;
+		uint8_t isIncrementModeSet;
+		uint8_t isKeySet;
+	};
+
+private:
+	static const char* getMagic() {
+		return "RMAPTNDB";
+	}
+
+public:
+	/** Writes an image of target nodes.
+	 * @param[in] sourceFilename the XML file from which rmapTargetNodes were constructed
+	 * (used to detect a stale image; can be empty)
+	 */
+	static void write(std::string imageFilename, const std::vector<RMAPTargetNode*>& rmapTargetNodes,
+			std::string sourceFilename = "") throw (RMAPTargetNodeImageException) {
+		std::vector<TargetNodeRecord> targetNodeRecords;
+		std::vector<MemoryObjectRecord> memoryObjectRecords;
+		std::vector<uint8_t> bytePool;
+		for (size_t i = 0; i < rmapTargetNodes.size(); i++) {
+			RMAPTargetNode* rmapTargetNode = rmapTargetNodes[i];
+			if (rmapTargetNode == NULL) {
+				continue;
+			}
+			TargetNodeRecord record;
+			memset(&record, 0, sizeof(record));
+			std::string id = rmapTargetNode->getID();
+			std::vector<uint8_t> targetSpaceWireAddress = rmapTargetNode->getTargetSpaceWireAddress();
+			std::vector<uint8_t> replyAddress = rmapTargetNode->getReplyAddress();
+			addToBytePool(bytePool, (const uint8_t*) id.data(), id.size(), record.idOffset, record.idLength);
+			addToBytePool(bytePool, targetSpaceWireAddress.data(), targetSpaceWireAddress.size(),
+					record.targetSpaceWireAddressOffset, record.targetSpaceWireAddressLength);
+			addToBytePool(bytePool, replyAddress.data(), replyAddress.size(), record.replyAddressOffset,
+					record.replyAddressLength);
+			record.maximumDataLengthPerTransaction = rmapTargetNode->getMaximumDataLengthPerTransaction();
+			record.linkIndex = rmapTargetNode->getLinkIndex();
+			record.targetLogicalAddress = rmapTargetNode->getTargetLogicalAddress();
+			record.initiatorLogicalAddress = rmapTargetNode->getInitiatorLogicalAddress();
+			record.defaultKey = rmapTargetNode->getDefaultKey();
+			record.isInitiatorLogicalAddressSet = rmapTargetNode->isInitiatorLogicalAddressSet() ? 1 : 0;
+			record.firstMemoryObject = memoryObjectRecords.size();
+			std::map<std::string, RMAPMemoryObject*>* memoryObjects = rmapTargetNode->getMemoryObjects();
+			std::map<std::string, RMAPMemoryObject*>::iterator it = memoryObjects->begin();
+			for (; it != memoryObjects->end(); it++) {
+				RMAPMemoryObject* memoryObject = it->second;
+				MemoryObjectRecord memoryObjectRecord;
+				memset(&memoryObjectRecord, 0, sizeof(memoryObjectRecord));
+				std::string memoryObjectID = memoryObject->getID();
+				addToBytePool(bytePool, (const uint8_t*) memoryObjectID.data(), memoryObjectID.size(),
+						memoryObjectRecord.idOffset, memoryObjectRecord.idLength);
+				memoryObjectRecord.extendedAddress = memoryObject->getExtendedAddress();
+				memoryObjectRecord.address = memoryObject->getAddress();
+				memoryObjectRecord.length = memoryObject->getLength();
+				memoryObjectRecord.accessMode = memoryObject->getAccessMode();
+				memoryObjectRecord.increment = memoryObject->getIncrementMode();
+				memoryObjectRecord.key = memoryObject->getKey();
+				memoryObjectRecord.isAccessModeSet = memoryObject->isAccessModeSet() ? 1 : 0;
+				memoryObjectRecord.isIncrementModeSet = memoryObject->isIncrementModeSet() ? 1 : 0;
+				memoryObjectRecord.isKeySet = memoryObject->isKeySet() ? 1 : 0;
+				memoryObjectRecords.push_back(memoryObjectRecord);
+			}
+			record.nMemoryObjects = memoryObjectRecords.size() - record.firstMemoryObject;
+			targetNodeRecords.push_back(record);
+		}
+
+		Header header;
+		memset(&header, 0, sizeof(header));
+		memcpy(header.magic, getMagic(), sizeof(header.magic));
+		header.formatVersion = FormatVersion;
+		header.byteOrderMark = ByteOrderMark;
+		if (sourceFilename != "") {
+			getFileSizeAndHash(sourceFilename, header.sourceFileSize, header.sourceFileHash);
+		}
+		header.nTargetNodes = targetNodeRecords.size();
+		header.nMemoryObjects = memoryObjectRecords.size();
+		header.bytePoolSize = bytePool.size();
+
+		//written to a temporary file first so that a reader never maps a partially written image
+		std::string temporaryFilename = imageFilename + ".tmp";
+		std::ofstream ofs(temporaryFilename.c_str(), std::ios::binary | std::ios::trunc);
+		if (!ofs.is_open()) {
+			throw RMAPTargetNodeImageException(RMAPTargetNodeImageException::FileCouldNotBeOpened);
+		}
+		ofs.write((const char*) &header, sizeof(header));
+		if (!targetNodeRecords.empty()) {
+			ofs.write((const char*) &targetNodeRecords[0], targetNodeRecords.size() * sizeof(TargetNodeRecord));
+		}
+		if (!memoryObjectRecords.empty()) {
+			ofs.write((const char*) &memoryObjectRecords[0], memoryObjectRecords.size() * sizeof(MemoryObjectRecord));
+		}
+		if (!bytePool.empty()) {
+			ofs.write((const char*) &bytePool[0], bytePool.size());
+		}
+		ofs.close();
+		if (ofs.fail() || rename(temporaryFilename.c_str(), imageFilename.c_str()) != 0) {
+			unlink(temporaryFilename.c_str());
+			throw RMAPTargetNodeImageException(RMAPTargetNodeImageException::FileCouldNotBeWritten);
+		}
+	}
+
+public:
+	/** Constructs target nodes from an image. Deletion of returned instances should be done by a user. */
+	static std::vector<RMAPTargetNode*> read(std::string imageFilename) throw (RMAPTargetNodeImageException) {
+		int fileDescriptor = ::open(imageFilename.c_str(), O_RDONLY);
+		if (fileDescriptor < 0) {
+			throw RMAPTargetNodeImageException(RMAPTargetNodeImageException::FileCouldNotBeOpened);
+		}
+		struct stat fileStatus;
+		if (fstat(fileDescriptor, &fileStatus) != 0 || (size_t) fileStatus.st_size < sizeof(Header)) {
+			::close(fileDescriptor);
+			throw RMAPTargetNodeImageException(RMAPTargetNodeImageException::InvalidImage);
+		}
+		size_t imageSize = fileStatus.st_size;
+		void* mapped = mmap(NULL, imageSize, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+		::close(fileDescriptor);
+		if (mapped == MAP_FAILED) {
+			throw RMAPTargetNodeImageException(RMAPTargetNodeImageException::FileCouldNotBeOpened);
+		}
+		std::vector<RMAPTargetNode*> result;
+		try {
+			result = construct((const uint8_t*) mapped, imageSize);
+		} catch (RMAPTargetNodeImageException& e) {
+			munmap(mapped, imageSize);
+			throw e;
+		}
+		munmap(mapped, imageSize);
+		return result;
+	}
+
+public:
+	/** Returns true if an image exists and was generated from the current content of an XML file. */
+	static bool isUpToDate(std::string imageFilename, std::string sourceFilename) {
+		Header header;
+		std::ifstream ifs(imageFilename.c_str(), std::ios::binary);
+		if (!ifs.is_open() || !ifs.read((char*) &header, sizeof(header)) || !isValidHeader(header)) {
+			return false;
+		}
+		uint64_t sourceFileSize, sourceFileHash;
+		if (!getFileSizeAndHash(sourceFilename, sourceFileSize, sourceFileHash)) {
+			return false;
+		}
+		return header.sourceFileSize == sourceFileSize && header.sourceFileHash == sourceFileHash;
+	}
+
+#ifndef NO_XMLLODER
+public:
+	/** Constructs target nodes from an image if it is up to date, or from the XML file otherwise.
+	 * @param[in] updateImage if true, a stale image is regenerated from the XML file
+	 */
+	static std::vector<RMAPTargetNode*> constructFromFile(std::string xmlFilename, std::string imageFilename,
+			bool updateImage = false) throw (XMLLoader::XMLLoaderException, RMAPTargetNodeException,
+					RMAPMemoryObjectException) {
+		if (isUpToDate(imageFilename, xmlFilename)) {
+			try {
+				return read(imageFilename);
+			} catch (RMAPTargetNodeImageException& e) {
+				//fall back to XML
+			}
+		}
+		std::vector<RMAPTargetNode*> result = RMAPTargetNode::constructFromXMLFile(xmlFilename);
+		if (updateImage) {
+			try {
+				write(imageFilename, result, xmlFilename);
+			} catch (RMAPTargetNodeImageException& e) {
+				//the image is optional
+			}
+		}
+		return result;
+	}
+#endif
+
+private:
+	static void addToBytePool(std::vector<uint8_t>& bytePool, const uint8_t* data, size_t length, uint32_t& offset,
+			uint32_t& recordedLength) {
+		offset = bytePool.size();
+		recordedLength = length;
+		bytePool.insert(bytePool.end(), data, data + length);
+	}
+
+private:
+	static bool isValidHeader(const Header& header) {
+		return memcmp(header.magic, getMagic(), sizeof(header.magic)) == 0 && header.formatVersion == FormatVersion
+				&& header.byteOrderMark == ByteOrderMark;
+	}
+
+private:
+	/** 64-bit FNV-1a hash of a file. */
+	static bool getFileSizeAndHash(std::string filename, uint64_t& size, uint64_t& hash) {
+		std::ifstream ifs(filename.c_str(), std::ios::binary);
+		if (!ifs.is_open()) {
+			return false;
+		}
+		size = 0;
+		hash = 0xcbf29ce484222325ULL;
+		char buffer[65536];
+		while (ifs.read(buffer, sizeof(buffer)) || ifs.gcount() > 0) {
+			size_t n = ifs.gcount();
+			for (size_t i = 0; i < n; i++) {
+				hash = (hash ^ (uint8_t) buffer[i]) * 0x100000001b3ULL;
+			}
+			size += n;
+		}
+		return true;
+	}
+
+private:
+	static std::vector<RMAPTargetNode*> construct(const uint8_t* image, size_t imageSize)
+			throw (RMAPTargetNodeImageException) {
+		Header header;
+		memcpy(&header, image, sizeof(header));
+		if (!isValidHeader(header)) {
+			throw RMAPTargetNodeImageException(RMAPTargetNodeImageException::InvalidImage);
+		}
+		//offsets are computed in 64 bits (record counts are 32 bits, so they cannot wrap), and are compared
+		//against imageSize without adding the untrusted bytePoolSize to them
+		uint64_t targetNodeRecordsOffset = sizeof(Header);
+		uint64_t memoryObjectRecordsOffset = targetNodeRecordsOffset
+				+ (uint64_t) header.nTargetNodes * sizeof(TargetNodeRecord);
+		uint64_t bytePoolOffset = memoryObjectRecordsOffset
+				+ (uint64_t) header.nMemoryObjects * sizeof(MemoryObjectRecord);
+		if (!(bytePoolOffset <= imageSize && header.bytePoolSize == imageSize - bytePoolOffset)) {
+			throw RMAPTargetNodeImageException(RMAPTargetNodeImageException::InvalidImage);
+		}
+		const uint8_t* bytePool = image + bytePoolOffset;
+		std::vector<RMAPTargetNode*> result;
+		result.reserve(header.nTargetNodes);
+		try {
+			for (uint32_t i = 0; i < header.nTargetNodes; i++) {
+				TargetNodeRecord record;
+				memcpy(&record, image + targetNodeRecordsOffset + (uint64_t) i * sizeof(TargetNodeRecord),
+						sizeof(record));
+				if (header.nMemoryObjects < record.firstMemoryObject
+						|| header.nMemoryObjects - record.firstMemoryObject < record.nMemoryObjects) {
+					throw RMAPTargetNodeImageException(RMAPTargetNodeImageException::InvalidImage);
+				}
+				RMAPTargetNode* rmapTargetNode = new RMAPTargetNode();
+				result.push_back(rmapTargetNode);
+				rmapTargetNode->setID(getString(bytePool, header.bytePoolSize, record.idOffset, record.idLength));
+				rmapTargetNode->setTargetSpaceWireAddress(
+						getBytes(bytePool, header.bytePoolSize, record.targetSpaceWireAddressOffset,
+								record.targetSpaceWireAddressLength));
+				rmapTargetNode->setReplyAddress(
+						getBytes(bytePool, header.bytePoolSize, record.replyAddressOffset, record.replyAddressLength));
+				rmapTargetNode->setMaximumDataLengthPerTransaction(record.maximumDataLengthPerTransaction);
+				rmapTargetNode->setLinkIndex(record.linkIndex);
+				rmapTargetNode->setTargetLogicalAddress(record.targetLogicalAddress);
+				rmapTargetNode->setDefaultKey(record.defaultKey);
+				if (record.isInitiatorLogicalAddressSet != 0) {
+					rmapTargetNode->setInitiatorLogicalAddress(record.initiatorLogicalAddress);
+				}
+				for (uint32_t j = 0; j < record.nMemoryObjects; j++) {
+					MemoryObjectRecord memoryObjectRecord;
+					memcpy(&memoryObjectRecord,
+							image + memoryObjectRecordsOffset
+									+ ((uint64_t) record.firstMemoryObject + j) * sizeof(MemoryObjectRecord),
+							sizeof(memoryObjectRecord));
+					std::string memoryObjectID = getString(bytePool, header.bytePoolSize, memoryObjectRecord.idOffset,
+							memoryObjectRecord.idLength);
+					RMAPMemoryObject* memoryObject = new RMAPMemoryObject();
+					memoryObject->setID(memoryObjectID);
+					memoryObject->setExtendedAddress(memoryObjectRecord.extendedAddress);
+					memoryObject->setAddress(memoryObjectRecord.address);
+					memoryObject->setLength(memoryObjectRecord.length);
+					if (memoryObjectRecord.isKeySet != 0) {
+						memoryObject->setKey(memoryObjectRecord.key);
+					}
+					if (memoryObjectRecord.isAccessModeSet != 0) {
+						memoryObject->setAccessMode(memoryObjectRecord.accessMode);
+					}
+					if (memoryObjectRecord.isIncrementModeSet != 0) {
+						memoryObject->setIncrementMode(memoryObjectRecord.increment);
+					}
+					rmapTargetNode->addMemoryObject(memoryObject);
+				}
+			}
+		} catch (RMAPTargetNodeImageException& e) {
+			for (size_t i = 0; i < result.size(); i++) {
+				deleteTargetNode(result[i]);
+			}
+			throw e;
+		}
+		return result;
+	}
+
+private:
+	static std::string getString(const uint8_t* bytePool, uint64_t bytePoolSize, uint32_t offset, uint32_t length)
+			throw (RMAPTargetNodeImageException) {
+		if (bytePoolSize < (uint64_t) offset + length) {
+			throw RMAPTargetNodeImageException(RMAPTargetNodeImageException::InvalidImage);
+		}
+		return std::string((const char*) bytePool + offset, length);
+	}
+
+private:
+	static std::vector<uint8_t> getBytes(const uint8_t* bytePool, uint64_t bytePoolSize, uint32_t offset,
+			uint32_t length) throw (RMAPTargetNodeImageException) {
+		if (bytePoolSize < (uint64_t) offset + length) {
+			throw RMAPTargetNodeImageException(RMAPTargetNodeImageException::InvalidImage);
+		}
+		return std::vector<uint8_t>(bytePool + offset, bytePool + offset + length);
+	}
+
+private:
+	static void deleteTargetNode(RMAPTargetNode* rmapTargetNode) {
+		std::map<std::string, RMAPMemoryObject*>* memoryObjects = rmapTargetNode->getMemoryObjects();
+		std::map<std::string, RMAPMemoryObject*>::iterator it = memoryObjects->begin();
+		for (; it != memoryObjects->end(); it++) {
+			delete it->second;
+		}
+		delete rmapTargetNode;
+	}
+};
+
+#endif /* RMAPTARGETNODEIMAGE_HH_ */
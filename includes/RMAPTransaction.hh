@@ -35,10 +35,25 @@
 #define RMAPTRANSACTION_HH_
 
 #include "CxxUtilities/CxxUtilities.hh"
+#include "RMAPObjectPool.hh"
 #include "RMAPPacket.hh"
 
 #include <mutex>
 
+class RMAPTransaction;
+
+/** An action invoked by RMAPEngine when a reply packet is received for a transaction.
+ * doAction() is invoked in the receive thread of RMAPEngine, and therefore should return quickly.
+ */
+class RMAPTransactionCompletionAction {
+public:
+	virtual ~RMAPTransactionCompletionAction() {
+	}
+
+public:
+	virtual void doAction(RMAPTransaction* transaction) = 0;
+};
+
 class RMAPTransaction {
 public:
 	static constexpr double DefaultTimeoutDuration = 1000.0;
@@ -47,6 +62,10 @@ public:
 	uint8_t initiatorLogicalAddress{};
 	uint16_t transactionID{};
 	uint32_t transactionIDMode = AutoTransactionID;
+	//RMAPEngine sends packets of a higher priority class first (see RMAPEngine::setPriorityClassWeight())
+	uint32_t priorityClass = NormalPriorityClass;
+	//RMAPEngine link via which the command is sent (see RMAPEngine::addSpaceWireIF())
+	size_t linkIndex = 0;
 	CxxUtilities::Condition condition;
 	double timeoutDuration  = DefaultTimeoutDuration;
 	uint32_t state{};
@@ -54,11 +73,28 @@ public:
 	bool isNonblockingMode = false;
 	RMAPPacket* commandPacket{};
 	RMAPPacket* replyPacket{};
+	//if set, invoked instead of signaling condition when a reply is received or the transaction times out
+	RMAPTransactionCompletionAction* completionAction{};
+	//set by RMAPEngine for a received command; reply packets are drawn from and returned to this pool
+	RMAPObjectPool<RMAPPacket>* packetPool{};
+	//used by RMAPTransactionTimerWheel of RMAPEngine while the transaction is waiting for a reply
+	RMAPTransaction* timerWheelPrevious{};
+	RMAPTransaction* timerWheelNext{};
+	RMAPTransaction** timerWheelSlot{};
+	uint64_t timerWheelExpiryTick{};
 
 	enum {
 		AutoTransactionID = 0x00, ManualTransactionID = 0x01
 	};
 
+	/** Priority classes of outgoing packets. A smaller value has a higher priority.
+	 * e.g. housekeeping polls can use HighPriorityClass so that they do not wait behind bulk transfers.
+	 */
+	enum {
+		HighPriorityClass = 0, NormalPriorityClass = 1, BulkPriorityClass = 2
+	};
+	static const size_t NumberOfPriorityClasses = 3;
+
 	enum {
 		//for RMAPInitiator-related transaction
 		NotInitiated = 0x00,
@@ -163,6 +199,14 @@ public:
 	void setTransactionIDMode(uint32_t transactionIDMode) {
 		this->transactionIDMode = transactionIDMode;
 	}
+
+	uint32_t getPriorityClass() const {
+		return priorityClass;
+	}
+
+	void setPriorityClass(uint32_t priorityClass) {
+		this->priorityClass = (priorityClass < NumberOfPriorityClasses) ? priorityClass : (uint32_t) BulkPriorityClass;
+	}
 };
 
 #endif /* RMAPTRANSACTION_HH_ */
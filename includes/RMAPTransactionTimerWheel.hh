@@ -0,0 +1,220 @@
+/* 
+============================================================================
+SpaceWire/RMAP Library is provided under the MIT License.
+============================================================================
+
+Copyright (c) 2006-2013 Takayuki Yuasa and The Open-source SpaceWire Project
+
+Permission is hereby granted, free of charge, to any person obtaining a 
+copy of this software and associated documentation files (the 
+"Software"), to deal in the Software without restriction, including 
+without limitation the rights to use, copy, modify, merge, publish, 
+distribute, sublicense, and/or sell copies of the Software, and to 
+permit persons to whom the Software is furnished to do so, subject to 
+the following conditions:
+
+The above copyright notice and this permission notice shall be included 
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. 
+*/
+/*
+ * RMAPTransactionTimerWheel.hh
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef RMAPTRANSACTIONTIMERWHEEL_HH_
+#define RMAPTRANSACTIONTIMERWHEEL_HH_
+
+#include "RMAPTransaction.hh"
+
+#include <algorithm>
+#include <vector>
+
+/** A hierarchical timer wheel which tracks deadlines of outstanding RMAPTransaction instances.
+ * Time is counted in ticks (RMAPEngine uses 1 tick = 1 ms). Level 0 has one slot per tick, and
+ * each upper level covers SlotsPerLevel times longer period per slot; entries of an upper-level slot
+ * are cascaded down when the lower level wraps around. Transactions are linked into slots via
+ * intrusive pointers in RMAPTransaction, so that add() and remove() are O(1) and no memory
+ * is allocated per transaction.
+ * This class is not thread safe; RMAPEngine serializes accesses with its own mutex.
+ */
+class RMAPTransactionTimerWheel {
+public:
+	static const size_t NumberOfLevels = 4;
+	static const size_t SlotBits = 6;
+	static const size_t SlotsPerLevel = 1 << SlotBits;
+	/** Deadlines farther than this are clamped (about 4.6 hours when 1 tick = 1 ms). */
+	static const uint64_t MaximumDelay = (uint64_t(1) << (SlotBits * NumberOfLevels)) - 1;
+
+private:
+	RMAPTransaction* slots[NumberOfLevels][SlotsPerLevel];
+	//next tick to be processed by advance()
+	uint64_t nextTick;
+	size_t nScheduledTransactions;
+
+public:
+	RMAPTransactionTimerWheel(uint64_t currentTick = 0) {
+		for (size_t level = 0; level < NumberOfLevels; level++) {
+			for (size_t i = 0; i < SlotsPerLevel; i++) {
+				slots[level][i] = NULL;
+			}
+		}
+		nextTick = currentTick;
+		nScheduledTransactions = 0;
+	}
+
+public:
+	/** Schedules a transaction to expire at expiryTick.
+	 * A transaction which has already been scheduled is rescheduled.
+	 */
+	void add(RMAPTransaction* transaction, uint64_t expiryTick) {
+		if (isScheduled(transaction)) {
+			remove(transaction);
+		}
+		if (expiryTick < nextTick) {
+			expiryTick = nextTick;
+		} else if (expiryTick - nextTick > MaximumDelay) {
+			expiryTick = nextTick + MaximumDelay;
+		}
+		transaction->timerWheelExpiryTick = expiryTick;
+		link(transaction);
+		nScheduledTransactions++;
+	}
+
+public:
+	/** Unschedules a transaction. Does nothing if the transaction is not scheduled. */
+	void remove(RMAPTransaction* transaction) {
+		if (!isScheduled(transaction)) {
+			return;
+		}
+		unlink(transaction);
+		nScheduledTransactions--;
+	}
+
+public:
+	bool isScheduled(RMAPTransaction* transaction) const {
+		return transaction->timerWheelSlot != NULL;
+	}
+
+public:
+	/** Processes ticks up to currentTick, and appends expired transactions to expiredTransactions.
+	 * Expired transactions are unscheduled.
+	 */
+	void advance(uint64_t currentTick, std::vector<RMAPTransaction*>& expiredTransactions) {
+		while (nextTick <= currentTick) {
+			if (nScheduledTransactions == 0) {
+				nextTick = currentTick + 1;
+				return;
+			}
+			size_t index = nextTick & (SlotsPerLevel - 1);
+			//cascade upper levels when level 0 wraps around
+			for (size_t level = 1; level < NumberOfLevels && index == 0; level++) {
+				index = (nextTick >> (SlotBits * level)) & (SlotsPerLevel - 1);
+				cascade(level, index);
+			}
+			RMAPTransaction** slot = &(slots[0][nextTick & (SlotsPerLevel - 1)]);
+			while (*slot != NULL) {
+				RMAPTransaction* transaction = *slot;
+				unlink(transaction);
+				nScheduledTransactions--;
+				expiredTransactions.push_back(transaction);
+			}
+			nextTick++;
+		}
+	}
+
+public:
+	/** Returns the earliest tick at which advance() may expire a transaction, that is, the earliest
+	 * deadline in level 0, or the next tick at which upper levels are cascaded if it comes first.
+	 * Valid only when not empty().
+	 */
+	uint64_t getNextExpiryTick() const {
+		uint64_t cascadeTick = (nextTick + SlotsPerLevel - 1) & ~(uint64_t) (SlotsPerLevel - 1);
+		for (uint64_t tick = nextTick; tick < nextTick + SlotsPerLevel; tick++) {
+			if (slots[0][tick & (SlotsPerLevel - 1)] != NULL) {
+				return std::min(tick, cascadeTick);
+			}
+		}
+		return cascadeTick;
+	}
+
+public:
+	/** Unschedules all transactions, and appends them to removedTransactions. */
+	void clear(std::vector<RMAPTransaction*>& removedTransactions) {
+		for (size_t level = 0; level < NumberOfLevels; level++) {
+			for (size_t i = 0; i < SlotsPerLevel; i++) {
+				while (slots[level][i] != NULL) {
+					RMAPTransaction* transaction = slots[level][i];
+					unlink(transaction);
+					removedTransactions.push_back(transaction);
+				}
+			}
+		}
+		nScheduledTransactions = 0;
+	}
+
+public:
+	size_t size() const {
+		return nScheduledTransactions;
+	}
+
+public:
+	bool empty() const {
+		return nScheduledTransactions == 0;
+	}
+
+private:
+	/** Moves entries of an upper-level slot to lower levels. */
+	void cascade(size_t level, size_t index) {
+		RMAPTransaction* transaction = slots[level][index];
+		slots[level][index] = NULL;
+		while (transaction != NULL) {
+			RMAPTransaction* next = transaction->timerWheelNext;
+			link(transaction);
+			transaction = next;
+		}
+	}
+
+private:
+	void link(RMAPTransaction* transaction) {
+		uint64_t expiryTick = transaction->timerWheelExpiryTick;
+		uint64_t delay = (expiryTick > nextTick) ? expiryTick - nextTick : 0;
+		size_t level = 0;
+		while (level < NumberOfLevels - 1 && delay >= (uint64_t(1) << (SlotBits * (level + 1)))) {
+			level++;
+		}
+		RMAPTransaction** slot = &(slots[level][(expiryTick >> (SlotBits * level)) & (SlotsPerLevel - 1)]);
+		transaction->timerWheelSlot = slot;
+		transaction->timerWheelPrevious = NULL;
+		transaction->timerWheelNext = *slot;
+		if (*slot != NULL) {
+			(*slot)->timerWheelPrevious = transaction;
+		}
+		*slot = transaction;
+	}
+
+private:
+	void unlink(RMAPTransaction* transaction) {
+		if (transaction->timerWheelPrevious != NULL) {
+			transaction->timerWheelPrevious->timerWheelNext = transaction->timerWheelNext;
+		} else {
+			*(transaction->timerWheelSlot) = transaction->timerWheelNext;
+		}
+		if (transaction->timerWheelNext != NULL) {
+			transaction->timerWheelNext->timerWheelPrevious = transaction->timerWheelPrevious;
+		}
+		transaction->timerWheelPrevious = NULL;
+		transaction->timerWheelNext = NULL;
+		transaction->timerWheelSlot = NULL;
+	}
+};
+
+#endif /* RMAPTRANSACTIONTIMERWHEEL_HH_ */
@@ -37,38 +37,9 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "CxxUtilities/CommonHeader.hh"
 
 class RMAPUtilities {
-public:
-	/** Calculates a CRC code for an array of bytes.
-	 */
-	static uint8_t calculateCRC(std::vector<uint8_t>& data) {
-		static const uint8_t RMAPCRCTable[] = { 0x00, 0x91, 0xe3, 0x72, 0x07, 0x96, 0xe4, 0x75, 0x0e, 0x9f, 0xed, 0x7c,
-				0x09, 0x98, 0xea, 0x7b, 0x1c, 0x8d, 0xff, 0x6e, 0x1b, 0x8a, 0xf8, 0x69, 0x12, 0x83, 0xf1, 0x60, 0x15,
-				0x84, 0xf6, 0x67, 0x38, 0xa9, 0xdb, 0x4a, 0x3f, 0xae, 0xdc, 0x4d, 0x36, 0xa7, 0xd5, 0x44, 0x31, 0xa0,
-				0xd2, 0x43, 0x24, 0xb5, 0xc7, 0x56, 0x23, 0xb2, 0xc0, 0x51, 0x2a, 0xbb, 0xc9, 0x58, 0x2d, 0xbc, 0xce,
-				0x5f, 0x70, 0xe1, 0x93, 0x02, 0x77, 0xe6, 0x94, 0x05, 0x7e, 0xef, 0x9d, 0x0c, 0x79, 0xe8, 0x9a, 0x0b,
-				0x6c, 0xfd, 0x8f, 0x1e, 0x6b, 0xfa, 0x88, 0x19, 0x62, 0xf3, 0x81, 0x10, 0x65, 0xf4, 0x86, 0x17, 0x48,
-				0xd9, 0xab, 0x3a, 0x4f, 0xde, 0xac, 0x3d, 0x46, 0xd7, 0xa5, 0x34, 0x41, 0xd0, 0xa2, 0x33, 0x54, 0xc5,
-				0xb7, 0x26, 0x53, 0xc2, 0xb0, 0x21, 0x5a, 0xcb, 0xb9, 0x28, 0x5d, 0xcc, 0xbe, 0x2f, 0xe0, 0x71, 0x03,
-				0x92, 0xe7, 0x76, 0x04, 0x95, 0xee, 0x7f, 0x0d, 0x9c, 0xe9, 0x78, 0x0a, 0x9b, 0xfc, 0x6d, 0x1f, 0x8e,
-				0xfb, 0x6a, 0x18, 0x89, 0xf2, 0x63, 0x11, 0x80, 0xf5, 0x64, 0x16, 0x87, 0xd8, 0x49, 0x3b, 0xaa, 0xdf,
-				0x4e, 0x3c, 0xad, 0xd6, 0x47, 0x35, 0xa4, 0xd1, 0x40, 0x32, 0xa3, 0xc4, 0x55, 0x27, 0xb6, 0xc3, 0x52,
-				0x20, 0xb1, 0xca, 0x5b, 0x29, 0xb8, 0xcd, 0x5c, 0x2e, 0xbf, 0x90, 0x01, 0x73, 0xe2, 0x97, 0x06, 0x74,
-				0xe5, 0x9e, 0x0f, 0x7d, 0xec, 0x99, 0x08, 0x7a, 0xeb, 0x8c, 0x1d, 0x6f, 0xfe, 0x8b, 0x1a, 0x68, 0xf9,
-				0x82, 0x13, 0x61, 0xf0, 0x85, 0x14, 0x66, 0xf7, 0xa8, 0x39, 0x4b, 0xda, 0xaf, 0x3e, 0x4c, 0xdd, 0xa6,
-				0x37, 0x45, 0xd4, 0xa1, 0x30, 0x42, 0xd3, 0xb4, 0x25, 0x57, 0xc6, 0xb3, 0x22, 0x50, 0xc1, 0xba, 0x2b,
-				0x59, 0xc8, 0xbd, 0x2c, 0x5e, 0xcf };
-
-		uint8_t crc = 0x00;
-		size_t length=data.size();
-		for (size_t i = 0; i < length; i++) {
-			crc = RMAPCRCTable[(crc ^ data[i]) & 0xff];
-		}
-		return crc;
-	}
-
-	/** Calculates a CRC code for an array of bytes.
-	 */
-	static uint8_t calculateCRC(uint8_t* data, size_t length) {
+private:
+	/** Returns the 256-entry CRC table defined in the RMAP Standard (ECSS-E-ST-50-52C). */
+	static const uint8_t* getCRCTable() {
 		static const uint8_t RMAPCRCTable[] = { 0x00, 0x91, 0xe3, 0x72, 0x07, 0x96, 0xe4, 0x75, 0x0e, 0x9f, 0xed, 0x7c,
 				0x09, 0x98, 0xea, 0x7b, 0x1c, 0x8d, 0xff, 0x6e, 0x1b, 0x8a, 0xf8, 0x69, 0x12, 0x83, 0xf1, 0x60, 0x15,
 				0x84, 0xf6, 0x67, 0x38, 0xa9, 0xdb, 0x4a, 0x3f, 0xae, 0xdc, 0x4d, 0x36, 0xa7, 0xd5, 0x44, 0x31, 0xa0,
@@ -85,17 +56,12 @@ public:
 				0x82, 0x13, 0x61, 0xf0, 0x85, 0x14, 0x66, 0xf7, 0xa8, 0x39, 0x4b, 0xda, 0xaf, 0x3e, 0x4c, 0xdd, 0xa6,
 				0x37, 0x45, 0xd4, 0xa1, 0x30, 0x42, 0xd3, 0xb4, 0x25, 0x57, 0xc6, 0xb3, 0x22, 0x50, 0xc1, 0xba, 0x2b,
 				0x59, 0xc8, 0xbd, 0x2c, 0x5e, 0xcf };
-
-		uint8_t crc = 0x00;
-		for (size_t i = 0; i < length; i++) {
-			crc = RMAPCRCTable[(crc ^ data[i]) & 0xff];
-		}
-		return crc;
+		return RMAPCRCTable;
 	}
 
-	/** Calculates a CRC code for an array of bytes using an algorithm defined in an old RMAP Standard (Draft E).
-	 */
-	static uint8_t calculateCRCBasedOnDraftESpecification(std::vector<uint8_t>& data){
+private:
+	/** Returns the 256-entry CRC table defined in an old RMAP Standard (Draft E). */
+	static const uint8_t* getDraftECRCTable() {
 		// CRC Table from RMAP spec draft E
 		static const uint8_t RMAP_CRCTable_DraftE[] = { 0x00, 0x07, 0x0e, 0x09, 0x1c, 0x1b,
 				0x12, 0x15, 0x38, 0x3f, 0x36, 0x31, 0x24, 0x23, 0x2a, 0x2d, 0x70, 0x77,
@@ -119,47 +85,116 @@ public:
 				0x14, 0x13, 0xae, 0xa9, 0xa0, 0xa7, 0xb2, 0xb5, 0xbc, 0xbb, 0x96, 0x91,
 				0x98, 0x9f, 0x8a, 0x8d, 0x84, 0x83, 0xde, 0xd9, 0xd0, 0xd7, 0xc2, 0xc5,
 				0xcc, 0xcb, 0xe6, 0xe1, 0xe8, 0xef, 0xfa, 0xfd, 0xf4, 0xf3 };
-		//^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
-		unsigned char crc=0x00;
-		int length=data.size();
-		for (int i=0;i<length;i++){
-			crc=RMAP_CRCTable_DraftE[(crc^(data)[i]) & 0xff];
+		return RMAP_CRCTable_DraftE;
+	}
+
+private:
+	/** Tables for the slice-by-8 algorithm.
+	 * table[k][x] is the CRC register after processing a byte x followed by k zero bytes.
+	 * Since the CRC update is linear, 8 bytes can be folded with 8 independent lookups.
+	 */
+	class SliceBy8CRCTable {
+	public:
+		uint8_t table[8][256];
+
+	public:
+		SliceBy8CRCTable(const uint8_t* crcTable) {
+			for (size_t x = 0; x < 256; x++) {
+				table[0][x] = crcTable[x];
+			}
+			for (size_t k = 1; k < 8; k++) {
+				for (size_t x = 0; x < 256; x++) {
+					table[k][x] = crcTable[table[k - 1][x]];
+				}
+			}
+		}
+	};
+
+private:
+	static const SliceBy8CRCTable& getSliceBy8CRCTable() {
+		static const SliceBy8CRCTable sliceBy8CRCTable(getCRCTable());
+		return sliceBy8CRCTable;
+	}
+
+private:
+	static const SliceBy8CRCTable& getSliceBy8DraftECRCTable() {
+		static const SliceBy8CRCTable sliceBy8CRCTable(getDraftECRCTable());
+		return sliceBy8CRCTable;
+	}
+
+private:
+	static uint8_t calculateCRCByteByByte(const uint8_t* crcTable, const uint8_t* data, size_t length, uint8_t crc) {
+		for (size_t i = 0; i < length; i++) {
+			crc = crcTable[(crc ^ data[i]) & 0xff];
 		}
 		return crc;
 	}
 
+private:
+	static uint8_t calculateCRCSliceBy8(const SliceBy8CRCTable& sliceBy8CRCTable, const uint8_t* data, size_t length) {
+		const uint8_t (*t)[256] = sliceBy8CRCTable.table;
+		uint8_t crc = 0x00;
+		while (length >= 8) {
+			crc = t[7][crc ^ data[0]] ^ t[6][data[1]] ^ t[5][data[2]] ^ t[4][data[3]] //
+			^ t[3][data[4]] ^ t[2][data[5]] ^ t[1][data[6]] ^ t[0][data[7]];
+			data += 8;
+			length -= 8;
+		}
+		return calculateCRCByteByByte(t[0], data, length, crc);
+	}
+
+public:
+	/** Arrays shorter than this length (e.g. RMAP headers) are processed
+	 * byte by byte, and longer ones with the slice-by-8 algorithm.
+	 */
+	static const size_t MinimumLengthForSliceBy8 = 16;
+
+public:
+	/** Calculates a CRC code for an array of bytes.
+	 */
+	static uint8_t calculateCRC(std::vector<uint8_t>& data) {
+		return calculateCRC((data.size() != 0) ? &(data[0]) : NULL, data.size());
+	}
+
+	/** Calculates a CRC code for an array of bytes.
+	 */
+	static uint8_t calculateCRC(uint8_t* data, size_t length) {
+		if (length < MinimumLengthForSliceBy8) {
+			return calculateCRCByteByByte(getCRCTable(), data, length, 0x00);
+		} else {
+			return calculateCRCSliceBy8(getSliceBy8CRCTable(), data, length);
+		}
+	}
+
+	/** Calculates a CRC code for an array of bytes using an algorithm defined in an old RMAP Standard (Draft E).
+	 */
+	static uint8_t calculateCRCBasedOnDraftESpecification(std::vector<uint8_t>& data){
+		return calculateCRCBasedOnDraftESpecification((data.size() != 0) ? &(data[0]) : NULL, data.size());
+	}
+
 	/** Calculates a CRC code for an array of bytes using an algorithm defined in an old RMAP Standard (Draft E).
 	 */
 	static uint8_t calculateCRCBasedOnDraftESpecification(uint8_t* data, size_t length) {
-		// CRC Table from RMAP spec draft E
-		static const uint8_t RMAP_CRCTable_DraftE[] = { 0x00, 0x07, 0x0e, 0x09, 0x1c, 0x1b,
-				0x12, 0x15, 0x38, 0x3f, 0x36, 0x31, 0x24, 0x23, 0x2a, 0x2d, 0x70, 0x77,
-				0x7e, 0x79, 0x6c, 0x6b, 0x62, 0x65, 0x48, 0x4f, 0x46, 0x41, 0x54, 0x53,
-				0x5a, 0x5d, 0xe0, 0xe7, 0xee, 0xe9, 0xfc, 0xfb, 0xf2, 0xf5, 0xd8, 0xdf,
-				0xd6, 0xd1, 0xc4, 0xc3, 0xca, 0xcd, 0x90, 0x97, 0x9e, 0x99, 0x8c, 0x8b,
-				0x82, 0x85, 0xa8, 0xaf, 0xa6, 0xa1, 0xb4, 0xb3, 0xba, 0xbd, 0xc7, 0xc0,
-				0xc9, 0xce, 0xdb, 0xdc, 0xd5, 0xd2, 0xff, 0xf8, 0xf1, 0xf6, 0xe3, 0xe4,
-				0xed, 0xea, 0xb7, 0xb0, 0xb9, 0xbe, 0xab, 0xac, 0xa5, 0xa2, 0x8f, 0x88,
-				0x81, 0x86, 0x93, 0x94, 0x9d, 0x9a, 0x27, 0x20, 0x29, 0x2e, 0x3b, 0x3c,
-				0x35, 0x32, 0x1f, 0x18, 0x11, 0x16, 0x03, 0x04, 0x0d, 0x0a, 0x57, 0x50,
-				0x59, 0x5e, 0x4b, 0x4c, 0x45, 0x42, 0x6f, 0x68, 0x61, 0x66, 0x73, 0x74,
-				0x7d, 0x7a, 0x89, 0x8e, 0x87, 0x80, 0x95, 0x92, 0x9b, 0x9c, 0xb1, 0xb6,
-				0xbf, 0xb8, 0xad, 0xaa, 0xa3, 0xa4, 0xf9, 0xfe, 0xf7, 0xf0, 0xe5, 0xe2,
-				0xeb, 0xec, 0xc1, 0xc6, 0xcf, 0xc8, 0xdd, 0xda, 0xd3, 0xd4, 0x69, 0x6e,
-				0x67, 0x60, 0x75, 0x72, 0x7b, 0x7c, 0x51, 0x56, 0x5f, 0x58, 0x4d, 0x4a,
-				0x43, 0x44, 0x19, 0x1e, 0x17, 0x10, 0x05, 0x02, 0x0b, 0x0c, 0x21, 0x26,
-				0x2f, 0x28, 0x3d, 0x3a, 0x33, 0x34, 0x4e, 0x49, 0x40, 0x47, 0x52, 0x55,
-				0x5c, 0x5b, 0x76, 0x71, 0x78, 0x7f, 0x6a, 0x6d, 0x64, 0x63, 0x3e, 0x39,
-				0x30, 0x37, 0x22, 0x25, 0x2c, 0x2b, 0x06, 0x01, 0x08, 0x0f, 0x1a, 0x1d,
-				0x14, 0x13, 0xae, 0xa9, 0xa0, 0xa7, 0xb2, 0xb5, 0xbc, 0xbb, 0x96, 0x91,
-				0x98, 0x9f, 0x8a, 0x8d, 0x84, 0x83, 0xde, 0xd9, 0xd0, 0xd7, 0xc2, 0xc5,
-				0xcc, 0xcb, 0xe6, 0xe1, 0xe8, 0xef, 0xfa, 0xfd, 0xf4, 0xf3 };
-		//^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^^
-		unsigned char crc=0x00;
-		for (int i=0;i<length;i++){
-			crc=RMAP_CRCTable_DraftE[(crc^data[i]) & 0xff];
+		if (length < MinimumLengthForSliceBy8) {
+			return calculateCRCByteByByte(getDraftECRCTable(), data, length, 0x00);
+		} else {
+			return calculateCRCSliceBy8(getSliceBy8DraftECRCTable(), data, length);
 		}
-		return crc;
+	}
+
+public:
+	/** Calculates a CRC code one byte per table lookup (reference implementation).
+	 * @param[in] useDraftE if true, the Draft E algorithm is used.
+	 */
+	static uint8_t calculateCRCByteByByte(uint8_t* data, size_t length, bool useDraftE = false) {
+		return calculateCRCByteByByte(useDraftE ? getDraftECRCTable() : getCRCTable(), data, length, 0x00);
+	}
+
+	/** Calculates a CRC code with the slice-by-8 algorithm regardless of the length.
+	 * @param[in] useDraftE if true, the Draft E algorithm is used.
+	 */
+	static uint8_t calculateCRCSliceBy8(uint8_t* data, size_t length, bool useDraftE = false) {
+		return calculateCRCSliceBy8(useDraftE ? getSliceBy8DraftECRCTable() : getSliceBy8CRCTable(), data, length);
 	}
 
 };
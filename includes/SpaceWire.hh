@@ -42,7 +42,10 @@ SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
 #include "SpaceWireIFOverTCP.hh"
 #include "SpaceWireIFOverIPClient.hh"
 #include "SpaceWireProtocol.hh"
+#include "SpaceWireReceiveBuffer.hh"
 #include "SpaceWireSSDTPModule.hh"
+#include "SpaceWireSSDTPParser.hh"
+#include "SpaceWireIFOverTCPReactor.hh"
 #include "SpaceWireUtilities.hh"
 
 #if defined(RASPBERRY_PI)
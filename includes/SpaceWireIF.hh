@@ -37,6 +37,7 @@
 #include <CxxUtilities/CommonHeader.hh>
 #include <CxxUtilities/Exception.hh>
 #include "SpaceWireEOPMarker.hh"
+#include "SpaceWireReceiveBuffer.hh"
 
 class SpaceWireIFException: public CxxUtilities::Exception {
 public:
@@ -126,6 +127,11 @@ protected:
 	bool isTerminatedWithEEP_;
 	bool isTerminatedWithEOP_;
 
+private:
+	//reused by the default implementation of receive(uint8_t*, ...)
+	std::vector<uint8_t> arrayReceiveBuffer;
+	std::mutex arrayReceiveBufferMutex;
+
 public:
 	enum OpenCloseState {
 		Closed, Opened
@@ -211,6 +217,20 @@ public:
 		}
 	}
 
+public:
+	/** Sends multiple packets in this order, without other packets being interleaved
+	 * when the subclass supports it natively. This default implementation invokes
+	 * send() for each packet; subclasses can override it to batch system calls.
+	 * @param[in] packets packet contents
+	 * @param[in] eopType End-of-Packet marker applied to all the packets
+	 */
+	virtual void sendMany(std::vector<std::vector<uint8_t>*>& packets, SpaceWireEOPMarker::EOPType eopType =
+			SpaceWireEOPMarker::EOP) throw (SpaceWireIFException) {
+		for (size_t i = 0; i < packets.size(); i++) {
+			send(packets[i], eopType);
+		}
+	}
+
 	/*
 	 public:
 	 void send(SpaceWirePacket* packet) throw (SpaceWireIFException) {
@@ -220,24 +240,92 @@ public:
 	 */
 
 public:
+	/** Receives a packet into a caller-supplied array.
+	 * This default implementation receives into a vector owned by this instance
+	 * (its capacity is reused across calls) and copies the packet to the array.
+	 * Subclasses which can write into the array directly should override this method.
+	 */
 	virtual void receive(uint8_t* buffer, SpaceWireEOPMarker::EOPType& eopType, size_t maxLength, size_t& length)
 			throw (SpaceWireIFException) {
-		std::vector<uint8_t>* packet = this->receive();
-		size_t packetSize = packet->size();
+		std::lock_guard<std::mutex> guard(arrayReceiveBufferMutex);
+		this->receive(&arrayReceiveBuffer);
+		eopType = (getReceivedPacketEOPMarkerType() == EEP) ? SpaceWireEOPMarker::EEP : SpaceWireEOPMarker::EOP;
+		size_t packetSize = arrayReceiveBuffer.size();
+		length = packetSize;
 		if (packetSize == 0) {
-			length = 0;
+			return;
+		}
+		if (packetSize <= maxLength) {
+			memcpy(buffer, &(arrayReceiveBuffer[0]), packetSize);
 		} else {
-			length = packetSize;
-			if (packetSize <= maxLength) {
-				memcpy(buffer, &(packet->at(0)), packetSize);
-			} else {
-				memcpy(buffer, &(packet->at(0)), maxLength);
-				delete packet;
-				throw SpaceWireIFException(SpaceWireIFException::ReceiveBufferTooSmall);
+			memcpy(buffer, &(arrayReceiveBuffer[0]), maxLength);
+			throw SpaceWireIFException(SpaceWireIFException::ReceiveBufferTooSmall);
+		}
+	}
+
+public:
+	/** Receives a packet into a pooled buffer (see SpaceWireReceiveBufferPool).
+	 * The vector of the buffer is resized to the packet size, and the EOP marker
+	 * type is stored in the buffer. This default implementation invokes
+	 * receive(std::vector<uint8_t>*), which reuses the capacity of the vector.
+	 * @param[in] buffer a buffer to be filled
+	 */
+	virtual void receiveInto(SpaceWireReceiveBuffer* buffer) throw (SpaceWireIFException) {
+		this->receive(buffer->getVector());
+		buffer->setEOPType(
+				(getReceivedPacketEOPMarkerType() == EEP) ? SpaceWireEOPMarker::EEP : SpaceWireEOPMarker::EOP);
+	}
+
+public:
+	/** Acquires a buffer from a pool and receives a packet into it.
+	 * The returned buffer has one reference; the caller should release() it
+	 * (or hand it to a consumer which releases it). The buffer is returned to
+	 * the pool if receiving fails.
+	 * @param[in] pool a pool from which a buffer is acquired
+	 * @return a buffer containing the received packet
+	 */
+	SpaceWireReceiveBuffer* receiveIntoPooledBuffer(SpaceWireReceiveBufferPool* pool) throw (SpaceWireIFException) {
+		SpaceWireReceiveBuffer* buffer = pool->acquire();
+		try {
+			this->receiveInto(buffer);
+			return buffer;
+		} catch (SpaceWireIFException& e) {
+			buffer->release();
+			throw e;
+		}
+	}
+
+public:
+	/** Receives up to buffers.size() packets with one call.
+	 * This method waits for the first packet as receive() does, but a timeout is
+	 * reported by returning 0 instead of throwing SpaceWireIFException::Timeout.
+	 * Further packets are returned only if they are available without waiting.
+	 * EOP marker types are stored in the buffers; an EEP is not reported as an exception.
+	 * This default implementation receives one packet with receiveInto();
+	 * subclasses can override it to receive a burst of packets with fewer
+	 * system calls and lock acquisitions.
+	 * @param[in] buffers buffers to be filled (e.g. acquired from a SpaceWireReceiveBufferPool)
+	 * @return the number of filled buffers, counted from buffers[0]
+	 */
+	virtual size_t receiveMany(std::vector<SpaceWireReceiveBuffer*>& buffers) throw (SpaceWireIFException) {
+		if (buffers.size() == 0) {
+			return 0;
+		}
+		try {
+			this->receiveInto(buffers[0]);
+		} catch (SpaceWireIFException& e) {
+			if (e.getStatus() == SpaceWireIFException::Timeout) {
+				return 0;
+			}
+			if (e.getStatus() == SpaceWireIFException::EEP) {
+				buffers[0]->setEOPType(SpaceWireEOPMarker::EEP);
+				return 1;
 			}
+			throw e;
 		}
-		delete packet;
+		return (buffers[0]->getSize() != 0) ? 1 : 0;
 	}
+
 public:
 	virtual std::vector<uint8_t>* receive() throw (SpaceWireIFException) {
 		std::vector<uint8_t>* buffer = new std::vector<uint8_t>();
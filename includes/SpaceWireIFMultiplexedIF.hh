@@ -58,6 +58,11 @@ public:
 		parent->send(data,length,eopType);
 	}
 
+public:
+	void sendMany(std::vector<std::vector<uint8_t>*>& packets, SpaceWireEOPMarker::EOPType eopType = SpaceWireEOPMarker::EOP) throw (SpaceWireIFException) {
+		parent->sendMany(packets,eopType);
+	}
+
 public:
 	void receive(std::vector<uint8_t>* buffer) throw (SpaceWireIFException) {
 		receiveMutex.lock();
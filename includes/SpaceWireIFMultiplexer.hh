@@ -171,6 +171,21 @@ public:
 		sendMutex.unlock();
 	}
 
+	/** Forwards packets to the real SpaceWire IF as one batch, so that packets
+	 * sent by virtual IFs are not interleaved and the real IF can batch system calls.
+	 */
+	void sendMany(std::vector<std::vector<uint8_t>*>& packets, SpaceWireEOPMarker::EOPType eopType =
+			SpaceWireEOPMarker::EOP) throw (SpaceWireIFException) {
+		sendMutex.lock();
+		try {
+			realSpaceWireIF->sendMany(packets, eopType);
+		} catch (SpaceWireIFException& e) {
+			sendMutex.unlock();
+			throw e;
+		}
+		sendMutex.unlock();
+	}
+
 public:
 	void receive(std::vector<uint8_t>* buffer) throw (SpaceWireIFException) {
 		throw SpaceWireIFMultiplexerException(SpaceWireIFMultiplexerException::NotImplemented);
@@ -60,6 +60,12 @@ private:
 
 	uint32_t operationMode;
 
+private:
+	//reused by receiveMany()
+	std::vector<std::vector<uint8_t>*> receiveManyVectors;
+	std::vector<uint32_t> receiveManyEOPTypes;
+	std::mutex receiveManyMutex;
+
 public:
 	/** Constructor (client mode).
 	 */
@@ -186,8 +192,80 @@ public:
 		}
 	}
 
+public:
+	/** Sends multiple packets with (typically) one vectored write. */
+	void sendMany(std::vector<std::vector<uint8_t>*>& packets, SpaceWireEOPMarker::EOPType eopType =
+			SpaceWireEOPMarker::EOP) throw (SpaceWireIFException) {
+		if (ssdtp == NULL) {
+			throw SpaceWireIFException(SpaceWireIFException::LinkIsNotOpened);
+		}
+		try {
+			ssdtp->sendMany(packets, eopType);
+		} catch (SpaceWireSSDTPException& e) {
+			if (e.getStatus() == SpaceWireSSDTPException::Timeout) {
+				throw SpaceWireIFException(SpaceWireIFException::Timeout);
+			} else {
+				throw SpaceWireIFException(SpaceWireIFException::Disconnected);
+			}
+		}
+	}
+
 public:
 	void receive(std::vector<uint8_t>* buffer) throw (SpaceWireIFException) {
+		receiveIntoVector(buffer);
+	}
+
+public:
+	/** Receives a packet into a pooled buffer. The SSDTP module writes
+	 * data fragments straight into the vector of the buffer, and the EOP marker
+	 * type is stored in the buffer without going through getReceivedPacketEOPMarkerType().
+	 */
+	void receiveInto(SpaceWireReceiveBuffer* buffer) throw (SpaceWireIFException) {
+		buffer->setEOPType(receiveIntoVector(buffer->getVector()));
+	}
+
+public:
+	/** Receives a burst of packets. After the first packet, the SSDTP module
+	 * parses further packets out of its read-ahead buffer while holding its
+	 * receive lock once, so that packets which arrived in the same TCP read
+	 * are returned without additional system calls.
+	 */
+	size_t receiveMany(std::vector<SpaceWireReceiveBuffer*>& buffers) throw (SpaceWireIFException) {
+		if (ssdtp == NULL) {
+			throw SpaceWireIFException(SpaceWireIFException::LinkIsNotOpened);
+		}
+		std::lock_guard<std::mutex> guard(receiveManyMutex);
+		receiveManyVectors.resize(buffers.size());
+		for (size_t i = 0; i < buffers.size(); i++) {
+			receiveManyVectors[i] = buffers[i]->getVector();
+		}
+		size_t nReceivedPackets;
+		try {
+			nReceivedPackets = ssdtp->receiveMany(receiveManyVectors, receiveManyEOPTypes);
+		} catch (SpaceWireSSDTPException& e) {
+			if (e.getStatus() == SpaceWireSSDTPException::Timeout) {
+				return 0;
+			}
+			throw SpaceWireIFException(SpaceWireIFException::Disconnected);
+		} catch (CxxUtilities::TCPSocketException& e) {
+			if (e.getStatus() == CxxUtilities::TCPSocketException::Timeout) {
+				return 0;
+			}
+			throw SpaceWireIFException(SpaceWireIFException::Disconnected);
+		}
+		for (size_t i = 0; i < nReceivedPackets; i++) {
+			buffers[i]->setEOPType(
+					(receiveManyEOPTypes[i] == SpaceWireEOPMarker::EEP) ? SpaceWireEOPMarker::EEP : SpaceWireEOPMarker::EOP);
+		}
+		if (nReceivedPackets != 0) {
+			this->setReceivedPacketEOPMarkerType(
+					(buffers[nReceivedPackets - 1]->getEOPType() == SpaceWireEOPMarker::EEP) ? SpaceWireIF::EEP : SpaceWireIF::EOP);
+		}
+		return nReceivedPackets;
+	}
+
+private:
+	SpaceWireEOPMarker::EOPType receiveIntoVector(std::vector<uint8_t>* buffer) throw (SpaceWireIFException) {
 		if (ssdtp == NULL) {
 			throw SpaceWireIFException(SpaceWireIFException::LinkIsNotOpened);
 		}
@@ -199,8 +277,10 @@ public:
 				if (this->eepShouldBeReportedAsAnException_) {
 					throw SpaceWireIFException(SpaceWireIFException::EEP);
 				}
+				return SpaceWireEOPMarker::EEP;
 			} else {
 				this->setReceivedPacketEOPMarkerType(SpaceWireIF::EOP);
+				return SpaceWireEOPMarker::EOP;
 			}
 		} catch (SpaceWireSSDTPException& e) {
 			if (e.getStatus() == SpaceWireSSDTPException::Timeout) {
@@ -217,6 +297,49 @@ public:
 		}
 	}
 
+public:
+	/** Receives a packet directly into a caller-supplied buffer.
+	 * Unlike the default implementation in SpaceWireIF, no temporary
+	 * vector is allocated, and received data are not copied after
+	 * they are read from the socket.
+	 */
+	void receive(uint8_t* buffer, SpaceWireEOPMarker::EOPType& eopType, size_t maxLength, size_t& length)
+			throw (SpaceWireIFException) {
+		if (ssdtp == NULL) {
+			throw SpaceWireIFException(SpaceWireIFException::LinkIsNotOpened);
+		}
+		try {
+			uint32_t receivedEOPType;
+			length = ssdtp->receive(buffer, maxLength, receivedEOPType);
+			if (receivedEOPType == SpaceWireEOPMarker::EEP) {
+				eopType = SpaceWireEOPMarker::EEP;
+				this->setReceivedPacketEOPMarkerType(SpaceWireIF::EEP);
+				if (this->eepShouldBeReportedAsAnException_) {
+					throw SpaceWireIFException(SpaceWireIFException::EEP);
+				}
+			} else {
+				eopType = SpaceWireEOPMarker::EOP;
+				this->setReceivedPacketEOPMarkerType(SpaceWireIF::EOP);
+			}
+		} catch (SpaceWireSSDTPException& e) {
+			if (e.getStatus() == SpaceWireSSDTPException::Timeout) {
+				throw SpaceWireIFException(SpaceWireIFException::Timeout);
+			}
+			if (e.getStatus() == SpaceWireSSDTPException::DataSizeTooLarge) {
+				throw SpaceWireIFException(SpaceWireIFException::ReceiveBufferTooSmall);
+			}
+			throw SpaceWireIFException(SpaceWireIFException::Disconnected);
+		} catch (CxxUtilities::TCPSocketException& e) {
+			if (e.getStatus() == CxxUtilities::TCPSocketException::Timeout) {
+				throw SpaceWireIFException(SpaceWireIFException::Timeout);
+			}
+			throw SpaceWireIFException(SpaceWireIFException::Disconnected);
+		}
+	}
+
+public:
+	using SpaceWireIF::receive;
+
 public:
 	void emitTimecode(uint8_t timeIn, uint8_t controlFlagIn = 0x00) throw (SpaceWireIFException) {
 		using namespace std;
@@ -301,6 +424,11 @@ public:
 		return ssdtp;
 	}
 
+	/** Returns the TCP socket of the link. Valid after open(). */
+	CxxUtilities::TCPSocket* getDataSocket() {
+		return datasocket;
+	}
+
 	uint32_t getOperationMode() const {
 		return operationMode;
 	}
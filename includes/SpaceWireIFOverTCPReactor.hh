@@ -0,0 +1,571 @@
+/* 
+============================================================================
+SpaceWire/RMAP Library is provided under the MIT License.
+============================================================================
+
+Copyright (c) 2006-2013 Takayuki Yuasa and The Open-source SpaceWire Project
+
+Permission is hereby granted, free of charge, to any person obtaining a 
+copy of this software and associated documentation files (the 
+"Software"), to deal in the Software without restriction, including 
+without limitation the rights to use, copy, modify, merge, publish, 
+distribute, sublicense, and/or sell copies of the Software, and to 
+permit persons to whom the Software is furnished to do so, subject to 
+the following conditions:
+
+The above copyright notice and this permission notice shall be included 
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. 
+*/
+/*
+ * SpaceWireIFOverTCPReactor.hh
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef SPACEWIREIFOVERTCPREACTOR_HH_
+#define SPACEWIREIFOVERTCPREACTOR_HH_
+
+#ifdef __linux__
+
+#include "CxxUtilities/CxxUtilities.hh"
+
+#include "SpaceWireIFOverTCP.hh"
+#include "SpaceWireReceiveBuffer.hh"
+#include "SpaceWireSSDTPParser.hh"
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <errno.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+class SpaceWireIFOverTCPReactorException: public CxxUtilities::Exception {
+public:
+	enum {
+		EpollCouldNotBeCreated, LinkIsNotOpened, LinkIsAlreadyAdded
+	};
+
+public:
+	SpaceWireIFOverTCPReactorException(uint32_t status) :
+			CxxUtilities::Exception(status) {
+	}
+
+public:
+	virtual ~SpaceWireIFOverTCPReactorException() {
+	}
+
+public:
+	std::string toString() {
+		std::string result;
+		switch (status) {
+		case EpollCouldNotBeCreated:
+			result = "EpollCouldNotBeCreated";
+			break;
+		case LinkIsNotOpened:
+			result = "LinkIsNotOpened";
+			break;
+		case LinkIsAlreadyAdded:
+			result = "LinkIsAlreadyAdded";
+			break;
+		default:
+			result = "Undefined status";
+			break;
+		}
+		return result;
+	}
+};
+
+/** Per-link handler invoked by SpaceWireIFOverTCPReactor on its I/O thread.
+ * Methods should return quickly (e.g. enqueue the packet to a worker) because
+ * all links served by a reactor share the thread.
+ */
+class SpaceWireIFOverTCPReactorHandler {
+public:
+	virtual ~SpaceWireIFOverTCPReactorHandler() {
+	}
+
+public:
+	/** Invoked for each received packet. The reactor releases the buffer after
+	 * this method returns; call retain() to hand the packet to another thread.
+	 * @param[in] spwif the link which received the packet
+	 * @param[in] buffer a buffer containing the packet and its EOP marker type
+	 */
+	virtual void packetReceived(SpaceWireIFOverTCP* spwif, SpaceWireReceiveBuffer* buffer) = 0;
+
+public:
+	/** Invoked when the peer closed the connection or the SSDTP stream was broken.
+	 * The link has already been removed from the reactor; the handler may close() it.
+	 * @param[in] spwif the disconnected link
+	 */
+	virtual void linkDisconnected(SpaceWireIFOverTCP*) {
+	}
+};
+
+/** An I/O loop which receives packets from many SpaceWireIFOverTCP links with one thread.
+ * Sockets of added links are watched with epoll. When a socket becomes readable,
+ * the reactor reads whatever is available without blocking, feeds the bytes to the
+ * link's SpaceWireSSDTPParser, and passes complete packets to the link's handler.
+ * Thus the number of threads stays constant however many links are added, and
+ * stop() returns immediately instead of waiting for receive timeouts.
+ *
+ * While a link is added, receive() of the link must not be called because the
+ * reactor consumes the SSDTP stream; send() can be used from any thread as before.
+ * TimeCodes are passed to the timecode actions registered to the link.
+ * @code
+ * SpaceWireIFOverTCPReactor* reactor = new SpaceWireIFOverTCPReactor();
+ * reactor->start();
+ * reactor->addLink(spwif, handler);
+ * ...
+ * reactor->removeLink(spwif);
+ * reactor->stop();
+ * @endcode
+ */
+class SpaceWireIFOverTCPReactor: public CxxUtilities::StoppableThread {
+private:
+	class Link: public SpaceWireSSDTPParserAction {
+	public:
+		SpaceWireIFOverTCPReactor* reactor;
+		SpaceWireIFOverTCP* spwif;
+		SpaceWireIFOverTCPReactorHandler* handler;
+		int socketDescriptor;
+		uint64_t linkID;
+		SpaceWireSSDTPParser parser;
+		bool removed;
+
+	public:
+		Link(SpaceWireIFOverTCPReactor* reactor, SpaceWireIFOverTCP* spwif, SpaceWireIFOverTCPReactorHandler* handler,
+				uint64_t linkID) :
+				parser(&reactor->receiveBufferPool) {
+			this->reactor = reactor;
+			this->spwif = spwif;
+			this->handler = handler;
+			this->socketDescriptor = spwif->getDataSocket()->getSocketDescriptor();
+			this->linkID = linkID;
+			this->removed = false;
+		}
+
+	public:
+		void packetParsed(SpaceWireReceiveBuffer* buffer) {
+			//a handler may remove its link while packets parsed from the same read remain
+			if (removed) {
+				return;
+			}
+			reactor->nReceivedPackets++;
+			handler->packetReceived(spwif, buffer);
+		}
+
+	public:
+		void timecodeParsed(uint8_t timecode) {
+			if (removed) {
+				return;
+			}
+			spwif->doAction(timecode);
+		}
+	};
+
+public:
+	static const size_t ReadBufferSize = 64 * 1024;
+	/** A data fragment which has at least this many bytes remaining is read
+	 * from the socket directly into the packet buffer. */
+	static const size_t DirectReadThreshold = 4096;
+	static const int MaxEventsPerWait = 64;
+
+private:
+	static const uint64_t WakeUpID = 0;
+
+private:
+	int epollDescriptor;
+	int wakeUpDescriptor;
+	SpaceWireReceiveBufferPool receiveBufferPool;
+	std::vector<uint8_t> readBuffer;
+
+private:
+	//accessed only by the reactor thread (or by the caller while the reactor is not running)
+	std::unordered_map<uint64_t, Link*> links;
+	std::unordered_map<SpaceWireIFOverTCP*, Link*> linksBySpaceWireIF;
+	std::vector<Link*> retiredLinks;
+
+private:
+	//requests from other threads
+	std::mutex requestMutex;
+	std::condition_variable requestCondition;
+	std::vector<Link*> linksToBeAdded;
+	std::vector<SpaceWireIFOverTCP*> linksToBeRemoved;
+	uint64_t nRequests;
+	uint64_t nProcessedRequests;
+	std::unordered_map<SpaceWireIFOverTCP*, uint64_t> registeredLinks;
+	uint64_t nextLinkID;
+
+private:
+	//set by start() (or run()) until run() exits; while set, requests from other threads are queued
+	//for the reactor thread (guarded by requestMutex)
+	bool started;
+	std::atomic<bool> running;
+	std::thread::id reactorThreadID;
+
+public:
+	/** Number of packets passed to handlers. */
+	size_t nReceivedPackets;
+	/** Number of recv() system calls which returned data. */
+	size_t nReadSystemCalls;
+	/** Number of links removed because of disconnection or a broken SSDTP stream. */
+	size_t nDisconnectedLinks;
+
+public:
+	SpaceWireIFOverTCPReactor() throw (SpaceWireIFOverTCPReactorException) :
+			readBuffer(ReadBufferSize) {
+		epollDescriptor = epoll_create1(EPOLL_CLOEXEC);
+		if (epollDescriptor < 0) {
+			throw SpaceWireIFOverTCPReactorException(SpaceWireIFOverTCPReactorException::EpollCouldNotBeCreated);
+		}
+		wakeUpDescriptor = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+		if (wakeUpDescriptor < 0) {
+			::close(epollDescriptor);
+			throw SpaceWireIFOverTCPReactorException(SpaceWireIFOverTCPReactorException::EpollCouldNotBeCreated);
+		}
+		struct epoll_event event;
+		event.events = EPOLLIN;
+		event.data.u64 = WakeUpID;
+		epoll_ctl(epollDescriptor, EPOLL_CTL_ADD, wakeUpDescriptor, &event);
+		nRequests = 0;
+		nProcessedRequests = 0;
+		nextLinkID = WakeUpID + 1;
+		started = false;
+		running = false;
+		nReceivedPackets = 0;
+		nReadSystemCalls = 0;
+		nDisconnectedLinks = 0;
+	}
+
+	/** The reactor should be stopped before it is deleted. Links are removed
+	 * (but not closed).
+	 */
+	virtual ~SpaceWireIFOverTCPReactor() {
+		for (std::unordered_map<uint64_t, Link*>::iterator it = links.begin(); it != links.end(); it++) {
+			delete it->second;
+		}
+		for (size_t i = 0; i < linksToBeAdded.size(); i++) {
+			delete linksToBeAdded[i];
+		}
+		deleteRetiredLinks();
+		::close(wakeUpDescriptor);
+		::close(epollDescriptor);
+	}
+
+public:
+	/** Adds a link. Packets received via the link are passed to the handler
+	 * on the reactor thread. Bytes which the SSDTP module of the link has already
+	 * read ahead from the socket are parsed first, so that no packet is lost when
+	 * a link previously used with receive() is handed over to the reactor.
+	 * If the reactor has not been started, the link is added (and read-ahead packets
+	 * are passed to the handler) on the calling thread.
+	 * @param[in] spwif an opened link
+	 * @param[in] handler a handler for packets received via the link
+	 */
+	void addLink(SpaceWireIFOverTCP* spwif, SpaceWireIFOverTCPReactorHandler* handler)
+			throw (SpaceWireIFOverTCPReactorException) {
+		if (spwif->getState() != SpaceWireIF::Opened) {
+			throw SpaceWireIFOverTCPReactorException(SpaceWireIFOverTCPReactorException::LinkIsNotOpened);
+		}
+		Link* link;
+		{
+			std::lock_guard<std::mutex> guard(requestMutex);
+			if (registeredLinks.find(spwif) != registeredLinks.end()) {
+				throw SpaceWireIFOverTCPReactorException(SpaceWireIFOverTCPReactorException::LinkIsAlreadyAdded);
+			}
+			link = new Link(this, spwif, handler, nextLinkID++);
+			registeredLinks[spwif] = link->linkID;
+			if (started && !isReactorThread()) {
+				linksToBeAdded.push_back(link);
+				nRequests++;
+				wakeUp();
+				return;
+			}
+		}
+		addLinkOnReactorThread(link);
+	}
+
+public:
+	/** Removes a link. After this method returns, the handler of the link is
+	 * not invoked any more (this method waits for the reactor thread if necessary).
+	 * A packet which was partially received is discarded. Removing a link which
+	 * is not added (e.g. already removed due to disconnection) does nothing.
+	 * This method can be called from a handler.
+	 * @param[in] spwif a link to be removed
+	 */
+	void removeLink(SpaceWireIFOverTCP* spwif) {
+		{
+			std::unique_lock<std::mutex> lock(requestMutex);
+			if (registeredLinks.find(spwif) == registeredLinks.end()) {
+				return;
+			}
+			registeredLinks.erase(spwif);
+			//a link which has not been picked up by the reactor thread is simply dropped
+			for (size_t i = 0; i < linksToBeAdded.size(); i++) {
+				if (linksToBeAdded[i]->spwif == spwif) {
+					delete linksToBeAdded[i];
+					linksToBeAdded.erase(linksToBeAdded.begin() + i);
+					return;
+				}
+			}
+			if (started && !isReactorThread()) {
+				linksToBeRemoved.push_back(spwif);
+				uint64_t requestNumber = ++nRequests;
+				wakeUp();
+				requestCondition.wait(lock, [&]() {
+					return nProcessedRequests >= requestNumber || !started;
+				});
+				return;
+			}
+		}
+		removeLinkOnReactorThread(spwif);
+	}
+
+public:
+	size_t getNLinks() {
+		std::lock_guard<std::mutex> guard(requestMutex);
+		return registeredLinks.size();
+	}
+
+public:
+	SpaceWireReceiveBufferPool* getReceiveBufferPool() {
+		return &receiveBufferPool;
+	}
+
+public:
+	/** Starts the reactor thread. Links added or removed after this method is called
+	 * are handed over to the reactor thread, even if the thread has not entered run() yet.
+	 */
+	void start() {
+		{
+			std::lock_guard<std::mutex> guard(requestMutex);
+			started = true;
+		}
+		CxxUtilities::StoppableThread::start();
+	}
+
+public:
+	void run() {
+		using namespace std;
+		{
+			std::lock_guard<std::mutex> guard(requestMutex);
+			reactorThreadID = std::this_thread::get_id();
+			started = true;
+			running = true;
+		}
+		processRequests();
+		struct epoll_event events[MaxEventsPerWait];
+		while (!isStopRequested()) {
+			int nEvents = epoll_wait(epollDescriptor, events, MaxEventsPerWait, -1);
+			if (nEvents < 0) {
+				if (errno == EINTR) {
+					continue;
+				}
+				cerr << "SpaceWireIFOverTCPReactor::run() epoll_wait() failed (errno=" << errno << ")" << endl;
+				break;
+			}
+			for (int i = 0; i < nEvents; i++) {
+				if (events[i].data.u64 == WakeUpID) {
+					uint64_t value;
+					while (::read(wakeUpDescriptor, &value, sizeof(value)) > 0) {
+					}
+					continue;
+				}
+				std::unordered_map<uint64_t, Link*>::iterator it = links.find(events[i].data.u64);
+				if (it == links.end()) {
+					//removed while handling a preceding event
+					continue;
+				}
+				receiveFromLink(it->second);
+			}
+			processRequests();
+			deleteRetiredLinks();
+		}
+		{
+			std::lock_guard<std::mutex> guard(requestMutex);
+			running = false;
+			started = false;
+		}
+		requestCondition.notify_all();
+	}
+
+public:
+	/** Stops the reactor thread. The thread is woken up immediately,
+	 * and this method waits until it exits (unless called from a handler).
+	 * Links are not removed or closed.
+	 */
+	void stop() {
+		{
+			std::lock_guard<std::mutex> guard(requestMutex);
+			stopped = true;
+		}
+		wakeUp();
+		if (isReactorThread()) {
+			return;
+		}
+		std::unique_lock<std::mutex> lock(requestMutex);
+		requestCondition.wait(lock, [&]() {
+			return !started;
+		});
+	}
+
+private:
+	/** stopped of StoppableThread is a plain bool, and is therefore accessed under requestMutex. */
+	bool isStopRequested() {
+		std::lock_guard<std::mutex> guard(requestMutex);
+		return stopped;
+	}
+
+private:
+	bool isReactorThread() {
+		return running && std::this_thread::get_id() == reactorThreadID;
+	}
+
+private:
+	void wakeUp() {
+		uint64_t value = 1;
+		if (::write(wakeUpDescriptor, &value, sizeof(value)) < 0) {
+			//the counter is already non-zero; the reactor will wake up anyway
+		}
+	}
+
+private:
+	void processRequests() {
+		std::vector<Link*> addedLinks;
+		std::vector<SpaceWireIFOverTCP*> removedLinks;
+		uint64_t processedRequests;
+		{
+			std::lock_guard<std::mutex> guard(requestMutex);
+			addedLinks.swap(linksToBeAdded);
+			removedLinks.swap(linksToBeRemoved);
+			processedRequests = nRequests;
+		}
+		for (size_t i = 0; i < addedLinks.size(); i++) {
+			addLinkOnReactorThread(addedLinks[i]);
+		}
+		for (size_t i = 0; i < removedLinks.size(); i++) {
+			removeLinkOnReactorThread(removedLinks[i]);
+		}
+		if (processedRequests != nProcessedRequests) {
+			{
+				std::lock_guard<std::mutex> guard(requestMutex);
+				nProcessedRequests = processedRequests;
+			}
+			requestCondition.notify_all();
+		}
+	}
+
+private:
+	void addLinkOnReactorThread(Link* link) {
+		links[link->linkID] = link;
+		linksBySpaceWireIF[link->spwif] = link;
+		//parse bytes which the SSDTP module has read ahead but not consumed yet
+		std::vector<uint8_t> readAheadBytes;
+		link->spwif->getSSDTPModule()->takeReadAheadBytes(readAheadBytes);
+		if (!readAheadBytes.empty()) {
+			try {
+				link->parser.parse(&(readAheadBytes[0]), readAheadBytes.size(), link);
+			} catch (SpaceWireSSDTPException& e) {
+				disconnectLink(link);
+				return;
+			}
+			if (link->removed) {
+				return;
+			}
+		}
+		struct epoll_event event;
+		event.events = EPOLLIN | EPOLLRDHUP;
+		event.data.u64 = link->linkID;
+		if (epoll_ctl(epollDescriptor, EPOLL_CTL_ADD, link->socketDescriptor, &event) != 0) {
+			disconnectLink(link);
+		}
+	}
+
+private:
+	void removeLinkOnReactorThread(SpaceWireIFOverTCP* spwif) {
+		std::unordered_map<SpaceWireIFOverTCP*, Link*>::iterator it = linksBySpaceWireIF.find(spwif);
+		if (it == linksBySpaceWireIF.end()) {
+			return;
+		}
+		Link* link = it->second;
+		epoll_ctl(epollDescriptor, EPOLL_CTL_DEL, link->socketDescriptor, NULL);
+		links.erase(link->linkID);
+		linksBySpaceWireIF.erase(it);
+		link->removed = true;
+		//deleted after the current event is handled because its parser may be running
+		retiredLinks.push_back(link);
+	}
+
+private:
+	void deleteRetiredLinks() {
+		for (size_t i = 0; i < retiredLinks.size(); i++) {
+			delete retiredLinks[i];
+		}
+		retiredLinks.clear();
+	}
+
+private:
+	void disconnectLink(Link* link) {
+		{
+			std::lock_guard<std::mutex> guard(requestMutex);
+			std::unordered_map<SpaceWireIFOverTCP*, uint64_t>::iterator it = registeredLinks.find(link->spwif);
+			if (it != registeredLinks.end() && it->second == link->linkID) {
+				registeredLinks.erase(it);
+			}
+		}
+		removeLinkOnReactorThread(link->spwif);
+		nDisconnectedLinks++;
+		link->handler->linkDisconnected(link->spwif);
+	}
+
+private:
+	void receiveFromLink(Link* link) {
+		ssize_t result;
+		size_t length;
+		uint8_t* destination = link->parser.getFragmentDestination(length);
+		if (destination != NULL && length >= DirectReadThreshold) {
+			//a large fragment is read straight into the packet buffer
+			result = ::recv(link->socketDescriptor, destination, length, MSG_DONTWAIT);
+			if (result > 0) {
+				nReadSystemCalls++;
+				link->parser.fragmentDataWritten(result, link);
+				return;
+			}
+		} else {
+			result = ::recv(link->socketDescriptor, &(readBuffer[0]), readBuffer.size(), MSG_DONTWAIT);
+			if (result > 0) {
+				nReadSystemCalls++;
+				try {
+					link->parser.parse(&(readBuffer[0]), result, link);
+				} catch (SpaceWireSSDTPException& e) {
+					disconnectLink(link);
+				}
+				return;
+			}
+		}
+		if (result < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)) {
+			return;
+		}
+		//result==0 (closed by the peer) or a socket error
+		disconnectLink(link);
+	}
+};
+
+#endif /* __linux__ */
+
+#endif /* SPACEWIREIFOVERTCPREACTOR_HH_ */
@@ -112,6 +112,16 @@ private:
 	size_t nReceivedPackets;
 	CxxUtilities::Mutex sendMutex;
 
+private:
+	//reused by run() so that receiving packets does not allocate vectors
+	std::vector<SpaceWireReceiveBuffer*> receiveBuffers;
+	//reused by sendPackets()
+	std::vector<std::vector<uint8_t>*> sendBuffers;
+
+public:
+	/** Maximum number of packets received by one SpaceWireIF::receiveMany() call in run(). */
+	static const size_t ReceiveBatchSize = 16;
+
 private:
 	static constexpr double TimeoutDurationForStopCondition = 1000;
 
@@ -121,6 +131,15 @@ public:
 		nDiscardedReceivedPackets = 0;
 		nSentPackets = 0;
 		nReceivedPackets = 0;
+		for (size_t i = 0; i < ReceiveBatchSize; i++) {
+			receiveBuffers.push_back(new SpaceWireReceiveBuffer());
+		}
+	}
+
+	virtual ~SpaceWireREngine() {
+		for (size_t i = 0; i < receiveBuffers.size(); i++) {
+			receiveBuffers[i]->release();
+		}
 	}
 
 public:
@@ -258,6 +277,42 @@ public:
 		sendMutex.unlock();
 	}
 
+public:
+	/** Sends packets in this order with one SpaceWireIF::sendMany() call,
+	 * so that, for example, retransmitted segments are sent without per-packet
+	 * locking and (with SpaceWireIFOverTCP) with one system call.
+	 */
+	void sendPackets(std::vector<SpaceWireRPacket*>& packets) throw (SpaceWireREngineException) {
+		using namespace std;
+		if (packets.size() == 0) {
+			return;
+		}
+		if (this->isStopped()) {
+			throw SpaceWireREngineException(SpaceWireREngineException::SpaceWireREngineIsNotRunning);
+		}
+		sendMutex.lock();
+		sendBuffers.clear();
+		for (size_t i = 0; i < packets.size(); i++) {
+			sendBuffers.push_back(packets[i]->getPacketBufferPointer());
+		}
+		try {
+			spwif->sendMany(sendBuffers);
+			nSentPackets += packets.size();
+		} catch (...) {
+			for (size_t i = 0; i < sendBuffers.size(); i++) {
+				delete sendBuffers[i];
+			}
+			sendMutex.unlock();
+			cerr << "SpaceWireREngine::sendPackets() fatal error with SpaceWireIF. SpaceWireREngine will stop." << endl;
+			this->stop();
+			throw SpaceWireREngineException(SpaceWireREngineException::SpaceWireIFIsNotWorking);
+		}
+		for (size_t i = 0; i < sendBuffers.size(); i++) {
+			delete sendBuffers[i];
+		}
+		sendMutex.unlock();
+	}
+
 public:
 	void registerReceiveTEP(SpaceWireRTEPInterface* instance) {
 		receiveTEPs[instance->channel]=instance;
@@ -316,30 +371,33 @@ public:
 	void run() {
 		using namespace std;
 		spwif->setTimeoutDuration(DefaultReceiveTimeoutDurationInMicroSec);
-		std::vector<uint8_t>* data;
-		SpaceWireRPacket* packet;
+		std::vector<uint8_t>* data = NULL;
+		SpaceWireRPacket* packet = NULL;
 		_SpaceWireREngine_run_loop: //
 		while (!stopped) {
 			try {
 #ifdef DebugSpaceWireREngine
 				cout << "SpaceWireREngine::run() Waiting for a packet to be received." << endl;
 #endif
-				data = spwif->receive();
+				//a burst of packets is received with one call; 0 means timeout
+				size_t nPackets = spwif->receiveMany(receiveBuffers);
+				for (size_t i = 0; i < nPackets; i++) {
+					data = receiveBuffers[i]->getVector();
 #ifdef DebugSpaceWireREngine
-				cout << "SpaceWireREngine::run() A packet was received." << endl;
+					cout << "SpaceWireREngine::run() A packet was received." << endl;
 #endif
 #ifdef SpaceWireREngineDumpPacket
-			SpaceWireUtilities::dumpPacket(data);
+					SpaceWireUtilities::dumpPacket(data);
 #endif
-				nReceivedPackets++;
-				packet = new SpaceWireRPacket;
-				packet->interpretPacket(data);
+					nReceivedPackets++;
+					packet = new SpaceWireRPacket;
+					packet->interpretPacket(data);
 #ifdef DebugSpaceWireREngine
-				cout << "SpaceWireREngine::run() Packet was successfully interpreted. ChannelID="
-						<< (uint32_t) packet->getChannelNumber() << endl;
+					cout << "SpaceWireREngine::run() Packet was successfully interpreted. ChannelID="
+							<< (uint32_t) packet->getChannelNumber() << endl;
 #endif
-				processReceivedSpaceWireRPacket(packet);
-				delete data;
+					processReceivedSpaceWireRPacket(packet);
+				}
 			} catch (SpaceWireIFException& e) {
 				//todo
 #ifdef DebugSpaceWireREngine
@@ -358,7 +416,6 @@ public:
 				cerr << "SpaceWireREngine::run() got SpaceWireRPacketException " << e.toString() << endl;
 				dumpReceivedPacket(data);
 				this->stop();
-				delete data;
 				delete packet;
 				goto _SpaceWireREngine_run_loop;
 			} catch (...) {
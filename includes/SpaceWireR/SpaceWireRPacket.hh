@@ -392,7 +392,9 @@ public:
 		}
 
 		//Calculate CRC
-		crc16 = SpaceWireRUtilities::calculateCRCForArray(buffer, index - destinationSpaceWireAddressSize + 1);
+		//header and payload, as in getPacketBufferPointer() and interpretPacket()
+		crc16 = SpaceWireRUtilities::calculateCRCForArray(buffer + destinationSpaceWireAddressSize,
+				index - destinationSpaceWireAddressSize);
 
 		//Trailer
 		buffer[index] = crc16 / 0x100;
@@ -371,6 +371,8 @@ protected:
 	CxxUtilities::Condition conditionForSendWait;
 	CxxUtilities::Mutex mutexForNOfOutstandingPackets;
 	CxxUtilities::Mutex mutexForRetryTimeoutCounters;
+	//segments to be retransmitted together by checkRetryTimerThenRetry()
+	std::vector<SpaceWireRPacket*> retryPackets;
 
 protected:
 	// Sliding window related arrays
@@ -566,6 +568,7 @@ protected:
 	void checkRetryTimerThenRetry() throw (SpaceWireRTEPException) {
 		using namespace std;
 		mutexForRetryTimeoutCounters.lock();
+		retryPackets.clear();
 		for (size_t i = 0; i < this->slidingWindowSize; i++) {
 			uint8_t index = (uint8_t) (this->slidingWindowFrom + i);
 #ifdef DebugSpaceWireRTEP
@@ -597,11 +600,12 @@ protected:
 				<< (uint32_t) slidingWindowBuffer[index]->getSequenceNumber() << " "
 				<< slidingWindowBuffer[index]->getSequenceFlagsAsString() << endl;
 #endif
-				//do retry
-				spwREngine->sendPacket(slidingWindowBuffer[index]);
+				//do retry (expired segments are retransmitted together below)
+				retryPackets.push_back(slidingWindowBuffer[index]);
 				nRetriedSegments++;
 			}
 		}
+		spwREngine->sendPackets(retryPackets);
 		mutexForRetryTimeoutCounters.unlock();
 	}
 
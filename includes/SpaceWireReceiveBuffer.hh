@@ -0,0 +1,175 @@
+/* 
+============================================================================
+SpaceWire/RMAP Library is provided under the MIT License.
+============================================================================
+
+Copyright (c) 2006-2013 Takayuki Yuasa and The Open-source SpaceWire Project
+
+Permission is hereby granted, free of charge, to any person obtaining a 
+copy of this software and associated documentation files (the 
+"Software"), to deal in the Software without restriction, including 
+without limitation the rights to use, copy, modify, merge, publish, 
+distribute, sublicense, and/or sell copies of the Software, and to 
+permit persons to whom the Software is furnished to do so, subject to 
+the following conditions:
+
+The above copyright notice and this permission notice shall be included 
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. 
+*/
+/*
+ * SpaceWireReceiveBuffer.hh
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef SPACEWIRERECEIVEBUFFER_HH_
+#define SPACEWIRERECEIVEBUFFER_HH_
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+#include <stdint.h>
+#include "RMAPObjectPool.hh"
+#include "SpaceWireEOPMarker.hh"
+
+class SpaceWireReceiveBufferPool;
+
+/** A reference-counted packet buffer drawn from a SpaceWireReceiveBufferPool.
+ * SpaceWireIF::receiveInto() fills the buffer in place. A receiver can hand
+ * the same buffer to several consumers by calling retain() once per additional
+ * consumer; each consumer calls release() when it finishes, and the last
+ * release() returns the buffer to its pool. The underlying vector keeps its
+ * capacity across reuse, so that steady-state receive does not allocate memory.
+ */
+class SpaceWireReceiveBuffer {
+	friend class SpaceWireReceiveBufferPool;
+
+private:
+	std::vector<uint8_t> data;
+	SpaceWireEOPMarker::EOPType eopType;
+	std::atomic<uint32_t> referenceCount;
+	SpaceWireReceiveBufferPool* pool;
+
+public:
+	/** Creates a buffer with one reference which does not belong to a pool. */
+	SpaceWireReceiveBuffer() :
+			eopType(SpaceWireEOPMarker::EOP), referenceCount(1), pool(NULL) {
+	}
+
+private:
+	SpaceWireReceiveBuffer(const SpaceWireReceiveBuffer&);
+	SpaceWireReceiveBuffer& operator=(const SpaceWireReceiveBuffer&);
+
+public:
+	/** Returns a pointer to the first byte of the packet, or NULL if the packet is empty. */
+	uint8_t* getData() {
+		return data.empty() ? NULL : &(data[0]);
+	}
+
+public:
+	size_t getSize() const {
+		return data.size();
+	}
+
+public:
+	/** Returns the vector which holds the packet. SpaceWireIF implementations
+	 * resize it to the packet size and write received bytes into it.
+	 */
+	std::vector<uint8_t>* getVector() {
+		return &data;
+	}
+
+public:
+	SpaceWireEOPMarker::EOPType getEOPType() const {
+		return eopType;
+	}
+
+	void setEOPType(SpaceWireEOPMarker::EOPType eopType) {
+		this->eopType = eopType;
+	}
+
+public:
+	/** Adds a reference for an additional consumer. */
+	void retain() {
+		referenceCount.fetch_add(1, std::memory_order_relaxed);
+	}
+
+public:
+	/** Drops a reference. When the last reference is dropped, the buffer is
+	 * returned to its pool (or deleted if it does not belong to a pool).
+	 */
+	void release();
+
+public:
+	uint32_t getReferenceCount() const {
+		return referenceCount.load(std::memory_order_relaxed);
+	}
+};
+
+/** A pool of SpaceWireReceiveBuffer instances, built on RMAPObjectPool.
+ * acquire() returns an empty buffer with one reference, and the last
+ * SpaceWireReceiveBuffer::release() returns the buffer to the pool.
+ * New buffers reserve initialBufferSize bytes. Buffers still referenced by
+ * consumers should be released before the pool is deleted.
+ */
+class SpaceWireReceiveBufferPool: public RMAPObjectPool<SpaceWireReceiveBuffer> {
+	friend class SpaceWireReceiveBuffer;
+
+public:
+	static const size_t DefaultCapacity = 256;
+	static const size_t DefaultInitialBufferSize = 4096;
+
+private:
+	size_t initialBufferSize;
+
+public:
+	/** @param[in] capacity maximum number of free buffers retained in the pool
+	 * @param[in] initialBufferSize number of bytes reserved in a newly created buffer
+	 */
+	SpaceWireReceiveBufferPool(size_t capacity = DefaultCapacity, size_t initialBufferSize = DefaultInitialBufferSize) :
+			RMAPObjectPool<SpaceWireReceiveBuffer>(capacity), initialBufferSize(initialBufferSize) {
+	}
+
+public:
+	/** Returns an empty buffer whose reference count is 1. */
+	SpaceWireReceiveBuffer* acquire() {
+		SpaceWireReceiveBuffer* buffer = RMAPObjectPool<SpaceWireReceiveBuffer>::acquire();
+		buffer->data.clear();
+		buffer->eopType = SpaceWireEOPMarker::EOP;
+		buffer->referenceCount.store(1, std::memory_order_relaxed);
+		return buffer;
+	}
+
+private:
+	//buffers are returned via SpaceWireReceiveBuffer::release(), which counts references
+	using RMAPObjectPool<SpaceWireReceiveBuffer>::release;
+
+protected:
+	SpaceWireReceiveBuffer* createObject() {
+		SpaceWireReceiveBuffer* buffer = new SpaceWireReceiveBuffer();
+		buffer->data.reserve(initialBufferSize);
+		buffer->pool = this;
+		return buffer;
+	}
+};
+
+inline void SpaceWireReceiveBuffer::release() {
+	if (referenceCount.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+		return;
+	}
+	if (pool != NULL) {
+		pool->release(this);
+	} else {
+		delete this;
+	}
+}
+
+#endif /* SPACEWIRERECEIVEBUFFER_HH_ */
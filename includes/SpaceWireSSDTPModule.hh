@@ -35,6 +35,12 @@
 
 #include "SpaceWireIF.hh"
 
+#include <sys/uio.h>
+#include <sys/socket.h>
+#include <string.h>
+#include <errno.h>
+#include <limits>
+
 /** An exception class used by SpaceWireSSDTPModule.
  */
 class SpaceWireSSDTPException: public CxxUtilities::Exception {
@@ -108,6 +114,10 @@ public:
 class SpaceWireSSDTPModule {
 public:
 	static const uint32_t BufferSize = 10 * 1024 * 1024;
+	static const size_t ReadAheadBufferSize = 64 * 1024;
+	/** Reads of at least this size are not staged in the read-ahead buffer but
+	 * done directly into the destination (see readFromStream()). */
+	static const size_t DirectReadSize = 4 * 1024;
 
 private:
 	bool closed = false;
@@ -133,8 +143,13 @@ private:
 	uint8_t rheader[12];
 	uint8_t r_tmp[30];
 	uint8_t sheader[12];
+	std::vector<uint8_t> sendManyHeaders;
+	std::vector<struct iovec> sendManyIOVectors;
 
-public:
+private:
+	/** Read-ahead buffer. Bytes in [rbuf_index, receivedsize) have been
+	 * read from the socket but not yet consumed by the receive state machine. */
+	uint8_t* readaheadbuffer;
 	size_t receivedsize;
 	size_t rbuf_index;
 
@@ -144,6 +159,7 @@ public:
 		datasocket = newdatasocket;
 		sendbuffer = (uint8_t*) malloc(SpaceWireSSDTPModule::BufferSize);
 		receivebuffer = (uint8_t*) malloc(SpaceWireSSDTPModule::BufferSize);
+		readaheadbuffer = (uint8_t*) malloc(SpaceWireSSDTPModule::ReadAheadBufferSize);
 		internal_timecode = 0x00;
 		latest_sentsize = 0;
 		timecodeaction = NULL;
@@ -161,6 +177,9 @@ public:
 		if (receivebuffer != NULL) {
 			free(receivebuffer);
 		}
+		if (readaheadbuffer != NULL) {
+			free(readaheadbuffer);
+		}
 	}
 
 public:
@@ -182,68 +201,152 @@ public:
 	 * @param[in] eopType End-of-Packet marker. SpaceWireEOPMarker::EOP or SpaceWireEOPMarker::EEP.
 	 */
 	void send(std::vector<uint8_t>* data, uint32_t eopType = SpaceWireEOPMarker::EOP) throw (SpaceWireSSDTPException) {
+		send((data->size() != 0) ? &(data->at(0)) : NULL, data->size(), eopType);
+	}
+
+public:
+	/** Sends a SpaceWire packet via the SpaceWire interface.
+	 * The SSDTP header and the packet content are passed to the kernel
+	 * in a single vectored write, so that a small packet is sent with one
+	 * system call (and usually in one TCP segment).
+	 * This is a blocking method.
+	 * @param[in] data packet content.
+	 * @param[in] the length length of the packet.
+	 * @param[in] eopType End-of-Packet marker. SpaceWireEOPMarker::EOP or SpaceWireEOPMarker::EEP.
+	 */
+	void send(uint8_t* data, size_t length, uint32_t eopType = SpaceWireEOPMarker::EOP) throw (SpaceWireSSDTPException) {
 		sendmutex.lock();
 		if(this->closed){
 			sendmutex.unlock();
 			return;
 		}
-		size_t size = data->size();
-		if (eopType == SpaceWireEOPMarker::EOP) {
-			sheader[0] = DataFlag_Complete_EOP;
-		} else if (eopType == SpaceWireEOPMarker::EEP) {
-			sheader[0] = DataFlag_Complete_EEP;
-		} else if (eopType == SpaceWireEOPMarker::Continued) {
-			sheader[0] = DataFlag_Flagmented;
-		}
-		sheader[1] = 0x00;
-		for (uint32_t i = 11; i > 1; i--) {
-			sheader[i] = size % 0x100;
-			size = size / 0x100;
-		}
+		setDataHeader(sheader, length, eopType);
+		struct iovec iov[2];
+		iov[0].iov_base = sheader;
+		iov[0].iov_len = 12;
+		iov[1].iov_base = data;
+		iov[1].iov_len = length;
 		try {
-			datasocket->send(sheader, 12);
-			datasocket->send(&(data->at(0)), data->size());
-		} catch (...) {
+			bool written = false;
+			sendIOVector(iov, (length != 0) ? 2 : 1, written);
+		} catch (SpaceWireSSDTPException& e) {
 			sendmutex.unlock();
-			throw SpaceWireSSDTPException(SpaceWireSSDTPException::Disconnected);
+			throw e;
 		}
 		sendmutex.unlock();
 	}
 
 public:
-	/** Sends a SpaceWire packet via the SpaceWire interface.
+	/** Sends multiple SpaceWire packets via the SpaceWire interface.
+	 * SSDTP headers and packet contents of all the packets are gathered
+	 * into vectored writes so that N packets are sent with (typically)
+	 * one system call. Packets are sent in the order of the given vector,
+	 * and other send() calls are not interleaved between them.
 	 * This is a blocking method.
-	 * @param[in] data packet content.
-	 * @param[in] the length length of the packet.
-	 * @param[in] eopType End-of-Packet marker. SpaceWireEOPMarker::EOP or SpaceWireEOPMarker::EEP.
+	 * @param[in] packets packet contents.
+	 * @param[in] eopType End-of-Packet marker applied to all the packets.
 	 */
-	void send(uint8_t* data, size_t length, uint32_t eopType = SpaceWireEOPMarker::EOP) throw (SpaceWireSSDTPException) {
+	void sendMany(std::vector<std::vector<uint8_t>*>& packets, uint32_t eopType = SpaceWireEOPMarker::EOP)
+			throw (SpaceWireSSDTPException) {
 		sendmutex.lock();
-		if(this->closed){
+		if (this->closed) {
 			sendmutex.unlock();
 			return;
 		}
+		size_t nPackets = packets.size();
+		if (sendManyHeaders.size() < nPackets * 12) {
+			sendManyHeaders.resize(nPackets * 12);
+		}
+		sendManyIOVectors.clear();
+		for (size_t i = 0; i < nPackets; i++) {
+			size_t length = packets[i]->size();
+			uint8_t* header = &(sendManyHeaders[i * 12]);
+			setDataHeader(header, length, eopType);
+			struct iovec iov;
+			iov.iov_base = header;
+			iov.iov_len = 12;
+			sendManyIOVectors.push_back(iov);
+			if (length != 0) {
+				iov.iov_base = &(packets[i]->at(0));
+				iov.iov_len = length;
+				sendManyIOVectors.push_back(iov);
+			}
+		}
+		try {
+			//sendmsg() accepts at most MaxIOVectorsPerWrite entries at once
+			bool written = false;
+			for (size_t i = 0; i < sendManyIOVectors.size(); i += MaxIOVectorsPerWrite) {
+				size_t nIOVectors = sendManyIOVectors.size() - i;
+				if (nIOVectors > MaxIOVectorsPerWrite) {
+					nIOVectors = MaxIOVectorsPerWrite;
+				}
+				sendIOVector(&(sendManyIOVectors[i]), nIOVectors, written);
+			}
+		} catch (SpaceWireSSDTPException& e) {
+			sendmutex.unlock();
+			throw e;
+		}
+		sendmutex.unlock();
+	}
+
+private:
+	/** Fills a 12-byte SSDTP data header. */
+	void setDataHeader(uint8_t* header, size_t length, uint32_t eopType) {
 		if (eopType == SpaceWireEOPMarker::EOP) {
-			sheader[0] = DataFlag_Complete_EOP;
+			header[0] = DataFlag_Complete_EOP;
 		} else if (eopType == SpaceWireEOPMarker::EEP) {
-			sheader[0] = DataFlag_Complete_EEP;
+			header[0] = DataFlag_Complete_EEP;
 		} else if (eopType == SpaceWireEOPMarker::Continued) {
-			sheader[0] = DataFlag_Flagmented;
+			header[0] = DataFlag_Flagmented;
 		}
-		sheader[1] = 0x00;
-		size_t asize = length;
+		header[1] = 0x00;
 		for (size_t i = 11; i > 1; i--) {
-			sheader[i] = asize % 0x100;
-			asize = asize / 0x100;
+			header[i] = length % 0x100;
+			length = length / 0x100;
 		}
-		try {
-			datasocket->send(sheader, 12);
-			datasocket->send(data, length);
-		} catch (...) {
-			sendmutex.unlock();
-			throw SpaceWireSSDTPException(SpaceWireSSDTPException::Disconnected);
+	}
+
+private:
+	/** Writes all bytes pointed by the iovec array, resuming after partial writes.
+	 * The iovec array is modified while being consumed.
+	 * sendmsg() with MSG_NOSIGNAL is used instead of writev() so that writing to a
+	 * connection closed by the peer is reported as Disconnected instead of raising SIGPIPE.
+	 * A timeout is reported as Timeout only if nothing of the batch has been written yet
+	 * (written==false); otherwise the SSDTP framing of the stream is broken, and
+	 * Disconnected is thrown.
+	 * @param[in,out] written set to true once any byte has been written
+	 */
+	void sendIOVector(struct iovec* iov, size_t iovcnt, bool& written) throw (SpaceWireSSDTPException) {
+		int socketDescriptor = datasocket->getSocketDescriptor();
+		while (iovcnt != 0) {
+			struct msghdr message;
+			memset(&message, 0, sizeof(message));
+			message.msg_iov = iov;
+			message.msg_iovlen = iovcnt;
+			ssize_t result = ::sendmsg(socketDescriptor, &message, SendFlags);
+			if (result < 0) {
+				if (errno == EINTR) {
+					continue;
+				} else if ((errno == EAGAIN || errno == EWOULDBLOCK) && !written) {
+					throw SpaceWireSSDTPException(SpaceWireSSDTPException::Timeout);
+				} else {
+					throw SpaceWireSSDTPException(SpaceWireSSDTPException::Disconnected);
+				}
+			}
+			if (result != 0) {
+				written = true;
+			}
+			size_t writtenSize = result;
+			while (iovcnt != 0 && iov->iov_len <= writtenSize) {
+				writtenSize -= iov->iov_len;
+				iov++;
+				iovcnt--;
+			}
+			if (iovcnt != 0) {
+				iov->iov_base = (uint8_t*) iov->iov_base + writtenSize;
+				iov->iov_len -= writtenSize;
+			}
 		}
-		sendmutex.unlock();
 	}
 
 public:
@@ -305,75 +408,209 @@ public:
 	 * @param[out] eopType contains an EOP marker type (SpaceWireEOPMarker::EOP or SpaceWireEOPMarker::EEP).
 	 */
 	int receive(std::vector<uint8_t>* data, uint32_t& eopType) throw (SpaceWireSSDTPException) {
+		return receivePacket(data, NULL, 0, eopType);
+	}
+
+public:
+	/** Tries to receive a packet from the SpaceWire interface directly into
+	 * a caller-supplied buffer. Data fragments are read from the socket into
+	 * the buffer without passing through the internal receive buffer, so that
+	 * the received bytes are not copied again after they leave the kernel.
+	 * Timeout behavior is the same as receive(std::vector<uint8_t>*, uint32_t&).
+	 * If the packet is longer than maxLength, the remaining part of the packet
+	 * is drained from the socket (to keep SSDTP framing intact), and
+	 * SpaceWireSSDTPException::DataSizeTooLarge is thrown.
+	 * @param[out] buffer a byte array which is used to store received data.
+	 * @param[in] maxLength the size of the buffer.
+	 * @param[out] eopType contains an EOP marker type (SpaceWireEOPMarker::EOP or SpaceWireEOPMarker::EEP).
+	 * @returns the size of the received packet.
+	 */
+	size_t receive(uint8_t* buffer, size_t maxLength, uint32_t& eopType) throw (SpaceWireSSDTPException) {
+		return receivePacket(NULL, buffer, maxLength, eopType);
+	}
+
+public:
+	/** Receives multiple packets while holding the receive lock once.
+	 * This method blocks until the first packet is received (timeout behavior is
+	 * the same as receive(std::vector<uint8_t>*, uint32_t&)). After that, further
+	 * packets are received only while a complete packet is already available in
+	 * the read-ahead buffer, so that this method does not wait for packets that
+	 * have not arrived yet.
+	 * @param[out] buffers vectors used to store received packets; at most buffers.size() packets are received.
+	 * @param[out] eopTypes EOP marker types of received packets (resized to buffers.size()).
+	 * @returns the number of received packets (0 if the module was closed or receive was canceled).
+	 */
+	size_t receiveMany(std::vector<std::vector<uint8_t>*>& buffers, std::vector<uint32_t>& eopTypes)
+			throw (SpaceWireSSDTPException) {
+		eopTypes.resize(buffers.size());
+		if (buffers.size() == 0) {
+			return 0;
+		}
+		size_t nReceivedPackets = 0;
+		receivemutex.lock();
+		try {
+			if (receivePacketWithoutLock(buffers[0], NULL, 0, eopTypes[0]) != 0) {
+				nReceivedPackets++;
+				while (nReceivedPackets < buffers.size() && isCompletePacketBuffered()) {
+					if (receivePacketWithoutLock(buffers[nReceivedPackets], NULL, 0, eopTypes[nReceivedPackets]) == 0) {
+						break;
+					}
+					nReceivedPackets++;
+				}
+			}
+		} catch (SpaceWireSSDTPException& e) {
+			receivemutex.unlock();
+			if (nReceivedPackets != 0) {
+				//packets already received are returned; the error is reported by the next call
+				return nReceivedPackets;
+			}
+			throw e;
+		}
+		receivemutex.unlock();
+		return nReceivedPackets;
+	}
+
+public:
+	/** Removes the bytes which have been read ahead from the socket but not received yet,
+	 * and appends them to data, so that another reader (e.g. SpaceWireIFOverTCPReactor)
+	 * can take over the SSDTP stream without losing them.
+	 * @param[out] data a vector to which the bytes are appended
+	 */
+	void takeReadAheadBytes(std::vector<uint8_t>& data) {
+		receivemutex.lock();
+		data.insert(data.end(), readaheadbuffer + rbuf_index, readaheadbuffer + receivedsize);
+		rbuf_index = receivedsize;
+		receivemutex.unlock();
+	}
+
+private:
+	/** Checks if the read-ahead buffer contains the whole of the next packet
+	 * (all of its fragments and any TimeCodes in between), so that it can be
+	 * received without reading from the socket.
+	 */
+	bool isCompletePacketBuffered() {
+		size_t index = rbuf_index;
+		size_t packetSize = 0;
+		while (index + 12 <= receivedsize) {
+			uint8_t* header = readaheadbuffer + index;
+			uint64_t frameSize;
+			FrameType frameType = decodeHeader(header, frameSize);
+			if (frameType == UndefinedFrame) {
+				//let receivePacketWithoutLock() report the broken frame
+				return true;
+			}
+			if (receivedsize - index - 12 < frameSize) {
+				return false;
+			}
+			index += 12 + frameSize;
+			if (frameType == DataFrame) {
+				packetSize += frameSize;
+			}
+			if ((header[0] == DataFlag_Complete_EOP || header[0] == DataFlag_Complete_EEP) && packetSize != 0) {
+				return true;
+			}
+		}
+		return false;
+	}
+
+private:
+	/** Receives a packet either into a growable vector (vectorBuffer!=NULL)
+	 * or into a fixed-size array (arrayBuffer with maxLength bytes).
+	 */
+	size_t receivePacket(std::vector<uint8_t>* vectorBuffer, uint8_t* arrayBuffer, size_t maxLength,
+			uint32_t& eopType) throw (SpaceWireSSDTPException) {
+		receivemutex.lock();
+		try {
+			size_t size = receivePacketWithoutLock(vectorBuffer, arrayBuffer, maxLength, eopType);
+			receivemutex.unlock();
+			return size;
+		} catch (SpaceWireSSDTPException& e) {
+			receivemutex.unlock();
+			throw e;
+		}
+	}
+
+private:
+	/** Body of receivePacket(). The caller should hold receivemutex.
+	 * @returns the size of the received packet, or 0 if the module was closed
+	 * or receive was canceled.
+	 */
+	size_t receivePacketWithoutLock(std::vector<uint8_t>* vectorBuffer, uint8_t* arrayBuffer, size_t maxLength,
+			uint32_t& eopType) throw (SpaceWireSSDTPException) {
 		size_t size = 0;
 		size_t hsize = 0;
 		size_t flagment_size = 0;
 		size_t received_size = 0;
+		bool overflowed = false;
 
 		try {
 			using namespace std;
-//		cout << "#1" << endl;
-			receivemutex.lock();
 			//header
 			receive_header: //
 			rheader[0] = 0xFF;
 			rheader[1] = 0x00;
 			while (rheader[0] != DataFlag_Complete_EOP && rheader[0] != DataFlag_Complete_EEP) {
-//			cout << "#2" << endl;
-
-//			cout << "#2-1" << endl;
 				hsize = 0;
 				flagment_size = 0;
 				received_size = 0;
 				//flag and size part
 				try {
-//				cout << "#2-2" << endl;
 					while (hsize != 12) {
-						if(this->closed){
+						if (this->closed) {
 							return 0;
 						}
-						if(this->receiveCanceled){
+						if (this->receiveCanceled) {
 							//reset receiveCanceled
 							this->receiveCanceled = false;
 							//return with no data
 							return 0;
 						}
-//					cout << "#2-3" << endl;
-						long result = datasocket->receive(rheader + hsize, 12 - hsize);
+						long result = readFromStream(rheader + hsize, 12 - hsize);
 						hsize += result;
-//					cout << "#2-4" << endl;
 					}
 				} catch (CxxUtilities::TCPSocketException e) {
-//				cout << "#2-5" << endl;
 					if (e.getStatus() == CxxUtilities::TCPSocketException::Timeout) {
-//					cout << "#2-6" << endl;
 						throw SpaceWireSSDTPException(SpaceWireSSDTPException::Timeout);
 					} else {
-//					cout << "#2-7" << endl;
 						throw SpaceWireSSDTPException(SpaceWireSSDTPException::Disconnected);
 					}
 				} catch (...) {
 					throw SpaceWireSSDTPException(SpaceWireSSDTPException::Disconnected);
 				}
 
-//			cout << "#3" << endl;
 				//data or control code part
-				if (rheader[0] == DataFlag_Complete_EOP || rheader[0] == DataFlag_Complete_EEP
-						|| rheader[0] == DataFlag_Flagmented) {
-//				cout << "#4" << endl;
+				uint64_t bodySize;
+				FrameType frameType = decodeHeader(rheader, bodySize);
+				if (frameType == DataFrame) {
 					//data
-					for (uint32_t i = 2; i < 12; i++) {
-						flagment_size = flagment_size * 0x100 + rheader[i];
+					flagment_size = bodySize;
+					//select where this fragment is written (a vector is filled by readFromStreamIntoVector())
+					uint8_t* data_pointer;
+					if (vectorBuffer != NULL) {
+						data_pointer = NULL;
+					} else if (!overflowed && size + flagment_size <= maxLength) {
+						data_pointer = arrayBuffer + size;
+					} else {
+						//the caller's buffer is too small; drain the fragment to keep the stream in sync
+						overflowed = true;
+						data_pointer = NULL;
 					}
-					//uint8_t* data_pointer=&(data->at(0));
-					uint8_t* data_pointer = receivebuffer;
-//				cout << "#5" << endl;
 					while (received_size != flagment_size) {
-//					cout << "#6" << endl;
 						long result;
 						_loop_receiveDataPart: //
 						try {
-							result = datasocket->receive(data_pointer + size + received_size, flagment_size - received_size);
+							if (vectorBuffer != NULL) {
+								result = readFromStreamIntoVector(vectorBuffer, size + received_size,
+										flagment_size - received_size);
+							} else if (data_pointer != NULL) {
+								result = readFromStream(data_pointer + received_size, flagment_size - received_size);
+							} else {
+								size_t drainSize = flagment_size - received_size;
+								if (drainSize > BufferSize) {
+									drainSize = BufferSize;
+								}
+								result = readFromStream(receivebuffer, drainSize);
+							}
 						} catch (CxxUtilities::TCPSocketException e) {
 							if (e.getStatus() == CxxUtilities::TCPSocketException::Timeout) {
 								goto _loop_receiveDataPart;
@@ -388,15 +625,14 @@ public:
 						}
 						received_size += result;
 					}
-//				cout << "#7" << endl;
 					size += received_size;
-				} else if (rheader[0] == ControlFlag_SendTimeCode || rheader[0] == ControlFlag_GotTimeCode) {
+				} else if (frameType == TimeCodeFrame) {
 					//control
 					uint8_t timecode_and_reserved[2];
 					uint32_t tmp_size = 0;
 					try {
 						while (tmp_size != 2) {
-							int result = datasocket->receive(timecode_and_reserved + tmp_size, 2 - tmp_size);
+							int result = readFromStream(timecode_and_reserved + tmp_size, 2 - tmp_size);
 							tmp_size += result;
 						}
 					} catch (...) {
@@ -412,19 +648,20 @@ public:
 						gotTimeCode(internal_timecode);
 						break;
 					}
-//				cout << "#11" << endl;
 				} else {
 					cout << "SSDTP fatal error with flag value of 0x" << hex << (uint32_t) rheader[0] << dec << endl;
 					throw SpaceWireSSDTPException(SpaceWireSSDTPException::TCPSocketError);
 				}
 			}
-//		cout << "#8 " << size << endl;
-			data->resize(size);
-			if (size != 0) {
-				memcpy(&(data->at(0)), receivebuffer, size);
-			} else {
+			if (size == 0) {
 				goto receive_header;
 			}
+			if (vectorBuffer != NULL) {
+				vectorBuffer->resize(size);
+			}
+			if (overflowed) {
+				throw SpaceWireSSDTPException(SpaceWireSSDTPException::DataSizeTooLarge);
+			}
 			if (rheader[0] == DataFlag_Complete_EOP) {
 				eopType = SpaceWireEOPMarker::EOP;
 			} else if (rheader[0] == DataFlag_Complete_EEP) {
@@ -432,32 +669,71 @@ public:
 			} else {
 				eopType = SpaceWireEOPMarker::Continued;
 			}
-//		cout << "#9" << endl;
-			receivemutex.unlock();
 			return size;
-		} catch (SpaceWireSSDTPException& e) {
-			receivemutex.unlock();
-			throw e;
 		} catch (CxxUtilities::TCPSocketException& e) {
-			using namespace std;
-//			cout << "#SpaceWireSSDTPModule::receive() caught TCPSocketException(" << e.toString() << ")" << endl;
-			receivemutex.unlock();
 			throw SpaceWireSSDTPException(SpaceWireSSDTPException::TCPSocketError);
-		}/* catch (...) {
-		 using namespace std;
-		 cout << "#SpaceWireSSDTPModule::receive() caught an unexpected exception" << endl;
-		 cout << "Receive Header: ";
-		 for (size_t i = 0; i < 12; i++) {
-		 cout << "0x" << hex << right << setw(2) << setfill('0') << (uint32_t) rheader[i] << " ";
-		 }
-		 cout << endl;
-		 cout << "size=" << size << endl;
-		 cout << "hsize=" << hsize << endl;
-		 cout << "flagment_size=" << flagment_size << endl;
-		 cout << "received_size=" << received_size << endl;
-		 receivemutex.unlock();
-		 throw SpaceWireSSDTPException(SpaceWireSSDTPException::TCPSocketError);
-		 }*/
+		}
+	}
+
+private:
+	/** Reads at most length bytes of the SSDTP stream.
+	 * Small reads (headers, TimeCode bodies, short fragments) are served from
+	 * the read-ahead buffer, which is refilled with a single large socket read,
+	 * so that many SSDTP frames are parsed out of one system call.
+	 * Bytes already in the read-ahead buffer are copied first; once it is drained,
+	 * a request of DirectReadSize or more (i.e. the rest of a large fragment) is read
+	 * from the socket directly into the destination instead of being copied twice.
+	 * Exceptions thrown by the socket are passed through to the caller.
+	 * @returns the number of bytes copied to the destination.
+	 */
+	size_t readFromStream(uint8_t* destination, size_t length) {
+		if (rbuf_index == receivedsize) {
+			rbuf_index = 0;
+			receivedsize = 0;
+			if (length >= DirectReadSize) {
+				return datasocket->receive(destination, length);
+			}
+			receivedsize = datasocket->receive(readaheadbuffer, ReadAheadBufferSize);
+		}
+		size_t available = receivedsize - rbuf_index;
+		if (length > available) {
+			length = available;
+		}
+		memcpy(destination, readaheadbuffer + rbuf_index, length);
+		rbuf_index += length;
+		return length;
+	}
+
+private:
+	/** Reads at most length bytes of the SSDTP stream into a vector at offset (<= vector->size()).
+	 * Existing elements of the vector are overwritten, and bytes beyond them are appended
+	 * from the read-ahead buffer with insert(), so that the vector is not resized
+	 * (i.e. zero-filled) ahead of the data. Only a large fragment, which is read from
+	 * the socket directly (see readFromStream()), grows the vector before the read.
+	 * The caller resizes the vector to the packet size after the last fragment.
+	 * @returns the number of bytes written to the vector.
+	 */
+	size_t readFromStreamIntoVector(std::vector<uint8_t>* vector, size_t offset, size_t length) {
+		if (offset < vector->size()) {
+			size_t existingSize = vector->size() - offset;
+			return readFromStream(&((*vector)[offset]), (length < existingSize) ? length : existingSize);
+		}
+		if (rbuf_index == receivedsize) {
+			if (length >= DirectReadSize) {
+				vector->resize(offset + length);
+				return readFromStream(&((*vector)[offset]), length);
+			}
+			rbuf_index = 0;
+			receivedsize = 0;
+			receivedsize = datasocket->receive(readaheadbuffer, ReadAheadBufferSize);
+		}
+		size_t available = receivedsize - rbuf_index;
+		if (length > available) {
+			length = available;
+		}
+		vector->insert(vector->end(), readaheadbuffer + rbuf_index, readaheadbuffer + rbuf_index + length);
+		rbuf_index += length;
+		return length;
 	}
 
 public:
@@ -628,6 +904,48 @@ public:
 	static const uint8_t ControlFlag_RegisterAccess_WriteCommand = 0x50;
 	static const uint8_t ControlFlag_RegisterAccess_WriteReply = 0x51;
 	static const uint32_t LengthOfSizePart = 10;
+	static const size_t MaxIOVectorsPerWrite = 512;
+
+public:
+	/** Types of SSDTP frames returned by decodeHeader(). */
+	enum FrameType {
+		DataFrame, TimeCodeFrame, UndefinedFrame
+	};
+
+public:
+	/** Decodes a 12-byte header of the SSDTP stream.
+	 * Used by both the receive state machine of this class and SpaceWireSSDTPParser.
+	 * @param[in] header a header
+	 * @param[out] bodySize the number of bytes which follow the header (a data fragment, or a TimeCode
+	 * and a reserved byte); a size which does not fit in uint64_t is saturated
+	 * @returns DataFrame for a complete or fragmented packet, TimeCodeFrame, or UndefinedFrame for other flags
+	 */
+	static FrameType decodeHeader(const uint8_t* header, uint64_t& bodySize) {
+		uint8_t flag = header[0];
+		bodySize = 0;
+		if (flag == DataFlag_Complete_EOP || flag == DataFlag_Complete_EEP || flag == DataFlag_Flagmented) {
+			for (uint32_t i = 2; i < 12; i++) {
+				if (bodySize > (std::numeric_limits<uint64_t>::max() >> 8)) {
+					bodySize = std::numeric_limits<uint64_t>::max();
+					break;
+				}
+				bodySize = bodySize * 0x100 + header[i];
+			}
+			return DataFrame;
+		} else if (flag == ControlFlag_SendTimeCode || flag == ControlFlag_GotTimeCode) {
+			bodySize = 2;
+			return TimeCodeFrame;
+		} else {
+			return UndefinedFrame;
+		}
+	}
+
+private:
+#ifdef MSG_NOSIGNAL
+	static const int SendFlags = MSG_NOSIGNAL;
+#else
+	static const int SendFlags = 0; //SIGPIPE should be ignored by the application on this platform
+#endif
 };
 
 #endif /*SPACEWIRESSDTPMODULE_HH_*/
@@ -0,0 +1,252 @@
+/* 
+============================================================================
+SpaceWire/RMAP Library is provided under the MIT License.
+============================================================================
+
+Copyright (c) 2006-2013 Takayuki Yuasa and The Open-source SpaceWire Project
+
+Permission is hereby granted, free of charge, to any person obtaining a 
+copy of this software and associated documentation files (the 
+"Software"), to deal in the Software without restriction, including 
+without limitation the rights to use, copy, modify, merge, publish, 
+distribute, sublicense, and/or sell copies of the Software, and to 
+permit persons to whom the Software is furnished to do so, subject to 
+the following conditions:
+
+The above copyright notice and this permission notice shall be included 
+in all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS 
+OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF 
+MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. 
+IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY 
+CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, 
+TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE 
+SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE. 
+*/
+/*
+ * SpaceWireSSDTPParser.hh
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#ifndef SPACEWIRESSDTPPARSER_HH_
+#define SPACEWIRESSDTPPARSER_HH_
+
+#include "SpaceWireReceiveBuffer.hh"
+#include "SpaceWireSSDTPModule.hh"
+
+/** Receives packets and TimeCodes extracted by SpaceWireSSDTPParser.
+ */
+class SpaceWireSSDTPParserAction {
+public:
+	virtual ~SpaceWireSSDTPParserAction() {
+	}
+
+public:
+	/** Invoked when a complete packet is parsed. The parser releases the buffer
+	 * after this method returns; call retain() to keep it longer.
+	 * @param[in] buffer a buffer containing the packet and its EOP marker type
+	 */
+	virtual void packetParsed(SpaceWireReceiveBuffer* buffer) = 0;
+
+public:
+	/** Invoked when a TimeCode is parsed.
+	 * @param[in] timecode a received TimeCode value
+	 */
+	virtual void timecodeParsed(uint8_t timecode) = 0;
+};
+
+/** An incremental parser of an SSDTP byte stream.
+ * Unlike SpaceWireSSDTPModule, which reads from a socket and blocks until a packet
+ * is complete, this class accepts bytes in arbitrary chunks (e.g. whatever a
+ * non-blocking read returned) and keeps partially received headers and packets
+ * between calls. Packets are assembled in buffers drawn from a SpaceWireReceiveBufferPool.
+ * An instance is not thread safe; it is expected to be driven by one I/O thread.
+ */
+class SpaceWireSSDTPParser {
+private:
+	enum ParserState {
+		ReceivingHeader, ReceivingData, ReceivingControlCode
+	};
+
+private:
+	SpaceWireReceiveBufferPool* pool;
+	SpaceWireReceiveBuffer* currentBuffer;
+	enum ParserState state;
+	uint8_t header[12];
+	size_t headerSize;
+	uint8_t controlCode[2];
+	size_t controlCodeSize;
+	size_t packetSize;
+	size_t fragmentSize;
+	size_t fragmentReceivedSize;
+	size_t maximumPacketSize;
+
+public:
+	/** Number of complete packets passed to the action. */
+	size_t nParsedPackets;
+	/** Number of TimeCodes passed to the action. */
+	size_t nParsedTimeCodes;
+
+public:
+	/** @param[in] pool a pool from which packet buffers are acquired
+	 * @param[in] maximumPacketSize packets larger than this are reported as SpaceWireSSDTPException::DataSizeTooLarge
+	 */
+	SpaceWireSSDTPParser(SpaceWireReceiveBufferPool* pool, size_t maximumPacketSize = SpaceWireSSDTPModule::BufferSize) {
+		this->pool = pool;
+		this->maximumPacketSize = maximumPacketSize;
+		currentBuffer = NULL;
+		nParsedPackets = 0;
+		nParsedTimeCodes = 0;
+		reset();
+	}
+
+	~SpaceWireSSDTPParser() {
+		reset();
+	}
+
+private:
+	SpaceWireSSDTPParser(const SpaceWireSSDTPParser&);
+	SpaceWireSSDTPParser& operator=(const SpaceWireSSDTPParser&);
+
+public:
+	/** Discards a partially parsed header or packet. */
+	void reset() {
+		if (currentBuffer != NULL) {
+			currentBuffer->release();
+			currentBuffer = NULL;
+		}
+		state = ReceivingHeader;
+		headerSize = 0;
+		controlCodeSize = 0;
+		packetSize = 0;
+		fragmentSize = 0;
+		fragmentReceivedSize = 0;
+	}
+
+public:
+	/** Parses a chunk of the SSDTP stream.
+	 * Complete packets and TimeCodes are passed to the action in stream order.
+	 * @param[in] data bytes of the stream
+	 * @param[in] length number of bytes
+	 * @param[in] action an action invoked for parsed packets and TimeCodes
+	 * @throw SpaceWireSSDTPException TCPSocketError if an undefined flag is found,
+	 * DataSizeTooLarge if a packet exceeds the maximum packet size. The stream cannot
+	 * be parsed further in either case.
+	 */
+	void parse(const uint8_t* data, size_t length, SpaceWireSSDTPParserAction* action) throw (SpaceWireSSDTPException) {
+		size_t index = 0;
+		while (index < length) {
+			switch (state) {
+			case ReceivingHeader: {
+				size_t copySize = min(length - index, 12 - headerSize);
+				memcpy(header + headerSize, data + index, copySize);
+				headerSize += copySize;
+				index += copySize;
+				if (headerSize == 12) {
+					headerReceived(action);
+				}
+				break;
+			}
+			case ReceivingData: {
+				size_t copySize = min(length - index, fragmentSize - fragmentReceivedSize);
+				memcpy(&((*currentBuffer->getVector())[packetSize + fragmentReceivedSize]), data + index, copySize);
+				index += copySize;
+				fragmentDataReceived(copySize, action);
+				break;
+			}
+			case ReceivingControlCode: {
+				size_t copySize = min(length - index, 2 - controlCodeSize);
+				memcpy(controlCode + controlCodeSize, data + index, copySize);
+				controlCodeSize += copySize;
+				index += copySize;
+				if (controlCodeSize == 2) {
+					nParsedTimeCodes++;
+					state = ReceivingHeader;
+					action->timecodeParsed(controlCode[0]);
+				}
+				break;
+			}
+			}
+		}
+	}
+
+public:
+	/** Returns where the rest of the current data fragment should be written,
+	 * so that a large fragment can be read from a socket directly into the packet
+	 * buffer. After writing, call fragmentDataWritten().
+	 * @param[out] length number of bytes remaining in the current fragment
+	 * @return a pointer into the packet buffer, or NULL if a data fragment is not being received
+	 */
+	uint8_t* getFragmentDestination(size_t& length) {
+		if (state != ReceivingData) {
+			length = 0;
+			return NULL;
+		}
+		length = fragmentSize - fragmentReceivedSize;
+		return &((*currentBuffer->getVector())[packetSize + fragmentReceivedSize]);
+	}
+
+public:
+	/** Notifies that length bytes were written to the pointer returned by getFragmentDestination(). */
+	void fragmentDataWritten(size_t length, SpaceWireSSDTPParserAction* action) {
+		fragmentDataReceived(length, action);
+	}
+
+private:
+	static size_t min(size_t a, size_t b) {
+		return (a < b) ? a : b;
+	}
+
+private:
+	void headerReceived(SpaceWireSSDTPParserAction* action) throw (SpaceWireSSDTPException) {
+		headerSize = 0;
+		uint64_t size;
+		SpaceWireSSDTPModule::FrameType frameType = SpaceWireSSDTPModule::decodeHeader(header, size);
+		if (frameType == SpaceWireSSDTPModule::DataFrame) {
+			if (size > maximumPacketSize - packetSize) {
+				throw SpaceWireSSDTPException(SpaceWireSSDTPException::DataSizeTooLarge);
+			}
+			if (currentBuffer == NULL) {
+				currentBuffer = pool->acquire();
+			}
+			fragmentSize = size;
+			fragmentReceivedSize = 0;
+			currentBuffer->getVector()->resize(packetSize + fragmentSize);
+			state = ReceivingData;
+			if (fragmentSize == 0) {
+				fragmentDataReceived(0, action);
+			}
+		} else if (frameType == SpaceWireSSDTPModule::TimeCodeFrame) {
+			controlCodeSize = 0;
+			state = ReceivingControlCode;
+		} else {
+			throw SpaceWireSSDTPException(SpaceWireSSDTPException::TCPSocketError);
+		}
+	}
+
+private:
+	void fragmentDataReceived(size_t length, SpaceWireSSDTPParserAction* action) {
+		fragmentReceivedSize += length;
+		if (fragmentReceivedSize != fragmentSize) {
+			return;
+		}
+		packetSize += fragmentSize;
+		state = ReceivingHeader;
+		if (header[0] == SpaceWireSSDTPModule::DataFlag_Flagmented || packetSize == 0) {
+			//wait for the remaining fragments (empty packets are skipped as SpaceWireSSDTPModule does)
+			return;
+		}
+		currentBuffer->setEOPType(
+				(header[0] == SpaceWireSSDTPModule::DataFlag_Complete_EEP) ? SpaceWireEOPMarker::EEP : SpaceWireEOPMarker::EOP);
+		SpaceWireReceiveBuffer* buffer = currentBuffer;
+		currentBuffer = NULL;
+		packetSize = 0;
+		nParsedPackets++;
+		action->packetParsed(buffer);
+		buffer->release();
+	}
+};
+
+#endif /* SPACEWIRESSDTPPARSER_HH_ */
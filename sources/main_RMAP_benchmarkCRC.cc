@@ -0,0 +1,62 @@
+/*
+ * main_RMAP_benchmarkCRC.cc
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include "CxxUtilities/CxxUtilities.hh"
+#include "RMAPUtilities.hh"
+
+#include <chrono>
+
+using namespace std;
+using namespace CxxUtilities;
+
+typedef uint8_t (*CRCFunction)(uint8_t* data, size_t length, bool useDraftE);
+
+/** Returns throughput in MB/s. */
+double measure(CRCFunction function, std::vector<uint8_t>& bytes, size_t nRepeats, bool useDraftE, uint8_t& crc) {
+	auto start = std::chrono::steady_clock::now();
+	for (size_t i = 0; i < nRepeats; i++) {
+		crc ^= function(&(bytes[0]), bytes.size(), useDraftE);
+	}
+	auto stop = std::chrono::steady_clock::now();
+	double elapsedInSec = std::chrono::duration<double>(stop - start).count();
+	return bytes.size() * nRepeats / elapsedInSec / 1e6;
+}
+
+int main(int argc, char* argv[]) {
+	if (argc > 1 && (string(argv[1]) == "-h" || string(argv[1]) == "--help")) {
+		cerr << "usage   : RMAP_benchmarkCRC (total bytes per measurement; default 256MB)" << endl;
+		cerr << "This program compares throughput of the byte-by-byte table loop and" << endl;
+		cerr << "the slice-by-8 implementation of the RMAP CRC (ECSS and Draft E)." << endl;
+		exit(-1);
+	}
+	size_t totalBytes = 256 * 1024 * 1024;
+	if (argc > 1) {
+		totalBytes = String::toInteger(argv[1]);
+	}
+
+	size_t lengths[] = { 8, 16, 64, 256, 1024, 4096, 65536, 1024 * 1024 };
+	cout << setw(10) << "length" << setw(8) << "CRC" << setw(16) << "byte (MB/s)" << setw(16) << "slice8 (MB/s)"
+			<< setw(10) << "speedup" << endl;
+	for (size_t l = 0; l < sizeof(lengths) / sizeof(size_t); l++) {
+		std::vector<uint8_t> bytes(lengths[l]);
+		for (size_t i = 0; i < bytes.size(); i++) {
+			bytes[i] = (uint8_t) (i * 31 + 7);
+		}
+		size_t nRepeats = totalBytes / bytes.size() + 1;
+		for (size_t draftE = 0; draftE < 2; draftE++) {
+			uint8_t crcByteByByte = 0, crcSliceBy8 = 0;
+			double byteByByte = measure(RMAPUtilities::calculateCRCByteByByte, bytes, nRepeats, draftE, crcByteByByte);
+			double sliceBy8 = measure(RMAPUtilities::calculateCRCSliceBy8, bytes, nRepeats, draftE, crcSliceBy8);
+			if (crcByteByByte != crcSliceBy8) {
+				cerr << "CRC mismatch between the two implementations (length=" << bytes.size() << ")" << endl;
+				exit(-1);
+			}
+			cout << setw(10) << bytes.size() << setw(8) << (draftE ? "DraftE" : "ECSS") << setw(16) << fixed
+					<< setprecision(1) << byteByByte << setw(16) << sliceBy8 << setw(10) << setprecision(2)
+					<< sliceBy8 / byteByByte << endl;
+		}
+	}
+}
@@ -0,0 +1,52 @@
+/*
+ * main_RMAP_compileRMAPTargetNodeDB.cc
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include "CxxUtilities/CxxUtilities.hh"
+#include "RMAP.hh"
+
+using namespace std;
+
+/** Compiles RMAPTargetNode definitions in an XML file into a binary image
+ * which can be loaded via RMAPTargetNodeImage::read() or RMAPTargetNodeImage::constructFromFile().
+ */
+int main(int argc, char* argv[]) {
+	if (argc < 3) {
+		cerr << "usage: main_RMAP_compileRMAPTargetNodeDB (input XML file) (output image file)" << endl;
+		exit(-1);
+	}
+	string xmlFilename(argv[1]);
+	string imageFilename(argv[2]);
+
+	vector<RMAPTargetNode*> rmapTargetNodes;
+	try {
+		rmapTargetNodes = RMAPTargetNode::constructFromXMLFile(xmlFilename);
+	} catch (RMAPTargetNodeException& e) {
+		cerr << "RMAPTargetNodes could not be loaded from " << xmlFilename << " (status=" << e.getStatus() << ")." << endl;
+		exit(-1);
+	} catch (RMAPMemoryObjectException& e) {
+		cerr << "RMAPMemoryObjects could not be loaded from " << xmlFilename << " (status=" << e.getStatus() << ")." << endl;
+		exit(-1);
+	} catch (...) {
+		cerr << "XML file " << xmlFilename << " could not be loaded." << endl;
+		exit(-1);
+	}
+
+	try {
+		RMAPTargetNodeImage::write(imageFilename, rmapTargetNodes, xmlFilename);
+	} catch (RMAPTargetNodeImageException& e) {
+		cerr << "Image file " << imageFilename << " could not be written (" << e.toString() << ")." << endl;
+		exit(-1);
+	}
+
+	size_t nMemoryObjects = 0;
+	for (size_t i = 0; i < rmapTargetNodes.size(); i++) {
+		if (rmapTargetNodes[i] != NULL) {
+			nMemoryObjects += rmapTargetNodes[i]->getMemoryObjects()->size();
+		}
+	}
+	cout << rmapTargetNodes.size() << " RMAPTargetNodes and " << nMemoryObjects << " RMAPMemoryObjects were written to "
+			<< imageFilename << "." << endl;
+}
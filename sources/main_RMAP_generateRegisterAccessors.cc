@@ -0,0 +1,140 @@
+/*
+ * main_RMAP_generateRegisterAccessors.cc
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include "CxxUtilities/CxxUtilities.hh"
+#include "RMAP.hh"
+
+#include <fstream>
+#include <set>
+
+using namespace std;
+
+/** Converts an ID to a C++ identifier. */
+string toIdentifier(string id, string prefixForInvalidIdentifier, set<string>& usedIdentifiers) {
+	string identifier;
+	for (size_t i = 0; i < id.size(); i++) {
+		char c = id[i];
+		identifier += (isalnum((unsigned char) c) || c == '_') ? c : '_';
+	}
+	if (identifier.empty() || isdigit((unsigned char) identifier[0]) || identifier[0] == '_') {
+		identifier = prefixForInvalidIdentifier + identifier;
+	}
+	string uniqueIdentifier = identifier;
+	for (size_t i = 2; usedIdentifiers.count(uniqueIdentifier) != 0; i++) {
+		stringstream ss;
+		ss << identifier << "_" << i;
+		uniqueIdentifier = ss.str();
+	}
+	usedIdentifiers.insert(uniqueIdentifier);
+	return uniqueIdentifier;
+}
+
+string toHex(uint32_t value, int width) {
+	stringstream ss;
+	ss << "0x" << hex << uppercase << right << setw(width) << setfill('0') << value;
+	return ss.str();
+}
+
+string toAccessModeExpression(uint32_t accessMode) {
+	string result;
+	if ((accessMode & RMAPMemoryObject::Readable) != 0) {
+		result += "RMAPMemoryObject::Readable";
+	}
+	if ((accessMode & RMAPMemoryObject::Writable) != 0) {
+		result += (result.empty() ? "" : " | ") + string("RMAPMemoryObject::Writable");
+	}
+	if ((accessMode & RMAPMemoryObject::RMWable) != 0) {
+		result += (result.empty() ? "" : " | ") + string("RMAPMemoryObject::RMWable");
+	}
+	return result.empty() ? "RMAPMemoryObject::NotAccessible" : result;
+}
+
+void generate(ostream& os, string xmlFilename, string headerFilename, vector<RMAPTargetNode*>& rmapTargetNodes) {
+	string baseName = headerFilename.substr(headerFilename.find_last_of('/') + 1);
+	string includeGuard;
+	for (size_t i = 0; i < baseName.size(); i++) {
+		char c = baseName[i];
+		includeGuard += isalnum((unsigned char) c) ? (char) toupper((unsigned char) c) : '_';
+	}
+	includeGuard += "_";
+
+	os << "/*" << endl;
+	os << " * " << baseName << endl;
+	os << " *" << endl;
+	os << " *  Generated from " << xmlFilename << " by main_RMAP_generateRegisterAccessors." << endl;
+	os << " *  Do not edit this file; regenerate it when the XML file is updated." << endl;
+	os << " */" << endl;
+	os << endl;
+	os << "#ifndef " << includeGuard << endl;
+	os << "#define " << includeGuard << endl;
+	os << endl;
+	os << "#include \"RMAPRegister.hh\"" << endl;
+
+	set<string> nodeIdentifiers;
+	for (size_t i = 0; i < rmapTargetNodes.size(); i++) {
+		RMAPTargetNode* rmapTargetNode = rmapTargetNodes[i];
+		if (rmapTargetNode == NULL) {
+			continue;
+		}
+		os << endl;
+		os << "/** Registers of RMAPTargetNode \"" << rmapTargetNode->getID() << "\". */" << endl;
+		os << "class " << toIdentifier(rmapTargetNode->getID(), "Node_", nodeIdentifiers) << " {" << endl;
+		os << "public:" << endl;
+		os << "	static constexpr uint8_t TargetLogicalAddress = "
+				<< toHex(rmapTargetNode->getTargetLogicalAddress(), 2) << ";" << endl;
+		os << "	static constexpr uint8_t DefaultKey = " << toHex(rmapTargetNode->getDefaultKey(), 2) << ";" << endl;
+
+		set<string> memoryObjectIdentifiers;
+		std::map<std::string, RMAPMemoryObject*>* memoryObjects = rmapTargetNode->getMemoryObjects();
+		std::map<std::string, RMAPMemoryObject*>::iterator it = memoryObjects->begin();
+		for (; it != memoryObjects->end(); it++) {
+			RMAPMemoryObject* memoryObject = it->second;
+			uint8_t key = memoryObject->isKeySet() ? memoryObject->getKey() : rmapTargetNode->getDefaultKey();
+			bool increment = memoryObject->isIncrementModeSet() ? memoryObject->isIncrementMode() : true;
+			os << endl;
+			os << "public:" << endl;
+			os << "	/** RMAPMemoryObject \"" << memoryObject->getID() << "\" */" << endl;
+			os << "	typedef RMAPRegister<" << toHex(memoryObject->getAddress(), 8) << ", "
+					<< toHex(memoryObject->getLength(), 2) << ", " << toHex(key, 2) << ", "
+					<< toAccessModeExpression(memoryObject->getAccessMode()) << ", "
+					<< toHex(memoryObject->getExtendedAddress(), 2) << ", " << (increment ? "true" : "false") << "> "
+					<< toIdentifier(memoryObject->getID(), "Register_", memoryObjectIdentifiers) << ";" << endl;
+		}
+		os << "};" << endl;
+	}
+	os << endl;
+	os << "#endif /* " << includeGuard << " */" << endl;
+}
+
+/** Generates a header file which defines an RMAPRegister type for each RMAPMemoryObject
+ * in an RMAPTargetNode XML file.
+ */
+int main(int argc, char* argv[]) {
+	if (argc < 3) {
+		cerr << "usage: main_RMAP_generateRegisterAccessors (input XML file) (output header file)" << endl;
+		exit(-1);
+	}
+	string xmlFilename(argv[1]);
+	string headerFilename(argv[2]);
+
+	vector<RMAPTargetNode*> rmapTargetNodes;
+	try {
+		rmapTargetNodes = RMAPTargetNode::constructFromXMLFile(xmlFilename);
+	} catch (...) {
+		cerr << "XML file " << xmlFilename << " could not be loaded." << endl;
+		exit(-1);
+	}
+
+	ofstream ofs(headerFilename.c_str());
+	if (!ofs.is_open()) {
+		cerr << "Header file " << headerFilename << " could not be opened." << endl;
+		exit(-1);
+	}
+	generate(ofs, xmlFilename, headerFilename, rmapTargetNodes);
+	ofs.close();
+	cout << "Register accessors of " << rmapTargetNodes.size() << " RMAPTargetNodes were written to " << headerFilename
+			<< "." << endl;
+}
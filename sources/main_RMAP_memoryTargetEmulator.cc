@@ -0,0 +1,72 @@
+/*
+ * main_RMAP_memoryTargetEmulator.cc
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include "CxxUtilities/CxxUtilities.hh"
+#include "SpaceWire.hh"
+#include "RMAP.hh"
+
+using namespace CxxUtilities;
+using namespace std;
+
+/** Serves an RMAP address space from memory via SpaceWire-over-TCP (SSDTP).
+ * Initiators connect to the given TCP port as if it were a SpaceWire-to-GigabitEther.
+ */
+int main(int argc, char* argv[]) {
+	if (argc < 3) {
+		cerr << "usage: main_RMAP_memoryTargetEmulator (TCP port) (memory size in MB) [backing file]" << endl;
+		cerr << "Without a backing file, zero-filled anonymous memory is used." << endl;
+		exit(-1);
+	}
+
+	int portNumber = String::toInteger(argv[1]);
+	size_t memorySize = (size_t) String::toInteger(argv[2]) * 1024 * 1024;
+
+	RMAPMemoryTarget* memoryTarget;
+	try {
+		if (argc < 4) {
+			memoryTarget = new RMAPMemoryTarget(0x00000000, memorySize);
+		} else {
+			memoryTarget = new RMAPMemoryTarget(0x00000000, memorySize, argv[3]);
+		}
+	} catch (RMAPMemoryTargetException& e) {
+		cerr << "Memory could not be prepared (" << e.toString() << ")." << endl;
+		exit(-1);
+	}
+	RMAPMemoryAccessAction* action = memoryTarget->getMemoryAccessAction();
+
+	while (true) {
+		cout << "Waiting for a connection on port " << portNumber << "." << endl;
+		SpaceWireIFOverTCP* spwif = new SpaceWireIFOverTCP(portNumber);
+		try {
+			spwif->open();
+		} catch (SpaceWireIFException& e) {
+			cerr << "Could not open port " << portNumber << " (" << e.toString() << ")." << endl;
+			exit(-1);
+		}
+		cout << "Connected." << endl;
+
+		RMAPEngine* rmapEngine = new RMAPEngine(spwif);
+		rmapEngine->addRMAPTarget(memoryTarget);
+		rmapEngine->start();
+
+		Condition c;
+		size_t previousNCommands = 0;
+		while (!rmapEngine->isStopped()) {
+			c.wait(1000);
+			size_t nCommands = action->nReadCommands + action->nWriteCommands + action->nReadModifyWriteCommands;
+			cout << nCommands - previousNCommands << " commands/s (read=" << action->nReadCommands << " write="
+					<< action->nWriteCommands << " rmw=" << action->nReadModifyWriteCommands << " error="
+					<< action->nErrorReplies << ")" << endl;
+			previousNCommands = nCommands;
+		}
+		cout << "Disconnected." << endl;
+		memoryTarget->synchronize();
+		try {
+			spwif->close();
+		} catch (...) {
+		}
+	}
+}
@@ -0,0 +1,132 @@
+/*
+ * RecordingSpaceWireIF.hh
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef RECORDINGSPACEWIREIF_HH_
+#define RECORDINGSPACEWIREIF_HH_
+
+#include "SpaceWireIF.hh"
+
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/** A SpaceWireIF which records sent packets instead of transmitting them.
+ * While the gate is closed, sendMany() blocks, so that packets sent meanwhile wait in the send queues
+ * of RMAPEngine. Nothing is ever received; receive() times out after the timeout duration.
+ */
+class RecordingSpaceWireIF: public SpaceWireIF {
+private:
+	std::mutex mutex;
+	std::condition_variable condition;
+	bool gateIsOpen;
+	size_t nBlockedSendManyCalls;
+
+public:
+	std::vector<std::vector<uint8_t> > sentPackets;
+	std::vector<size_t> batchSizes;
+	//when true, sendMany() throws SpaceWireIFException::Disconnected after the gate is opened
+	bool sendFails;
+
+public:
+	RecordingSpaceWireIF() {
+		gateIsOpen = true;
+		nBlockedSendManyCalls = 0;
+		sendFails = false;
+		timeoutDurationInMicroSec = 1000;
+	}
+
+public:
+	void open() throw (SpaceWireIFException) {
+		state = Opened;
+	}
+
+public:
+	void send(uint8_t* data, size_t length, SpaceWireEOPMarker::EOPType eopType = SpaceWireEOPMarker::EOP)
+			throw (SpaceWireIFException) {
+		std::vector<uint8_t> packet(data, data + length);
+		std::vector<std::vector<uint8_t>*> packets(1, &packet);
+		sendMany(packets, eopType);
+	}
+
+public:
+	void sendMany(std::vector<std::vector<uint8_t>*>& packets, SpaceWireEOPMarker::EOPType eopType =
+			SpaceWireEOPMarker::EOP) throw (SpaceWireIFException) {
+		std::unique_lock<std::mutex> lock(mutex);
+		nBlockedSendManyCalls++;
+		condition.notify_all();
+		while (!gateIsOpen) {
+			condition.wait(lock);
+		}
+		nBlockedSendManyCalls--;
+		if (sendFails) {
+			throw SpaceWireIFException(SpaceWireIFException::Disconnected);
+		}
+		batchSizes.push_back(packets.size());
+		for (size_t i = 0; i < packets.size(); i++) {
+			sentPackets.push_back(*packets[i]);
+		}
+	}
+
+public:
+	void closeGate() {
+		std::lock_guard<std::mutex> guard(mutex);
+		gateIsOpen = false;
+	}
+
+public:
+	void openGate() {
+		std::lock_guard<std::mutex> guard(mutex);
+		gateIsOpen = true;
+		condition.notify_all();
+	}
+
+public:
+	void waitUntilSendManyIsBlocked() {
+		std::unique_lock<std::mutex> lock(mutex);
+		while (nBlockedSendManyCalls == 0) {
+			condition.wait(lock);
+		}
+	}
+
+public:
+	void clear() {
+		std::lock_guard<std::mutex> guard(mutex);
+		sentPackets.clear();
+		batchSizes.clear();
+	}
+
+public:
+	void receive(std::vector<uint8_t>* buffer) throw (SpaceWireIFException) {
+		std::this_thread::sleep_for(std::chrono::microseconds((int64_t) timeoutDurationInMicroSec));
+		throw SpaceWireIFException(SpaceWireIFException::Timeout);
+	}
+
+public:
+	void emitTimecode(uint8_t timeIn, uint8_t controlFlagIn = 0x00) throw (SpaceWireIFException) {
+	}
+
+public:
+	void setTxLinkRate(uint32_t linkRateType) throw (SpaceWireIFException) {
+	}
+
+public:
+	uint32_t getTxLinkRateType() throw (SpaceWireIFException) {
+		throw SpaceWireIFException(SpaceWireIFException::FunctionNotImplemented);
+	}
+
+public:
+	void setTimeoutDuration(double microsecond) throw (SpaceWireIFException) {
+		timeoutDurationInMicroSec = microsecond;
+	}
+
+public:
+	void cancelReceive() {
+	}
+};
+
+#endif /* RECORDINGSPACEWIREIF_HH_ */
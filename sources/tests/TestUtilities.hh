@@ -0,0 +1,36 @@
+/*
+ * TestUtilities.hh
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef TESTUTILITIES_HH_
+#define TESTUTILITIES_HH_
+
+#include <iostream>
+#include <string>
+
+/* Helpers shared by the tests. Each test is built from one source file with its own main(). */
+
+static size_t nErrors = 0;
+
+/** Reports and counts a failed check. */
+static void check(bool condition, std::string message) {
+	if (!condition) {
+		std::cerr << "failed: " << message << std::endl;
+		nErrors++;
+	}
+}
+
+/** Prints the result of the test, and returns the exit status of main(). */
+static int reportTestResult() {
+	if (nErrors == 0) {
+		std::cout << "OK" << std::endl;
+		return 0;
+	} else {
+		std::cout << "NG (" << nErrors << " errors)" << std::endl;
+		return -1;
+	}
+}
+
+#endif /* TESTUTILITIES_HH_ */
@@ -0,0 +1,139 @@
+/*
+ * test_RMAPAsyncInitiator.cc
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+/* Futures returned by RMAPAsyncInitiator are resolved on reply, on timeout, and when the command
+ * could not be sent, and the slot of the window is released in each case.
+ * Link 0 is connected to a memory target, and link 1 to a peer which never replies.
+ */
+
+#include "CxxUtilities/CxxUtilities.hh"
+#include "SpaceWire.hh"
+#include "RMAP.hh"
+#include "TestUtilities.hh"
+
+#include <sys/socket.h>
+#include <thread>
+
+using namespace std;
+
+const uint32_t FirstPortNumber = 10037;
+const size_t NumberOfLinks = 2;
+const double TimeoutDuration = 1000;
+const double ShortTimeoutDuration = 100;
+const size_t NumberOfPipelinedReads = 100;
+
+void checkWindowIsReleased(RMAPAsyncInitiator* asyncInitiator, std::string message) {
+	check(asyncInitiator->getNOutstandingTransactions() == 0, message + " (window slot was not released)");
+}
+
+int main(int argc, char* argv[]) {
+	//pairs of links connected via the loopback interface
+	SpaceWireIFOverTCP* targetSides[NumberOfLinks];
+	SpaceWireIFOverTCP* initiatorSides[NumberOfLinks];
+	for (size_t i = 0; i < NumberOfLinks; i++) {
+		SpaceWireIFOverTCP* targetSide = new SpaceWireIFOverTCP(FirstPortNumber + i);
+		std::thread openThread([&]() {
+			targetSide->open();
+		});
+		CxxUtilities::Condition condition;
+		condition.wait(100);
+		initiatorSides[i] = new SpaceWireIFOverTCP("127.0.0.1", FirstPortNumber + i);
+		initiatorSides[i]->open();
+		openThread.join();
+		targetSides[i] = targetSide;
+	}
+
+	//only link 0 is served by a target engine
+	RMAPEngine* targetEngine = new RMAPEngine(targetSides[0]);
+	RMAPMemoryTarget* memoryTarget = new RMAPMemoryTarget(0, 0x10000);
+	targetEngine->addRMAPTarget(memoryTarget);
+	targetEngine->start();
+	RMAPEngine* initiatorEngine = new RMAPEngine(initiatorSides[0]);
+	initiatorEngine->addSpaceWireIF(initiatorSides[1]);
+	initiatorEngine->start();
+	CxxUtilities::Condition condition;
+	condition.wait(100);
+	size_t nAvailableTransactionIDs = initiatorEngine->getNAvailableTransactionIDs();
+
+	RMAPAsyncInitiator* asyncInitiator = new RMAPAsyncInitiator(initiatorEngine);
+	RMAPTargetNode* rmapTargetNode = new RMAPTargetNode();
+	RMAPTargetNode* silentTargetNode = new RMAPTargetNode();
+	silentTargetNode->setLinkIndex(1);
+
+	//reply
+	uint8_t data[4] = { 0x01, 0x23, 0x45, 0x67 };
+	uint8_t buffer[4] = { 0 };
+	try {
+		asyncInitiator->writeAsync(rmapTargetNode, 0x100, data, sizeof(data), TimeoutDuration).get();
+		asyncInitiator->readAsync(rmapTargetNode, 0x100, sizeof(buffer), buffer, TimeoutDuration).get();
+		check(memcmp(data, buffer, sizeof(data)) == 0, "read data");
+	} catch (...) {
+		check(false, "futures were not resolved with replies");
+	}
+	checkWindowIsReleased(asyncInitiator, "reply");
+
+	//pipelined reads through a narrow window; readAsync() blocks while the window is full
+	asyncInitiator->setWindowSize(4);
+	for (size_t i = 0; i < 0x100; i++) {
+		memoryTarget->getMemory()[0x1000 + i] = (uint8_t) i;
+	}
+	std::vector<uint8_t> readData(NumberOfPipelinedReads);
+	std::vector<std::future<void> > futures;
+	for (size_t i = 0; i < NumberOfPipelinedReads; i++) {
+		futures.push_back(asyncInitiator->readAsync(rmapTargetNode, 0x1000 + i, 1, &readData[i], TimeoutDuration));
+		check(asyncInitiator->getNOutstandingTransactions() <= asyncInitiator->getWindowSize(), "window size");
+	}
+	try {
+		for (size_t i = 0; i < futures.size(); i++) {
+			futures[i].get();
+			check(readData[i] == (uint8_t) i, "pipelined read data");
+		}
+	} catch (...) {
+		check(false, "pipelined reads failed");
+	}
+	checkWindowIsReleased(asyncInitiator, "pipelined reads");
+
+	//timeout
+	try {
+		asyncInitiator->readAsync(silentTargetNode, 0x100, sizeof(buffer), buffer, ShortTimeoutDuration).get();
+		check(false, "read from the silent peer succeeded");
+	} catch (RMAPInitiatorException& e) {
+		check(e.getStatus() == RMAPInitiatorException::Timeout, "timeout was reported as " + e.toString());
+	}
+	checkWindowIsReleased(asyncInitiator, "timeout");
+	check(asyncInitiator->nTimedOutTransactions == 1, "nTimedOutTransactions");
+
+	//send failure; writing to link 1 fails once its initiator side is shut down for writing
+	shutdown(initiatorSides[1]->getDataSocket()->getSocketDescriptor(), SHUT_WR);
+	try {
+		asyncInitiator->writeAsync(silentTargetNode, 0x100, data, sizeof(data), TimeoutDuration).get();
+		check(false, "write via the shut down link succeeded");
+	} catch (RMAPInitiatorException& e) {
+		check(e.getStatus() == RMAPInitiatorException::RMAPTransactionCouldNotBeInitiated,
+				"send failure was reported as " + e.toString());
+	}
+	checkWindowIsReleased(asyncInitiator, "send failure");
+	check(asyncInitiator->nFailedTransactions == 1, "nFailedTransactions");
+
+	//the initiator is still usable, and no transaction ID was leaked
+	try {
+		asyncInitiator->readAsync(rmapTargetNode, 0x100, sizeof(buffer), buffer, TimeoutDuration).get();
+	} catch (...) {
+		check(false, "read after failures");
+	}
+	checkWindowIsReleased(asyncInitiator, "read after failures");
+	check(initiatorEngine->getNAvailableTransactionIDs() == nAvailableTransactionIDs, "transaction IDs were leaked");
+
+	delete asyncInitiator;
+	initiatorEngine->stop();
+	targetEngine->stop();
+	for (size_t i = 0; i < NumberOfLinks; i++) {
+		initiatorSides[i]->close();
+		targetSides[i]->close();
+	}
+
+	return reportTestResult();
+}
@@ -0,0 +1,139 @@
+/*
+ * test_RMAPEngine_failedLink.cc
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#include "CxxUtilities/CxxUtilities.hh"
+#include "SpaceWire.hh"
+#include "RMAP.hh"
+
+#include <sys/socket.h>
+#include <chrono>
+#include <thread>
+
+using namespace std;
+
+const uint32_t FirstPortNumber = 10034;
+const size_t NumberOfLinks = 2;
+const double TimeoutDuration = 1000;
+
+int main(int argc, char* argv[]) {
+	bool ok = true;
+
+	//pairs of links connected via the loopback interface
+	SpaceWireIFOverTCP* targetSides[NumberOfLinks];
+	SpaceWireIFOverTCP* initiatorSides[NumberOfLinks];
+	for (size_t i = 0; i < NumberOfLinks; i++) {
+		SpaceWireIFOverTCP* targetSide = new SpaceWireIFOverTCP(FirstPortNumber + i);
+		std::thread openThread([&]() {
+			targetSide->open();
+		});
+		CxxUtilities::Condition condition;
+		condition.wait(100);
+		initiatorSides[i] = new SpaceWireIFOverTCP("127.0.0.1", FirstPortNumber + i);
+		initiatorSides[i]->open();
+		openThread.join();
+		targetSides[i] = targetSide;
+	}
+
+	RMAPEngine* targetEngine = new RMAPEngine(targetSides[0]);
+	targetEngine->addSpaceWireIF(targetSides[1]);
+	targetEngine->addRMAPTarget(new RMAPMemoryTarget(0, 0x1000));
+	targetEngine->start();
+	RMAPEngine* initiatorEngine = new RMAPEngine(initiatorSides[0]);
+	initiatorEngine->addSpaceWireIF(initiatorSides[1]);
+	initiatorEngine->start();
+	CxxUtilities::Condition condition;
+	condition.wait(100);
+
+	RMAPInitiator* rmapInitiator = new RMAPInitiator(initiatorEngine);
+	RMAPTargetNode* rmapTargetNodes[NumberOfLinks];
+	for (size_t i = 0; i < NumberOfLinks; i++) {
+		rmapTargetNodes[i] = new RMAPTargetNode();
+		rmapTargetNodes[i]->setTargetLogicalAddress(0xFE);
+		rmapTargetNodes[i]->setLinkIndex(i);
+	}
+	uint8_t buffer[4];
+	for (size_t i = 0; i < NumberOfLinks; i++) {
+		try {
+			rmapInitiator->read(rmapTargetNodes[i], 0x100, 4, buffer, TimeoutDuration);
+		} catch (RMAPInitiatorException& e) {
+			cerr << "NG: read via link " << i << " failed before disconnection " << e.toString() << endl;
+			ok = false;
+		} catch (...) {
+			cerr << "NG: read via link " << i << " failed before disconnection" << endl;
+			ok = false;
+		}
+	}
+
+	//disconnect the secondary link from the target side; the socket is shut down rather than closed,
+	//since the receive thread of the target engine is still reading from it
+	shutdown(targetSides[1]->getDataSocket()->getSocketDescriptor(), SHUT_RDWR);
+	std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+	while (!initiatorEngine->isLinkFailed(1) && std::chrono::steady_clock::now() < deadline) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	if (!initiatorEngine->isLinkFailed(1) || initiatorEngine->isLinkFailed(0) || initiatorEngine->nFailedLinks != 1) {
+		cerr << "NG: the failed link was not reported (nFailedLinks=" << initiatorEngine->nFailedLinks << ")" << endl;
+		ok = false;
+	}
+
+	//a transaction via the failed link is rejected immediately instead of timing out
+	std::chrono::steady_clock::time_point started = std::chrono::steady_clock::now();
+	try {
+		rmapInitiator->read(rmapTargetNodes[1], 0x100, 4, buffer, TimeoutDuration);
+		cerr << "NG: read via the failed link succeeded" << endl;
+		ok = false;
+	} catch (RMAPInitiatorException& e) {
+		if (e.getStatus() != RMAPInitiatorException::RMAPTransactionCouldNotBeInitiated) {
+			cerr << "NG: read via the failed link threw " << e.toString() << endl;
+			ok = false;
+		}
+	}
+	double elapsedInMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+	if (elapsedInMs > TimeoutDuration / 2) {
+		cerr << "NG: read via the failed link took " << elapsedInMs << " ms" << endl;
+		ok = false;
+	}
+	RMAPTransaction transaction;
+	RMAPPacket commandPacket;
+	commandPacket.setCommand();
+	commandPacket.setRead();
+	commandPacket.setReplyMode();
+	commandPacket.setTargetLogicalAddress(0xFE);
+	commandPacket.setAddress(0x100);
+	commandPacket.setLength(4);
+	transaction.commandPacket = &commandPacket;
+	transaction.linkIndex = 1;
+	try {
+		initiatorEngine->initiateTransaction(transaction);
+		cerr << "NG: a transaction was initiated via the failed link" << endl;
+		ok = false;
+	} catch (RMAPEngineException& e) {
+		if (e.getStatus() != RMAPEngineException::LinkHasFailed) {
+			cerr << "NG: initiateTransaction() threw " << e.toString() << endl;
+			ok = false;
+		}
+	}
+
+	//the primary link is still served
+	try {
+		rmapInitiator->read(rmapTargetNodes[0], 0x100, 4, buffer, TimeoutDuration);
+	} catch (...) {
+		cerr << "NG: read via the primary link failed after the secondary link failed" << endl;
+		ok = false;
+	}
+
+	initiatorEngine->stop();
+	targetEngine->stop();
+	for (size_t i = 0; i < NumberOfLinks; i++) {
+		initiatorSides[i]->close();
+	}
+	for (size_t i = 0; i < NumberOfLinks; i++) {
+		targetSides[i]->close();
+	}
+
+	cout << (ok ? "OK" : "NG") << endl;
+	return ok ? 0 : -1;
+}
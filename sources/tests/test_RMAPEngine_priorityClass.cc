@@ -0,0 +1,134 @@
+/*
+ * test_RMAPEngine_priorityClass.cc
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+/* Packets queued in the send queues of the priority classes are written in weighted round-robin order,
+ * starting from the high priority class, and counted in the statistics of their class.
+ */
+
+#include "CxxUtilities/CxxUtilities.hh"
+#include "SpaceWire.hh"
+#include "RMAP.hh"
+#include "TestUtilities.hh"
+#include "RecordingSpaceWireIF.hh"
+
+#include <thread>
+
+using namespace std;
+
+const size_t NumberOfPacketsPerClass = 10;
+const uint8_t BlockingPacketMarker = 0xFF;
+
+/** Returns packets of the form {class, index} in the order expected from weighted round robin
+ * over queues holding nPacketsPerClass packets each.
+ */
+std::vector<std::vector<uint8_t> > simulateWeightedRoundRobin(RMAPEngine* rmapEngine, size_t nPacketsPerClass) {
+	std::vector<std::vector<uint8_t> > order;
+	size_t nTaken[RMAPTransaction::NumberOfPriorityClasses] = { 0 };
+	while (order.size() < RMAPTransaction::NumberOfPriorityClasses * nPacketsPerClass) {
+		for (size_t c = 0; c < RMAPTransaction::NumberOfPriorityClasses; c++) {
+			for (size_t n = 0; n < rmapEngine->getPriorityClassWeight(c) && nTaken[c] < nPacketsPerClass; n++) {
+				order.push_back(std::vector<uint8_t>( { (uint8_t) c, (uint8_t) nTaken[c] }));
+				nTaken[c]++;
+			}
+		}
+	}
+	return order;
+}
+
+/** Queues packets of the form {class, index} behind a blocking packet, bulk first and high priority last,
+ * and returns the packets in the order they were written.
+ */
+std::vector<std::vector<uint8_t> > sendPacketsOfAllClasses(RMAPEngine* rmapEngine, RecordingSpaceWireIF* spwif,
+		size_t nPacketsPerClass) {
+	uint32_t classes[] = { RMAPTransaction::BulkPriorityClass, RMAPTransaction::NormalPriorityClass,
+			RMAPTransaction::HighPriorityClass };
+	std::vector<std::vector<uint8_t> > packets;
+	packets.push_back(std::vector<uint8_t>( { BlockingPacketMarker, 0 }));
+	for (size_t i = 0; i < RMAPTransaction::NumberOfPriorityClasses; i++) {
+		for (size_t n = 0; n < nPacketsPerClass; n++) {
+			packets.push_back(std::vector<uint8_t>( { (uint8_t) classes[i], (uint8_t) n }));
+		}
+	}
+	spwif->clear();
+	spwif->closeGate();
+	std::vector<std::thread> threads;
+	for (size_t i = 0; i < packets.size(); i++) {
+		uint32_t priorityClass = (i == 0) ? (uint32_t) RMAPTransaction::NormalPriorityClass : packets[i][0];
+		size_t depth = rmapEngine->getSendQueueDepth(priorityClass);
+		threads.push_back(std::thread([&, i, priorityClass]() {
+			rmapEngine->sendPacket(&packets[i], priorityClass);
+		}));
+		if (i == 0) {
+			spwif->waitUntilSendManyIsBlocked();
+		} else {
+			while (rmapEngine->getSendQueueDepth(priorityClass) != depth + 1) {
+				std::this_thread::yield();
+			}
+		}
+	}
+	spwif->openGate();
+	for (size_t i = 0; i < threads.size(); i++) {
+		threads[i].join();
+	}
+	std::vector<std::vector<uint8_t> > sentPackets(spwif->sentPackets.begin() + 1, spwif->sentPackets.end());
+	return sentPackets;
+}
+
+int main(int argc, char* argv[]) {
+	RecordingSpaceWireIF* spwif = new RecordingSpaceWireIF();
+	spwif->open();
+	RMAPEngine* rmapEngine = new RMAPEngine(spwif);
+
+	//default weights
+	check(rmapEngine->getPriorityClassWeight(RMAPTransaction::HighPriorityClass) == RMAPEngine::DefaultHighPriorityClassWeight
+			&& rmapEngine->getPriorityClassWeight(RMAPTransaction::NormalPriorityClass) == RMAPEngine::DefaultNormalPriorityClassWeight
+			&& rmapEngine->getPriorityClassWeight(RMAPTransaction::BulkPriorityClass) == RMAPEngine::DefaultBulkPriorityClassWeight,
+			"default weights");
+	check(sendPacketsOfAllClasses(rmapEngine, spwif, NumberOfPacketsPerClass)
+			== simulateWeightedRoundRobin(rmapEngine, NumberOfPacketsPerClass), "order with the default weights");
+
+	//equal weights; a weight of 0 is raised to 1 so that the class is not starved
+	rmapEngine->setPriorityClassWeight(RMAPTransaction::HighPriorityClass, 1);
+	rmapEngine->setPriorityClassWeight(RMAPTransaction::NormalPriorityClass, 1);
+	rmapEngine->setPriorityClassWeight(RMAPTransaction::BulkPriorityClass, 0);
+	check(rmapEngine->getPriorityClassWeight(RMAPTransaction::BulkPriorityClass) == 1, "weight of 0");
+	std::vector<std::vector<uint8_t> > expected = simulateWeightedRoundRobin(rmapEngine, NumberOfPacketsPerClass);
+	check(expected[0][0] == RMAPTransaction::HighPriorityClass && expected[1][0] == RMAPTransaction::NormalPriorityClass
+			&& expected[2][0] == RMAPTransaction::BulkPriorityClass, "expected order with equal weights");
+	check(sendPacketsOfAllClasses(rmapEngine, spwif, NumberOfPacketsPerClass) == expected, "order with equal weights");
+
+	//statistics; each class had NumberOfPacketsPerClass packets queued twice, plus the blocking packets in normal
+	RMAPEngine::SendQueueStatistics high = rmapEngine->getSendQueueStatistics(RMAPTransaction::HighPriorityClass);
+	RMAPEngine::SendQueueStatistics normal = rmapEngine->getSendQueueStatistics(RMAPTransaction::NormalPriorityClass);
+	RMAPEngine::SendQueueStatistics bulk = rmapEngine->getSendQueueStatistics(RMAPTransaction::BulkPriorityClass);
+	check(high.nSentPackets == 2 * NumberOfPacketsPerClass && normal.nSentPackets == 2 * (NumberOfPacketsPerClass + 1)
+			&& bulk.nSentPackets == 2 * NumberOfPacketsPerClass, "nSentPackets");
+	check(high.maxDepth == NumberOfPacketsPerClass && bulk.maxDepth == NumberOfPacketsPerClass, "maxDepth");
+	check(high.depth == 0 && normal.depth == 0 && bulk.depth == 0, "depth after sending");
+
+	//a packet with an invalid priority class is queued as bulk
+	std::vector<uint8_t> blockingPacket( { BlockingPacketMarker, 0 });
+	std::vector<uint8_t> packet( { 0x12, 0x34 });
+	spwif->closeGate();
+	std::thread blockingThread([&]() {
+		rmapEngine->sendPacket(&blockingPacket);
+	});
+	spwif->waitUntilSendManyIsBlocked();
+	std::thread invalidClassThread([&]() {
+		rmapEngine->sendPacket(&packet, RMAPTransaction::NumberOfPriorityClasses + 5);
+	});
+	while (rmapEngine->getSendQueueDepth(RMAPTransaction::BulkPriorityClass) != 1) {
+		std::this_thread::yield();
+	}
+	spwif->openGate();
+	blockingThread.join();
+	invalidClassThread.join();
+	check(spwif->sentPackets.back() == packet, "packet with an invalid priority class was not sent");
+	check(rmapEngine->getSendQueueStatistics(RMAPTransaction::NumberOfPriorityClasses + 5).nSentPackets
+			== 2 * NumberOfPacketsPerClass + 1, "statistics of an invalid priority class");
+
+	return reportTestResult();
+}
@@ -0,0 +1,119 @@
+/*
+ * test_RMAPEngine_sendBatching.cc
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+/* Packets sent by concurrent RMAPEngine::sendPacket() calls while a write is in progress are combined
+ * into one SpaceWireIF::sendMany() call, limited by MaximumPacketsPerSendBatch and MaximumBytesPerSendBatch,
+ * and a failed write is reported to every thread whose packet was in the batch.
+ */
+
+#include "CxxUtilities/CxxUtilities.hh"
+#include "SpaceWire.hh"
+#include "RMAP.hh"
+#include "TestUtilities.hh"
+#include "RecordingSpaceWireIF.hh"
+
+#include <mutex>
+#include <thread>
+
+using namespace std;
+
+/** Sends packets while the first one blocks in sendMany(), so that the others are queued,
+ * and returns the number of sendPacket() calls which threw an exception.
+ */
+size_t sendQueuedPackets(RMAPEngine* rmapEngine, RecordingSpaceWireIF* spwif, std::vector<std::vector<uint8_t> >& packets) {
+	size_t nFailedSends = 0;
+	std::mutex failureMutex;
+	std::vector<std::thread> threads;
+	spwif->closeGate();
+	for (size_t i = 0; i < packets.size(); i++) {
+		threads.push_back(std::thread([&, i]() {
+			try {
+				rmapEngine->sendPacket(&packets[i]);
+			} catch (RMAPEngineException& e) {
+				std::lock_guard<std::mutex> guard(failureMutex);
+				nFailedSends++;
+			}
+		}));
+		if (i == 0) {
+			spwif->waitUntilSendManyIsBlocked();
+		} else {
+			while (rmapEngine->getSendQueueDepth(RMAPTransaction::NormalPriorityClass) != i) {
+				std::this_thread::yield();
+			}
+		}
+	}
+	spwif->openGate();
+	for (size_t i = 0; i < threads.size(); i++) {
+		threads[i].join();
+	}
+	return nFailedSends;
+}
+
+std::vector<std::vector<uint8_t> > createPackets(size_t nPackets, size_t packetSize) {
+	std::vector<std::vector<uint8_t> > packets;
+	for (size_t i = 0; i < nPackets; i++) {
+		std::vector<uint8_t> packet(packetSize, (uint8_t) i);
+		packet[0] = (uint8_t) (i / 0x100);
+		packets.push_back(packet);
+	}
+	return packets;
+}
+
+bool areAllSentOnce(RecordingSpaceWireIF* spwif, std::vector<std::vector<uint8_t> >& packets) {
+	if (spwif->sentPackets.size() != packets.size()) {
+		return false;
+	}
+	for (size_t i = 0; i < packets.size(); i++) {
+		if (std::count(spwif->sentPackets.begin(), spwif->sentPackets.end(), packets[i]) != 1) {
+			return false;
+		}
+	}
+	return true;
+}
+
+int main(int argc, char* argv[]) {
+	RecordingSpaceWireIF* spwif = new RecordingSpaceWireIF();
+	spwif->open();
+	RMAPEngine* rmapEngine = new RMAPEngine(spwif);
+	RMAPEngine::Link* link = rmapEngine->getLink(0);
+
+	//packets queued during a write are written with the next sendMany() call
+	std::vector<std::vector<uint8_t> > packets = createPackets(21, 16);
+	check(sendQueuedPackets(rmapEngine, spwif, packets) == 0, "sendPacket() failed");
+	check(areAllSentOnce(spwif, packets), "queued packets were not sent exactly once");
+	check(spwif->batchSizes == std::vector<size_t>( { 1, 20 }), "queued packets were not combined");
+	check(link->nSentPackets == 21 && link->nSendBatches == 2 && link->maxSendBatchSize == 20, "link counters");
+
+	//a batch is closed after MaximumPacketsPerSendBatch packets
+	spwif->clear();
+	packets = createPackets(RMAPEngine::MaximumPacketsPerSendBatch + 3, 16);
+	check(sendQueuedPackets(rmapEngine, spwif, packets) == 0, "sendPacket() failed");
+	check(areAllSentOnce(spwif, packets), "packets of a full batch were not sent exactly once");
+	check(spwif->batchSizes == std::vector<size_t>( { 1, RMAPEngine::MaximumPacketsPerSendBatch, 2 }),
+			"batch was not limited by the number of packets");
+
+	//a batch is closed once it reaches MaximumBytesPerSendBatch
+	spwif->clear();
+	packets = createPackets(4, RMAPEngine::MaximumBytesPerSendBatch / 2 + 1);
+	check(sendQueuedPackets(rmapEngine, spwif, packets) == 0, "sendPacket() failed");
+	check(areAllSentOnce(spwif, packets), "large packets were not sent exactly once");
+	check(spwif->batchSizes == std::vector<size_t>( { 1, 2, 1 }), "batch was not limited by the number of bytes");
+
+	//a failed write is reported to all the threads whose packets were in the batch
+	spwif->clear();
+	spwif->sendFails = true;
+	packets = createPackets(6, 16);
+	check(sendQueuedPackets(rmapEngine, spwif, packets) == packets.size(), "failed write was not reported");
+	spwif->sendFails = false;
+	try {
+		rmapEngine->sendPacket(&packets[0]);
+	} catch (...) {
+		check(false, "sendPacket() after a failed write");
+	}
+	check(spwif->sentPackets.size() == 1, "packets of the failed write were sent");
+
+	return reportTestResult();
+}
@@ -0,0 +1,238 @@
+/*
+ * test_RMAPEngine_targetDispatch.cc
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+/* RMAP commands are processed by the worker threads of RMAPEngine, or in the receive thread if the
+ * action allows inline processing or there is no worker. While all the workers are busy and the command
+ * queue is full, further commands are rejected and counted.
+ */
+
+#include "CxxUtilities/CxxUtilities.hh"
+#include "SpaceWire.hh"
+#include "RMAP.hh"
+#include "TestUtilities.hh"
+
+#include <chrono>
+#include <set>
+#include <thread>
+
+using namespace std;
+
+const uint32_t FirstPortNumber = 10054;
+const uint32_t WorkerAddress = 0x1000;
+const uint32_t InlineAddress = 0x2000;
+const size_t NumberOfWorkers = 3;
+const size_t QueueCapacity = 2;
+const size_t NumberOfRejectedCommands = 3;
+const double WaitTimeoutInMs = 5000;
+
+/** Records the threads which processed commands, and blocks them while the gate is closed. */
+class GatedAccessAction: public RMAPTargetAccessAction {
+private:
+	std::mutex mutex;
+	std::condition_variable condition;
+	bool gateIsOpen;
+	bool inlineProcessingIsAllowed;
+
+public:
+	size_t nBlocked;
+	size_t nProcessed;
+	std::set<std::thread::id> threadIDs;
+
+public:
+	GatedAccessAction(bool inlineProcessingIsAllowed) :
+			gateIsOpen(true), inlineProcessingIsAllowed(inlineProcessingIsAllowed), nBlocked(0), nProcessed(0) {
+	}
+
+public:
+	void processTransaction(RMAPTransaction* rmapTransaction) throw (RMAPTargetAccessActionException) {
+		std::unique_lock<std::mutex> lock(mutex);
+		threadIDs.insert(std::this_thread::get_id());
+		nBlocked++;
+		condition.notify_all();
+		while (!gateIsOpen) {
+			condition.wait(lock);
+		}
+		nBlocked--;
+		nProcessed++;
+		condition.notify_all();
+	}
+
+public:
+	bool isInlineProcessingAllowed() {
+		return inlineProcessingIsAllowed;
+	}
+
+public:
+	void closeGate() {
+		std::lock_guard<std::mutex> guard(mutex);
+		gateIsOpen = false;
+	}
+
+public:
+	void openGate() {
+		std::lock_guard<std::mutex> guard(mutex);
+		gateIsOpen = true;
+		condition.notify_all();
+	}
+
+public:
+	/** Waits until nBlocked and nProcessed reach the values; returns false on timeout. */
+	bool waitFor(size_t nBlocked, size_t nProcessed) {
+		std::unique_lock<std::mutex> lock(mutex);
+		return condition.wait_for(lock, std::chrono::milliseconds((int64_t) WaitTimeoutInMs), [&]() {
+			return this->nBlocked == nBlocked && this->nProcessed == nProcessed;
+		});
+	}
+
+public:
+	std::set<std::thread::id> getThreadIDs() {
+		std::lock_guard<std::mutex> guard(mutex);
+		return threadIDs;
+	}
+};
+
+/** Waits until a counter reaches a value; returns false on timeout. */
+bool waitUntil(std::atomic<size_t>& counter, size_t value) {
+	std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now()
+			+ std::chrono::milliseconds((int64_t) WaitTimeoutInMs);
+	while (counter != value) {
+		if (std::chrono::steady_clock::now() > deadline) {
+			return false;
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	return true;
+}
+
+/** Sends a write command without reply, which is not replied by the target. */
+void sendWriteCommand(SpaceWireIF* spwif, uint32_t address) {
+	RMAPPacket packet;
+	packet.setCommand();
+	packet.setWrite();
+	packet.setNoReplyMode();
+	packet.setTargetLogicalAddress(0xFE);
+	packet.setAddress(address);
+	std::vector<uint8_t> data( { 0x01, 0x02, 0x03, 0x04 });
+	packet.setData(data);
+	packet.constructPacket();
+	std::vector<uint8_t>* bytes = packet.getPacketBufferPointer();
+	spwif->send(&(bytes->at(0)), bytes->size());
+}
+
+/** Connects a pair of links via the loopback interface. */
+void connect(uint32_t portNumber, SpaceWireIFOverTCP*& targetSide, SpaceWireIFOverTCP*& initiatorSide) {
+	targetSide = new SpaceWireIFOverTCP(portNumber);
+	SpaceWireIFOverTCP* server = targetSide;
+	std::thread openThread([&]() {
+		server->open();
+	});
+	CxxUtilities::Condition condition;
+	condition.wait(100);
+	initiatorSide = new SpaceWireIFOverTCP("127.0.0.1", portNumber);
+	initiatorSide->open();
+	openThread.join();
+}
+
+RMAPEngine* createTargetEngine(SpaceWireIF* spwif, size_t nWorkers, GatedAccessAction* workerAction,
+		GatedAccessAction* inlineAction) {
+	RMAPTarget* target = new RMAPTarget();
+	target->addAddressRangeAndAssociatedAction(new RMAPAddressRange(WorkerAddress, WorkerAddress + 0xFFF),
+			workerAction);
+	target->addAddressRangeAndAssociatedAction(new RMAPAddressRange(InlineAddress, InlineAddress + 0xFFF),
+			inlineAction);
+	RMAPEngine* rmapEngine = new RMAPEngine(spwif);
+	rmapEngine->setNumberOfRMAPTargetProcessThreads(nWorkers);
+	rmapEngine->setRMAPTargetCommandQueueCapacity(QueueCapacity);
+	rmapEngine->addRMAPTarget(target);
+	rmapEngine->start();
+	return rmapEngine;
+}
+
+void testWorkers() {
+	SpaceWireIFOverTCP* targetSide;
+	SpaceWireIFOverTCP* initiatorSide;
+	connect(FirstPortNumber, targetSide, initiatorSide);
+	GatedAccessAction* workerAction = new GatedAccessAction(false);
+	GatedAccessAction* inlineAction = new GatedAccessAction(true);
+	RMAPEngine* rmapEngine = createTargetEngine(targetSide, NumberOfWorkers, workerAction, inlineAction);
+
+	//an inline command is processed in the receive thread
+	sendWriteCommand(initiatorSide, InlineAddress);
+	check(inlineAction->waitFor(0, 1), "inline command was not processed");
+	std::thread::id receiveThreadID = *inlineAction->getThreadIDs().begin();
+
+	//worker dispatch: each blocked command occupies a distinct worker
+	workerAction->closeGate();
+	for (size_t i = 0; i < NumberOfWorkers; i++) {
+		sendWriteCommand(initiatorSide, WorkerAddress);
+	}
+	check(workerAction->waitFor(NumberOfWorkers, 0), "commands were not dispatched to all the workers");
+	std::set<std::thread::id> workerThreadIDs = workerAction->getThreadIDs();
+	check(workerThreadIDs.size() == NumberOfWorkers, "commands were processed by fewer threads than workers");
+	check(workerThreadIDs.count(receiveThreadID) == 0, "a queued command was processed in the receive thread");
+
+	//inline commands are processed while all the workers are busy
+	sendWriteCommand(initiatorSide, InlineAddress);
+	check(inlineAction->waitFor(0, 2), "inline command was not processed while the workers were busy");
+	check(inlineAction->getThreadIDs().size() == 1, "inline commands were processed by different threads");
+
+	//backpressure: the queue fills up, and further commands are rejected
+	for (size_t i = 0; i < QueueCapacity + NumberOfRejectedCommands; i++) {
+		sendWriteCommand(initiatorSide, WorkerAddress);
+	}
+	check(waitUntil(rmapEngine->nRMAPTargetCommandsRejectedDueToFullQueue, NumberOfRejectedCommands),
+			"commands to a full queue were not rejected");
+	check(rmapEngine->getRMAPTargetCommandQueueDepth() == QueueCapacity, "queue depth");
+	check(rmapEngine->maxRMAPTargetCommandQueueDepth == QueueCapacity, "maxRMAPTargetCommandQueueDepth");
+	check(rmapEngine->nErrorneousCommandPackets == NumberOfRejectedCommands,
+			"rejected commands were not counted as discarded");
+
+	//queued commands are processed after the workers are released
+	workerAction->openGate();
+	check(workerAction->waitFor(0, NumberOfWorkers + QueueCapacity), "queued commands were not processed");
+	check(rmapEngine->nRMAPTargetCommandsQueued == NumberOfWorkers + QueueCapacity, "nRMAPTargetCommandsQueued");
+	check(rmapEngine->nRMAPTargetCommandsProcessedInline == 2, "nRMAPTargetCommandsProcessedInline");
+	check(workerAction->getThreadIDs().size() == NumberOfWorkers,
+			"commands were processed by a thread outside the pool");
+
+	rmapEngine->stop();
+	initiatorSide->close();
+	targetSide->close();
+}
+
+void testWithoutWorkers() {
+	SpaceWireIFOverTCP* targetSide;
+	SpaceWireIFOverTCP* initiatorSide;
+	connect(FirstPortNumber + 1, targetSide, initiatorSide);
+	GatedAccessAction* workerAction = new GatedAccessAction(false);
+	GatedAccessAction* inlineAction = new GatedAccessAction(true);
+	RMAPEngine* rmapEngine = createTargetEngine(targetSide, 0, workerAction, inlineAction);
+
+	//without workers, every command is processed in the receive thread, and nothing is rejected
+	for (size_t i = 0; i < QueueCapacity + NumberOfRejectedCommands; i++) {
+		sendWriteCommand(initiatorSide, WorkerAddress);
+	}
+	sendWriteCommand(initiatorSide, InlineAddress);
+	check(inlineAction->waitFor(0, 1), "inline command was not processed");
+	check(workerAction->waitFor(0, QueueCapacity + NumberOfRejectedCommands), "commands were not processed");
+	std::set<std::thread::id> threadIDs = workerAction->getThreadIDs();
+	check(threadIDs.size() == 1 && threadIDs == inlineAction->getThreadIDs(),
+			"commands were not processed in the receive thread");
+	check(rmapEngine->nRMAPTargetCommandsProcessedInline == QueueCapacity + NumberOfRejectedCommands + 1
+			&& rmapEngine->nRMAPTargetCommandsQueued == 0 && rmapEngine->nRMAPTargetCommandsRejectedDueToFullQueue == 0,
+			"counters without workers");
+
+	rmapEngine->stop();
+	initiatorSide->close();
+	targetSide->close();
+}
+
+int main(int argc, char* argv[]) {
+	testWorkers();
+	testWithoutWorkers();
+
+	return reportTestResult();
+}
@@ -0,0 +1,130 @@
+/*
+ * test_RMAPInitiator_range.cc
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+/* readRange()/writeRange() split a memory range into chunks of the maximum data length per transaction
+ * of the target node, keep a window of chunks in flight, and report the first failure.
+ */
+
+#include "CxxUtilities/CxxUtilities.hh"
+#include "SpaceWire.hh"
+#include "RMAP.hh"
+#include "TestUtilities.hh"
+
+#include <sstream>
+#include <thread>
+
+using namespace std;
+
+const uint32_t PortNumber = 10039;
+const uint32_t MemorySize = 0x40000;
+const uint32_t ChunkSize = 1024;
+const uint32_t RangeAddress = 5;
+const size_t RangeLength = 100 * ChunkSize + 13;
+const double ShortTimeoutDuration = 200;
+const size_t NumberOfZeroTimeoutReads = 100;
+
+int main(int argc, char* argv[]) {
+	//target and initiator connected via the loopback interface
+	SpaceWireIFOverTCP* targetSide = new SpaceWireIFOverTCP(PortNumber);
+	std::thread openThread([&]() {
+		targetSide->open();
+	});
+	CxxUtilities::Condition condition;
+	condition.wait(100);
+	SpaceWireIFOverTCP* initiatorSide = new SpaceWireIFOverTCP("127.0.0.1", PortNumber);
+	initiatorSide->open();
+	openThread.join();
+
+	RMAPEngine* targetEngine = new RMAPEngine(targetSide);
+	RMAPMemoryTarget* memoryTarget = new RMAPMemoryTarget(0, MemorySize);
+	targetEngine->addRMAPTarget(memoryTarget);
+	targetEngine->start();
+	RMAPEngine* initiatorEngine = new RMAPEngine(initiatorSide);
+	initiatorEngine->start();
+	condition.wait(100);
+
+	RMAPInitiator* rmapInitiator = new RMAPInitiator(initiatorEngine);
+	RMAPTargetNode* rmapTargetNode = new RMAPTargetNode();
+	rmapTargetNode->setMaximumDataLengthPerTransaction(ChunkSize);
+	uint8_t* memory = memoryTarget->getMemory();
+	for (size_t i = 0; i < MemorySize; i++) {
+		memory[i] = (uint8_t) (i * 7);
+	}
+	size_t nChunks = (RangeLength + ChunkSize - 1) / ChunkSize;
+
+	try {
+		//read into a buffer, and into a stream
+		std::vector<uint8_t> buffer(RangeLength);
+		RMAPRangeTransferStatistics statistics = rmapInitiator->readRange(rmapTargetNode, RangeAddress, RangeLength,
+				&buffer[0]);
+		check(memcmp(&buffer[0], memory + RangeAddress, RangeLength) == 0, "readRange() data");
+		check(statistics.nBytes == RangeLength && statistics.nTransactions == nChunks, "readRange() statistics");
+		std::stringstream ss;
+		rmapInitiator->readRange(rmapTargetNode, RangeAddress, RangeLength, ss);
+		check(ss.str() == std::string((char*) memory + RangeAddress, RangeLength), "readRange() to a stream");
+
+		//write from a buffer, and from a stream
+		for (size_t i = 0; i < RangeLength; i++) {
+			buffer[i] = (uint8_t) (i * 3);
+		}
+		statistics = rmapInitiator->writeRange(rmapTargetNode, RangeAddress, &buffer[0], RangeLength);
+		check(memcmp(&buffer[0], memory + RangeAddress, RangeLength) == 0, "writeRange() data");
+		check(statistics.nBytes == RangeLength && statistics.nTransactions == nChunks, "writeRange() statistics");
+		std::stringstream is(std::string(RangeLength, 'x'));
+		rmapInitiator->writeRange(rmapTargetNode, RangeAddress, is, RangeLength);
+		check(memory[RangeAddress] == 'x' && memory[RangeAddress + RangeLength - 1] == 'x',
+				"writeRange() from a stream");
+
+		//one chunk in flight at a time
+		rmapInitiator->getAsyncInitiator()->setWindowSize(1);
+		rmapInitiator->readRange(rmapTargetNode, RangeAddress, RangeLength, &buffer[0]);
+		check(buffer[0] == 'x' && buffer[RangeLength - 1] == 'x', "readRange() with a window of 1");
+		rmapInitiator->getAsyncInitiator()->setWindowSize(RMAPAsyncInitiator::DefaultWindowSize);
+	} catch (...) {
+		check(false, "range transfer failed");
+	}
+
+	//chunks beyond the memory target are not answered, and the timeout is reported
+	//after the outstanding chunks complete
+	try {
+		std::vector<uint8_t> buffer(4 * ChunkSize);
+		rmapInitiator->readRange(rmapTargetNode, MemorySize - 2 * ChunkSize, buffer.size(), &buffer[0],
+				ShortTimeoutDuration);
+		check(false, "readRange() beyond the memory target succeeded");
+	} catch (RMAPInitiatorException& e) {
+		check(e.getStatus() == RMAPInitiatorException::Timeout, "failed chunk was reported as " + e.toString());
+	}
+	check(rmapInitiator->getAsyncInitiator()->getNOutstandingTransactions() == 0, "chunks left outstanding");
+
+	//a transaction which expires while it is being initiated is reported as Timeout
+	for (size_t i = 0; i < NumberOfZeroTimeoutReads; i++) {
+		uint8_t data[4];
+		try {
+			rmapInitiator->read(rmapTargetNode, MemorySize, sizeof(data), data, 0);
+			check(false, "read() beyond the memory target succeeded");
+		} catch (RMAPInitiatorException& e) {
+			check(e.getStatus() == RMAPInitiatorException::Timeout, "read() with a timeout of 0 was reported as "
+					+ e.toString());
+		}
+	}
+
+	//a stream which ends before the range
+	try {
+		std::stringstream is(std::string(10, 'y'));
+		rmapInitiator->writeRange(rmapTargetNode, RangeAddress, is, RangeLength);
+		check(false, "writeRange() from a short stream succeeded");
+	} catch (RMAPInitiatorException& e) {
+		check(e.getStatus() == RMAPInitiatorException::Aborted, "short stream was reported as " + e.toString());
+	}
+
+	delete rmapInitiator;
+	initiatorEngine->stop();
+	targetEngine->stop();
+	initiatorSide->close();
+	targetSide->close();
+
+	return reportTestResult();
+}
@@ -0,0 +1,126 @@
+/*
+ * test_RMAPInitiator_teardown.cc
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+/* RMAPInitiator can be deleted right after a range transfer returns, while the receive or timeout
+ * thread of RMAPEngine is still completing the last chunk, and while transactions of its
+ * RMAPAsyncInitiator are outstanding. Intended to be run also with -fsanitize=address or thread.
+ * Link 0 is connected to a memory target, and link 1 to a peer which never replies.
+ */
+
+#include "CxxUtilities/CxxUtilities.hh"
+#include "SpaceWire.hh"
+#include "RMAP.hh"
+#include "TestUtilities.hh"
+
+#include <thread>
+
+using namespace std;
+
+const uint32_t FirstPortNumber = 10052;
+const size_t NumberOfLinks = 2;
+const uint32_t ChunkSize = 256;
+const size_t RangeLength = 8 * ChunkSize;
+const double ShortTimeoutDuration = 20;
+const double TimeoutDuration = 10000;
+const size_t NumberOfRepetitions = 50;
+const size_t NumberOfOutstandingReads = 16;
+
+int main(int argc, char* argv[]) {
+	//pairs of links connected via the loopback interface
+	SpaceWireIFOverTCP* targetSides[NumberOfLinks];
+	SpaceWireIFOverTCP* initiatorSides[NumberOfLinks];
+	for (size_t i = 0; i < NumberOfLinks; i++) {
+		SpaceWireIFOverTCP* targetSide = new SpaceWireIFOverTCP(FirstPortNumber + i);
+		std::thread openThread([&]() {
+			targetSide->open();
+		});
+		CxxUtilities::Condition condition;
+		condition.wait(100);
+		initiatorSides[i] = new SpaceWireIFOverTCP("127.0.0.1", FirstPortNumber + i);
+		initiatorSides[i]->open();
+		openThread.join();
+		targetSides[i] = targetSide;
+	}
+
+	//only link 0 is served by a target engine
+	RMAPEngine* targetEngine = new RMAPEngine(targetSides[0]);
+	targetEngine->addRMAPTarget(new RMAPMemoryTarget(0, 0x10000));
+	targetEngine->start();
+	RMAPEngine* initiatorEngine = new RMAPEngine(initiatorSides[0]);
+	initiatorEngine->addSpaceWireIF(initiatorSides[1]);
+	initiatorEngine->start();
+	CxxUtilities::Condition condition;
+	condition.wait(100);
+	size_t nAvailableTransactionIDs = initiatorEngine->getNAvailableTransactionIDs();
+
+	RMAPTargetNode* rmapTargetNodes[NumberOfLinks];
+	for (size_t i = 0; i < NumberOfLinks; i++) {
+		rmapTargetNodes[i] = new RMAPTargetNode();
+		rmapTargetNodes[i]->setLinkIndex(i);
+		rmapTargetNodes[i]->setMaximumDataLengthPerTransaction(ChunkSize);
+	}
+	std::vector<uint8_t> buffer(RangeLength);
+
+	//deleted right after the last reply was received
+	for (size_t i = 0; i < NumberOfRepetitions; i++) {
+		RMAPInitiator* rmapInitiator = new RMAPInitiator(initiatorEngine);
+		try {
+			rmapInitiator->readRange(rmapTargetNodes[0], 0, RangeLength, &buffer[0]);
+		} catch (...) {
+			check(false, "readRange() via the served link failed");
+		}
+		delete rmapInitiator;
+	}
+
+	//deleted right after the last chunk timed out
+	for (size_t i = 0; i < NumberOfRepetitions / 5; i++) {
+		RMAPInitiator* rmapInitiator = new RMAPInitiator(initiatorEngine);
+		try {
+			rmapInitiator->readRange(rmapTargetNodes[1], 0, RangeLength, &buffer[0], ShortTimeoutDuration);
+			check(false, "readRange() via the silent link succeeded");
+		} catch (RMAPInitiatorException& e) {
+			check(e.getStatus() == RMAPInitiatorException::Timeout, "silent link was reported as " + e.toString());
+		}
+		delete rmapInitiator;
+	}
+
+	//deleted while transactions are outstanding; they are canceled and completed as Timeout
+	RMAPInitiator* rmapInitiator = new RMAPInitiator(initiatorEngine);
+	std::vector<uint8_t> readBuffers[NumberOfOutstandingReads];
+	std::vector<std::future<void> > futures;
+	for (size_t i = 0; i < NumberOfOutstandingReads; i++) {
+		readBuffers[i].resize(ChunkSize);
+		futures.push_back(
+				rmapInitiator->getAsyncInitiator()->readAsync(rmapTargetNodes[1], 0, ChunkSize, &readBuffers[i][0],
+						TimeoutDuration));
+	}
+	std::chrono::steady_clock::time_point started = std::chrono::steady_clock::now();
+	delete rmapInitiator;
+	double elapsedInMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - started).count();
+	check(elapsedInMs < TimeoutDuration / 2, "deletion waited for the timeout of outstanding transactions");
+	size_t nCanceled = 0;
+	for (size_t i = 0; i < futures.size(); i++) {
+		check(futures[i].wait_for(std::chrono::seconds(0)) == std::future_status::ready, "future was not resolved");
+		try {
+			futures[i].get();
+		} catch (RMAPInitiatorException& e) {
+			if (e.getStatus() == RMAPInitiatorException::Timeout) {
+				nCanceled++;
+			}
+		}
+	}
+	check(nCanceled == NumberOfOutstandingReads, "outstanding transactions were not completed as Timeout");
+	check(initiatorEngine->getNAvailableTransactionIDs() == nAvailableTransactionIDs, "transaction IDs were leaked");
+
+	initiatorEngine->stop();
+	targetEngine->stop();
+	for (size_t i = 0; i < NumberOfLinks; i++) {
+		initiatorSides[i]->close();
+		targetSides[i]->close();
+	}
+
+	return reportTestResult();
+}
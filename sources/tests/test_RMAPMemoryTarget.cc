@@ -0,0 +1,101 @@
+/*
+ * test_RMAPMemoryTarget.cc
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include "CxxUtilities/CxxUtilities.hh"
+#include "RMAPMemoryTarget.hh"
+#include "TestUtilities.hh"
+
+using namespace std;
+
+/** Executes a command on a target as RMAPEngine does, and returns the reply (or NULL). */
+RMAPPacket* execute(RMAPMemoryTarget* target, RMAPObjectPool<RMAPPacket>* pool, RMAPPacket* commandPacket) {
+	RMAPTransaction transaction;
+	transaction.commandPacket = commandPacket;
+	transaction.packetPool = pool;
+	transaction.replyPacket = NULL;
+	RMAPTargetAccessAction* action = target->getCorrespondingRMAPTargetAccessAction(&transaction);
+	if (action == NULL) {
+		return NULL;
+	}
+	action->processTransaction(&transaction);
+	return transaction.replyPacket;
+}
+
+RMAPPacket* createCommand(bool isWrite, uint32_t address, std::vector<uint8_t> data, uint32_t length) {
+	RMAPPacket* commandPacket = new RMAPPacket();
+	commandPacket->setCommand();
+	if (isWrite) {
+		commandPacket->setWrite();
+	} else {
+		commandPacket->setRead();
+	}
+	commandPacket->setReplyMode();
+	commandPacket->setIncrementMode();
+	commandPacket->setAddress(address);
+	commandPacket->setData(data);
+	commandPacket->setLength(length);
+	return commandPacket;
+}
+
+int main(int argc, char* argv[]) {
+	RMAPObjectPool<RMAPPacket> pool;
+	const uint32_t baseAddress = 0x10000000;
+	RMAPMemoryTarget* target = new RMAPMemoryTarget(baseAddress, 0x10000);
+	std::vector<uint8_t> noData;
+
+	//write and read back
+	std::vector<uint8_t> data = { 0x01, 0x23, 0x45, 0x67, 0x89, 0xab, 0xcd, 0xef };
+	RMAPPacket* reply = execute(target, &pool, createCommand(true, baseAddress + 0x100, data, data.size()));
+	check(reply != NULL && reply->getStatus() == RMAPReplyStatus::CommandExcecutedSuccessfully, "write");
+	reply = execute(target, &pool, createCommand(false, baseAddress + 0x100, noData, data.size()));
+	check(reply != NULL && reply->getData() == data, "read");
+
+	//non-increment write repeatedly updates the same 4-byte word
+	RMAPPacket* commandPacket = createCommand(true, baseAddress + 0x200, data, data.size());
+	commandPacket->setNoIncrementMode();
+	execute(target, &pool, commandPacket);
+	uint8_t* memory = target->getMemory();
+	check(memory[0x200] == 0x89 && memory[0x203] == 0xef && memory[0x204] == 0x00, "non-increment write");
+
+	//read-modify-write returns the original data
+	std::vector<uint8_t> dataAndMask = { 0xff, 0x00, 0xf0, 0x0f, 0x0f, 0xff, 0xff, 0x00 };
+	commandPacket = createCommand(false, baseAddress + 0x100, dataAndMask, dataAndMask.size());
+	commandPacket->setVerifyMode();
+	reply = execute(target, &pool, commandPacket);
+	std::vector<uint8_t> original = { 0x01, 0x23, 0x45, 0x67 };
+	check(reply != NULL && reply->getData() == original, "read-modify-write reply");
+	check(memory[0x100] == 0x0f && memory[0x101] == 0x00 && memory[0x102] == 0xf0 && memory[0x103] == 0x67,
+			"read-modify-write");
+
+	//errors
+	reply = execute(target, &pool, createCommand(false, baseAddress + 0xfffc, noData, 4));
+	check(reply != NULL && reply->getStatus() == RMAPReplyStatus::CommandExcecutedSuccessfully, "last word");
+	reply = execute(target, &pool, createCommand(false, baseAddress + 0xfffc, noData, 8));
+	check(reply == NULL, "access beyond the region should not be dispatched");
+	commandPacket = createCommand(false, baseAddress, dataAndMask, 6);
+	commandPacket->setVerifyMode();
+	reply = execute(target, &pool, commandPacket);
+	check(reply != NULL && reply->getStatus() == RMAPReplyStatus::RMWDataLengthError, "RMW length");
+	target->getMemoryAccessAction()->setMaximumVerifiedWriteLength(4);
+	commandPacket = createCommand(true, baseAddress, data, data.size());
+	commandPacket->setVerifyMode();
+	reply = execute(target, &pool, commandPacket);
+	check(reply != NULL && reply->getStatus() == RMAPReplyStatus::VerifyBufferOverrun, "verify buffer overrun");
+	check(memory[0] == 0x00, "rejected verified write should not modify memory");
+
+	//file-backed memory keeps written data
+	std::string filename = "test_RMAPMemoryTarget.bin";
+	unlink(filename.c_str());
+	RMAPMemoryTarget* fileTarget = new RMAPMemoryTarget(0, 4096, filename);
+	execute(fileTarget, &pool, createCommand(true, 0x10, data, data.size()));
+	delete fileTarget;
+	fileTarget = new RMAPMemoryTarget(0, 4096, filename);
+	check(fileTarget->getMemory()[0x17] == 0xef, "file-backed memory");
+	delete fileTarget;
+	unlink(filename.c_str());
+
+	return reportTestResult();
+}
@@ -0,0 +1,151 @@
+/*
+ * test_RMAPObjectPool.cc
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+/* RMAPObjectPool recycles released instances up to its capacity, and once the pools of RMAPEngine are
+ * warmed up, steady-state traffic between an initiator and a memory target does not allocate packets
+ * or transactions.
+ */
+
+#include "CxxUtilities/CxxUtilities.hh"
+#include "SpaceWire.hh"
+#include "RMAP.hh"
+#include "TestUtilities.hh"
+
+#include <thread>
+
+using namespace std;
+
+const uint32_t PortNumber = 10040;
+const size_t NumberOfWarmUpTransactions = 100;
+const size_t NumberOfTransactions = 1000;
+const double TimeoutDuration = 1000;
+
+/** Counts live instances, so that leaked or doubly deleted instances are detected. */
+class CountedObject {
+public:
+	static size_t nLiveObjects;
+
+public:
+	CountedObject() {
+		nLiveObjects++;
+	}
+
+	~CountedObject() {
+		nLiveObjects--;
+	}
+};
+
+size_t CountedObject::nLiveObjects = 0;
+
+void testPool() {
+	RMAPObjectPool<CountedObject>* pool = new RMAPObjectPool<CountedObject>(4);
+
+	//released instances are reused in LIFO order
+	CountedObject* a = pool->acquire();
+	CountedObject* b = pool->acquire();
+	check(pool->nAllocatedObjects == 2 && pool->nReusedObjects == 0, "acquire() from an empty pool");
+	pool->release(a);
+	pool->release(b);
+	pool->release(NULL);
+	check(pool->getNFreeObjects() == 2 && pool->nRecycledObjects == 2, "release()");
+	check(pool->acquire() == b && pool->acquire() == a && pool->nReusedObjects == 2, "reuse of released instances");
+	check(pool->nAllocatedObjects == 2 && CountedObject::nLiveObjects == 2, "instances were allocated for reuse");
+
+	//instances beyond the capacity are deleted when released
+	std::vector<CountedObject*> objects;
+	objects.push_back(a);
+	objects.push_back(b);
+	for (size_t i = 0; i < 4; i++) {
+		objects.push_back(pool->acquire());
+	}
+	for (size_t i = 0; i < objects.size(); i++) {
+		pool->release(objects[i]);
+	}
+	check(pool->getNFreeObjects() == 4 && pool->nDeletedObjects == 2 && CountedObject::nLiveObjects == 4,
+			"release() to a full pool");
+
+	//reserve() stops at the capacity, and setCapacity() deletes excess instances
+	pool->setCapacity(8);
+	pool->reserve(100);
+	check(pool->getNFreeObjects() == 8 && CountedObject::nLiveObjects == 8, "reserve()");
+	pool->setCapacity(3);
+	check(pool->getNFreeObjects() == 3 && pool->getCapacity() == 3 && CountedObject::nLiveObjects == 3,
+			"setCapacity()");
+
+	delete pool;
+	check(CountedObject::nLiveObjects == 0, "free instances were not deleted with the pool");
+}
+
+void testEngine() {
+	//target and initiator connected via the loopback interface
+	SpaceWireIFOverTCP* targetSide = new SpaceWireIFOverTCP(PortNumber);
+	std::thread openThread([&]() {
+		targetSide->open();
+	});
+	CxxUtilities::Condition condition;
+	condition.wait(100);
+	SpaceWireIFOverTCP* initiatorSide = new SpaceWireIFOverTCP("127.0.0.1", PortNumber);
+	initiatorSide->open();
+	openThread.join();
+
+	RMAPEngine* targetEngine = new RMAPEngine(targetSide);
+	RMAPMemoryTarget* memoryTarget = new RMAPMemoryTarget(0, 0x10000);
+	targetEngine->addRMAPTarget(memoryTarget);
+	targetEngine->start();
+	RMAPEngine* initiatorEngine = new RMAPEngine(initiatorSide);
+	initiatorEngine->start();
+	condition.wait(100);
+
+	RMAPInitiator* rmapInitiator = new RMAPInitiator(initiatorEngine);
+	RMAPTargetNode* rmapTargetNode = new RMAPTargetNode();
+	uint8_t data[8] = { 0x01, 0x23, 0x45, 0x67, 0x89, 0xab, 0xcd, 0xef };
+	uint8_t buffer[8];
+	try {
+		for (size_t i = 0; i < NumberOfWarmUpTransactions; i++) {
+			rmapInitiator->write(rmapTargetNode, 0x100, data, sizeof(data), TimeoutDuration);
+			rmapInitiator->read(rmapTargetNode, 0x100, sizeof(buffer), buffer, TimeoutDuration);
+		}
+
+		RMAPObjectPool<RMAPPacket>* targetPacketPool = targetEngine->getRMAPPacketPool();
+		RMAPObjectPool<RMAPTransaction>* targetTransactionPool = targetEngine->getRMAPTransactionPool();
+		RMAPObjectPool<RMAPPacket>* initiatorPacketPool = initiatorEngine->getRMAPPacketPool();
+		size_t nTargetPackets = targetPacketPool->nAllocatedObjects;
+		size_t nTargetTransactions = targetTransactionPool->nAllocatedObjects;
+		size_t nInitiatorPackets = initiatorPacketPool->nAllocatedObjects;
+		size_t nReusedInitiatorPackets = initiatorPacketPool->nReusedObjects;
+		for (size_t i = 0; i < NumberOfTransactions; i++) {
+			data[0] = (uint8_t) i;
+			rmapInitiator->write(rmapTargetNode, 0x100, data, sizeof(data), TimeoutDuration);
+			rmapInitiator->read(rmapTargetNode, 0x100, sizeof(buffer), buffer, TimeoutDuration);
+			if (memcmp(data, buffer, sizeof(data)) != 0) {
+				check(false, "read data");
+				break;
+			}
+		}
+		check(targetPacketPool->nAllocatedObjects == nTargetPackets, "target allocated packets in steady state");
+		check(targetTransactionPool->nAllocatedObjects == nTargetTransactions,
+				"target allocated transactions in steady state");
+		check(initiatorPacketPool->nAllocatedObjects == nInitiatorPackets,
+				"initiator allocated packets in steady state");
+		check(initiatorPacketPool->nReusedObjects >= nReusedInitiatorPackets + 2 * NumberOfTransactions,
+				"initiator did not reuse reply packets");
+	} catch (...) {
+		check(false, "transactions failed");
+	}
+
+	delete rmapInitiator;
+	initiatorEngine->stop();
+	targetEngine->stop();
+	initiatorSide->close();
+	targetSide->close();
+}
+
+int main(int argc, char* argv[]) {
+	testPool();
+	testEngine();
+
+	return reportTestResult();
+}
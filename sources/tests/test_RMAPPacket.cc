@@ -56,7 +56,7 @@ int main(int argc,char* argv[]){
 	cout << "RMAPPacket2" << endl;
 	SpaceWireUtilities::dumpPacket(rmapPacket2.getPacketBufferPointer());
 
-	if(rmapPacket1.getPacket()==rmapPacket2.getPacket()){
+	if(*rmapPacket1.getPacketBufferPointer()==*rmapPacket2.getPacketBufferPointer()){
 		std::cout << "the same" << endl;
 	}else{
 
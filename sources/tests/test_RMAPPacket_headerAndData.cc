@@ -0,0 +1,122 @@
+/*
+ * test_RMAPPacket_headerAndData.cc
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+/* The header returned by RMAPPacket::getHeader() matches the constructed or received packet after
+ * constructPacketInto() and interpretAsAnRMAPPacketInPlace(), and getData() can be called concurrently
+ * on a packet whose data part is referred in place. Intended to be run also with -fsanitize=thread.
+ */
+
+#include "CxxUtilities/CxxUtilities.hh"
+#include "RMAP.hh"
+#include "TestUtilities.hh"
+
+#include <thread>
+
+using namespace std;
+
+const size_t PathAddressLength = 2;
+const size_t DataLength = 64;
+const size_t NumberOfThreads = 8;
+const size_t NumberOfRepetitions = 2000;
+
+void setWriteCommand(RMAPPacket& packet) {
+	packet.setTargetSpaceWireAddress(std::vector<uint8_t>( { 3, 10 }));
+	packet.setReplyAddress(std::vector<uint8_t>( { 5, 3 }));
+	packet.setCommand();
+	packet.setWrite();
+	packet.setReplyMode();
+	packet.setIncrementMode();
+	packet.setAddress(0xff803800);
+	std::vector<uint8_t> data(DataLength);
+	for (size_t i = 0; i < data.size(); i++) {
+		data[i] = (uint8_t) i;
+	}
+	packet.setData(data);
+}
+
+/** Returns the header part of a constructed packet. */
+std::vector<uint8_t> headerOf(std::vector<uint8_t>& buffer, RMAPPacket& packet) {
+	return std::vector<uint8_t>(buffer.begin() + PathAddressLength,
+			buffer.begin() + PathAddressLength + packet.getHeaderSize());
+}
+
+void testHeader() {
+	RMAPPacket packet;
+	setWriteCommand(packet);
+	std::vector<uint8_t> buffer(packet.getPacketSize());
+	packet.constructPacketInto(&(buffer[0]), buffer.size());
+	check(packet.getHeader() == headerOf(buffer, packet), "getHeader() after constructPacketInto()");
+	check(packet.getHeader().back() == packet.getHeaderCRC(), "Header CRC after constructPacketInto()");
+
+	//changed fields are reflected without constructHeader()
+	packet.setAddress(0x00002000);
+	packet.setTransactionID(0x1234);
+	packet.constructPacketInto(&(buffer[0]), buffer.size());
+	std::vector<uint8_t> header = headerOf(buffer, packet);
+	check(packet.getHeader() == header, "getHeader() after the fields were changed");
+
+	//calculateHeaderCRC() ignores a manually set Header CRC
+	packet.setHeaderCRCMode(RMAPPacket::ManualCRC);
+	packet.setHeaderCRC(header.back() + 1);
+	packet.calculateHeaderCRC();
+	check(packet.getHeaderCRC() == header.back(), "calculateHeaderCRC() in ManualCRC mode");
+
+	//in-place interpretation of a command and of its reply
+	std::vector<uint8_t> received(buffer);
+	RMAPPacket interpreted;
+	interpreted.interpretAsAnRMAPPacketInPlace(received);
+	check(interpreted.getHeader() == header, "getHeader() after in-place interpretation of a command");
+	RMAPPacket reply;
+	reply.setReplyAddress(std::vector<uint8_t>( { 5, 3 }), false);
+	reply.setReply();
+	reply.setRead();
+	reply.setTransactionID(0x1234);
+	reply.setData(packet.getDataBufferAsArrayPointer(), packet.getDataSize());
+	reply.constructPacket();
+	std::vector<uint8_t> replyBuffer(*reply.getPacketBufferPointer());
+	std::vector<uint8_t> replyHeader = headerOf(replyBuffer, reply);
+	received = replyBuffer;
+	interpreted.interpretAsAnRMAPPacketInPlace(received);
+	check(interpreted.getHeader() == replyHeader, "getHeader() after in-place interpretation of a reply");
+	check(interpreted.getHeaderCRC() == replyHeader.back(), "Header CRC after in-place interpretation of a reply");
+}
+
+void testConcurrentGetData() {
+	RMAPPacket packet;
+	setWriteCommand(packet);
+	packet.constructPacket();
+	std::vector<uint8_t> expected = packet.getData();
+	std::vector<uint8_t> received(*packet.getPacketBufferPointer());
+	RMAPPacket interpreted;
+	interpreted.interpretAsAnRMAPPacketInPlace(received);
+	const RMAPPacket& constInterpreted = interpreted;
+	uint8_t* dataPart = interpreted.getDataBufferAsArrayPointer();
+
+	std::atomic<size_t> nMismatches(0);
+	std::vector<std::thread> threads;
+	for (size_t t = 0; t < NumberOfThreads; t++) {
+		threads.push_back(std::thread([&]() {
+			for (size_t i = 0; i < NumberOfRepetitions; i++) {
+				if (constInterpreted.getData() != expected) {
+					nMismatches++;
+				}
+			}
+		}));
+	}
+	for (size_t t = 0; t < threads.size(); t++) {
+		threads[t].join();
+	}
+	check(nMismatches == 0, "getData() returned wrong data");
+
+	check(interpreted.getDataBufferAsArrayPointer() == dataPart, "data part was copied by getData()");
+}
+
+int main(int argc, char* argv[]) {
+	testHeader();
+	testConcurrentGetData();
+
+	return reportTestResult();
+}
@@ -0,0 +1,176 @@
+/*
+ * test_RMAPPacket_interpretInPlace.cc
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+/* RMAPPacket::interpretAsAnRMAPPacketInPlace() yields the same fields, data part, CRCs, and packet as
+ * the copying interpretAsAnRMAPPacket() for read/write commands and replies, and fails with the same
+ * status for corrupted packets.
+ */
+
+#include "CxxUtilities/CxxUtilities.hh"
+#include "RMAP.hh"
+#include "TestUtilities.hh"
+
+using namespace std;
+
+const size_t DataLength = 37;
+
+std::vector<uint8_t> createData(size_t length) {
+	std::vector<uint8_t> data(length);
+	for (size_t i = 0; i < length; i++) {
+		data[i] = (uint8_t) (i * 7 + 3);
+	}
+	return data;
+}
+
+/** Returns a constructed command packet (write or read). */
+std::vector<uint8_t> createCommand(bool isWrite, bool useDraftECRC) {
+	RMAPPacket packet;
+	packet.setUseDraftECRC(useDraftECRC);
+	packet.setTargetSpaceWireAddress(std::vector<uint8_t>( { 3, 10, 21 }));
+	packet.setReplyAddress(std::vector<uint8_t>( { 5, 3 }));
+	packet.setTargetLogicalAddress(0x30);
+	packet.setCommand();
+	packet.setReplyMode();
+	packet.setIncrementMode();
+	packet.setKey(0x20);
+	packet.setTransactionID(0xABCD);
+	packet.setExtendedAddress(0x01);
+	packet.setAddress(0xff803800);
+	if (isWrite) {
+		packet.setWrite();
+		std::vector<uint8_t> data = createData(DataLength);
+		packet.setData(data);
+	} else {
+		packet.setRead();
+		packet.setDataLength(DataLength);
+	}
+	packet.constructPacket();
+	return *packet.getPacketBufferPointer();
+}
+
+/** Returns a constructed reply packet (to a write or read command). */
+std::vector<uint8_t> createReply(bool isWrite, bool useDraftECRC) {
+	RMAPPacket packet;
+	packet.setUseDraftECRC(useDraftECRC);
+	packet.setReplyAddress(std::vector<uint8_t>( { 5, 3 }), false);
+	packet.setInitiatorLogicalAddress(0xFE);
+	packet.setTargetLogicalAddress(0x30);
+	packet.setReply();
+	packet.setReplyMode();
+	packet.setIncrementMode();
+	packet.setStatus(0x00);
+	packet.setTransactionID(0xABCD);
+	if (isWrite) {
+		packet.setWrite();
+	} else {
+		packet.setRead();
+		std::vector<uint8_t> data = createData(DataLength);
+		packet.setData(data);
+	}
+	packet.constructPacket();
+	return *packet.getPacketBufferPointer();
+}
+
+bool haveSameFields(RMAPPacket& a, RMAPPacket& b) {
+	return a.getInstruction() == b.getInstruction() && a.getTargetLogicalAddress() == b.getTargetLogicalAddress()
+			&& a.getInitiatorLogicalAddress() == b.getInitiatorLogicalAddress() && a.getKey() == b.getKey()
+			&& a.getStatus() == b.getStatus() && a.getTransactionID() == b.getTransactionID()
+			&& a.getExtendedAddress() == b.getExtendedAddress() && a.getAddress() == b.getAddress()
+			&& a.getDataLength() == b.getDataLength() && a.getReplyAddress() == b.getReplyAddress()
+			&& a.getTargetSpaceWireAddress() == b.getTargetSpaceWireAddress()
+			&& a.getHeaderCRC() == b.getHeaderCRC() && a.getDataCRC() == b.getDataCRC() && a.getHeader() == b.getHeader();
+}
+
+bool haveSameData(RMAPPacket& a, RMAPPacket& b) {
+	if (a.getDataSize() != b.getDataSize() || a.getData() != b.getData()) {
+		return false;
+	}
+	return a.getDataSize() == 0
+			|| memcmp(a.getDataBufferAsArrayPointer(), b.getDataBufferAsArrayPointer(), a.getDataSize()) == 0;
+}
+
+/** Interprets a packet by copying and in place, and compares the results. */
+void compareInterpretations(std::vector<uint8_t> packet, bool useDraftECRC, std::string name) {
+	RMAPPacket copied;
+	copied.setUseDraftECRC(useDraftECRC);
+	copied.interpretAsAnRMAPPacket(packet);
+	RMAPPacket inPlace;
+	inPlace.setUseDraftECRC(useDraftECRC);
+	std::vector<uint8_t> received(packet);
+	inPlace.interpretAsAnRMAPPacketInPlace(received);
+
+	check(haveSameFields(copied, inPlace), name + ": fields");
+	check(haveSameData(copied, inPlace), name + ": data part");
+	check(copied.toString() == inPlace.toString(), name + ": toString()");
+	//reconstruction from the fields yields the original packet in both cases
+	check(*copied.getPacketBufferPointer() == packet, name + ": packet reconstructed after copying interpretation");
+	check(*inPlace.getPacketBufferPointer() == packet, name + ": packet reconstructed after in-place interpretation");
+}
+
+/** Corrupts a byte of a packet, and checks that both interpretations fail with the same status. */
+void compareFailures(std::vector<uint8_t> packet, size_t index, std::string name) {
+	packet[index] ^= 0x01;
+	uint32_t copiedStatus = 0xFFFFFFFF;
+	uint32_t inPlaceStatus = 0xFFFFFFFF;
+	RMAPPacket rmapPacket;
+	try {
+		rmapPacket.interpretAsAnRMAPPacket(packet);
+	} catch (RMAPPacketException& e) {
+		copiedStatus = e.getStatus();
+	}
+	std::vector<uint8_t> received(packet);
+	try {
+		rmapPacket.interpretAsAnRMAPPacketInPlace(received);
+	} catch (RMAPPacketException& e) {
+		inPlaceStatus = e.getStatus();
+	}
+	check(copiedStatus != 0xFFFFFFFF && copiedStatus == inPlaceStatus, name + ": status of a corrupted packet");
+}
+
+int main(int argc, char* argv[]) {
+	for (size_t crc = 0; crc < 2; crc++) {
+		bool useDraftECRC = (crc == 1);
+		std::string suffix = useDraftECRC ? " (Draft E CRC)" : "";
+		std::vector<uint8_t> writeCommand = createCommand(true, useDraftECRC);
+		std::vector<uint8_t> readCommand = createCommand(false, useDraftECRC);
+		std::vector<uint8_t> writeReply = createReply(true, useDraftECRC);
+		std::vector<uint8_t> readReply = createReply(false, useDraftECRC);
+		compareInterpretations(writeCommand, useDraftECRC, "write command" + suffix);
+		compareInterpretations(readCommand, useDraftECRC, "read command" + suffix);
+		compareInterpretations(writeReply, useDraftECRC, "write reply" + suffix);
+		compareInterpretations(readReply, useDraftECRC, "read reply" + suffix);
+	}
+
+	//instances reused after a read reply interpret a write reply in the same way
+	std::vector<uint8_t> readReply = createReply(false, false);
+	std::vector<uint8_t> writeReply = createReply(true, false);
+	RMAPPacket reusedInPlace;
+	std::vector<uint8_t> received(readReply);
+	reusedInPlace.interpretAsAnRMAPPacketInPlace(received);
+	received = writeReply;
+	reusedInPlace.interpretAsAnRMAPPacketInPlace(received);
+	RMAPPacket reusedCopied;
+	reusedCopied.interpretAsAnRMAPPacket(readReply);
+	reusedCopied.interpretAsAnRMAPPacket(writeReply);
+	check(haveSameFields(reusedCopied, reusedInPlace) && haveSameData(reusedCopied, reusedInPlace), "reused instances");
+	RMAPPacket fresh;
+	fresh.interpretAsAnRMAPPacket(writeReply);
+	check(haveSameFields(fresh, reusedInPlace) && haveSameData(fresh, reusedInPlace),
+			"fields of the previous packet were kept in a reused instance");
+
+	//corrupted Header CRC, data, and Data CRC
+	std::vector<uint8_t> writeCommand = createCommand(true, false);
+	size_t headerCRCIndex = 3 + 4 + 4 + 12 - 1;
+	compareFailures(writeCommand, headerCRCIndex, "write command with a wrong Header CRC");
+	compareFailures(writeCommand, headerCRCIndex + 1, "write command with a wrong data part");
+	compareFailures(writeCommand, writeCommand.size() - 1, "write command with a wrong Data CRC");
+	compareFailures(readReply, 2 + 11, "read reply with a wrong Header CRC");
+	compareFailures(readReply, readReply.size() - 1, "read reply with a wrong Data CRC");
+	readReply.pop_back();
+	compareFailures(readReply, 2 + 12, "truncated read reply");
+
+	return reportTestResult();
+}
@@ -0,0 +1,135 @@
+/*
+ * test_RMAPRegister.cc
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+/* Register accessors generated from sampleXML/SampleRMAPTargetNode_001.xml by main_RMAP_generateRegisterAccessors
+ * (see the Makefile) are compiled here, and accesses are checked against memory targets which accept only
+ * the key and extended address of each register.
+ */
+
+#include "CxxUtilities/CxxUtilities.hh"
+#include "SpaceWire.hh"
+#include "RMAP.hh"
+#include "SampleRMAPTargetNode_001_Registers.hh"
+#include "TestUtilities.hh"
+
+#include <thread>
+
+using namespace std;
+
+const uint32_t PortNumber = 10033;
+const double TimeoutDuration = 500;
+
+static_assert(ShimafujiDIO::TargetLogicalAddress == 0x30 && ShimafujiDIO::DefaultKey == 0x02, "ShimafujiDIO");
+static_assert(ShimafujiDIO2::TargetLogicalAddress == 0x31, "ShimafujiDIO2");
+static_assert(ShimafujiDIO::Command::address == 0xFF803800 && ShimafujiDIO::Command::length == 0x10
+		&& ShimafujiDIO::Command::key == 0x25 && ShimafujiDIO::Command::extendedAddress == 0x00, "Command");
+static_assert(ShimafujiDIO::Command::isWritable && !ShimafujiDIO::Command::isReadable, "Command access mode");
+static_assert(ShimafujiDIO::EssentialHK::address == 0xFF801100 && ShimafujiDIO::EssentialHK::length == 0x08
+		&& ShimafujiDIO::EssentialHK::key == 0x20, "EssentialHK");
+static_assert(ShimafujiDIO::EssentialHK::isReadable && !ShimafujiDIO::EssentialHK::isWritable,
+		"EssentialHK access mode");
+
+/** A register with a non-zero extended address (the sample XML uses only 0x00). */
+typedef RMAPRegister<0x00000010, 4, 0x7E, RMAPMemoryObject::Readable | RMAPMemoryObject::Writable, 0x12> ExtendedRegister;
+/** A FIFO-like register accessed in the non-increment mode. */
+typedef RMAPRegister<0x00000020, 8, 0x7E, RMAPMemoryObject::Readable | RMAPMemoryObject::Writable, 0x12, false> FIFORegister;
+
+RMAPMemoryTarget* createMemoryTarget(uint32_t baseAddress, uint8_t key, uint8_t extendedAddress) {
+	RMAPMemoryTarget* memoryTarget = new RMAPMemoryTarget(baseAddress, 0x10000);
+	memoryTarget->setKey(key);
+	memoryTarget->setExtendedAddress(extendedAddress);
+	return memoryTarget;
+}
+
+int main(int argc, char* argv[]) {
+	//target and initiator connected via the loopback interface
+	SpaceWireIFOverTCP* targetSide = new SpaceWireIFOverTCP(PortNumber);
+	std::thread openThread([&]() {
+		targetSide->open();
+	});
+	CxxUtilities::Condition condition;
+	condition.wait(200);
+	SpaceWireIFOverTCP* initiatorSide = new SpaceWireIFOverTCP("127.0.0.1", PortNumber);
+	initiatorSide->open();
+	openThread.join();
+
+	//each memory target accepts only commands with the key and extended address of one register
+	RMAPEngine* targetEngine = new RMAPEngine(targetSide);
+	RMAPMemoryTarget* commandTarget = createMemoryTarget(0xFF800000, ShimafujiDIO::Command::key, 0x00);
+	RMAPMemoryTarget* housekeepingTarget = createMemoryTarget(0xFF800000, ShimafujiDIO::EssentialHK::key, 0x00);
+	RMAPMemoryTarget* extendedTarget = createMemoryTarget(0x00000000, ExtendedRegister::key,
+			ExtendedRegister::extendedAddress);
+	targetEngine->addRMAPTarget(commandTarget);
+	targetEngine->addRMAPTarget(housekeepingTarget);
+	targetEngine->addRMAPTarget(extendedTarget);
+	targetEngine->start();
+	RMAPEngine* initiatorEngine = new RMAPEngine(initiatorSide);
+	initiatorEngine->start();
+	condition.wait(100);
+
+	RMAPInitiator* rmapInitiator = new RMAPInitiator(initiatorEngine);
+	RMAPTargetNode* rmapTargetNode = new RMAPTargetNode();
+	rmapTargetNode->setTargetLogicalAddress(ShimafujiDIO::TargetLogicalAddress);
+	rmapTargetNode->setDefaultKey(ShimafujiDIO::DefaultKey);
+
+	try {
+		uint8_t command[ShimafujiDIO::Command::length];
+		for (size_t i = 0; i < sizeof(command); i++) {
+			command[i] = i + 1;
+		}
+		ShimafujiDIO::Command::write(rmapInitiator, rmapTargetNode, command, TimeoutDuration);
+		check(memcmp(commandTarget->getMemory() + 0x3800, command, sizeof(command)) == 0, "Command write");
+	} catch (...) {
+		check(false, "Command write was not accepted with key 0x25");
+	}
+
+	try {
+		memcpy(housekeepingTarget->getMemory() + 0x1100, "\x01\x23\x45\x67\x89\xab\xcd\xef", 8);
+		check(ShimafujiDIO::EssentialHK::readValue(rmapInitiator, rmapTargetNode, TimeoutDuration)
+				== 0x0123456789abcdefULL, "EssentialHK read");
+	} catch (...) {
+		check(false, "EssentialHK read was not accepted with key 0x20");
+	}
+
+	try {
+		ExtendedRegister::writeValue(rmapInitiator, rmapTargetNode, 0xCAFEBABE, TimeoutDuration);
+		check(ExtendedRegister::readValue(rmapInitiator, rmapTargetNode, TimeoutDuration) == 0xCAFEBABE,
+				"ExtendedRegister read back");
+		check(extendedTarget->getMemory()[0x10] == 0xCA, "ExtendedRegister write");
+	} catch (...) {
+		check(false, "ExtendedRegister access was not accepted with extended address 0x12");
+	}
+
+	//the non-increment mode of a register is used only for its accesses, and the initiator is not modified
+	try {
+		uint8_t data[FIFORegister::length] = { 1, 2, 3, 4, 5, 6, 7, 8 };
+		FIFORegister::write(rmapInitiator, rmapTargetNode, data, TimeoutDuration);
+		uint8_t expected[FIFORegister::length] = { 5, 6, 7, 8, 5, 6, 7, 8 };
+		uint8_t buffer[FIFORegister::length];
+		FIFORegister::read(rmapInitiator, rmapTargetNode, buffer, TimeoutDuration);
+		check(memcmp(buffer, expected, sizeof(expected)) == 0 && extendedTarget->getMemory()[0x24] == 0,
+				"FIFORegister was not accessed in the non-increment mode");
+	} catch (...) {
+		check(false, "FIFORegister access failed");
+	}
+	check(!rmapInitiator->isIncrementModeSet() && rmapInitiator->getIncrementMode() == RMAPInitiator::DefaultIncrementMode,
+			"increment mode of the initiator was modified by a register access");
+
+	//raw-address accesses still use the default key of the node, which no target accepts
+	try {
+		uint8_t buffer[4];
+		rmapInitiator->read(rmapTargetNode, 0xFF801100, 4, buffer, TimeoutDuration);
+		check(false, "default key should not be accepted");
+	} catch (RMAPInitiatorException& e) {
+	}
+
+	initiatorEngine->stop();
+	targetEngine->stop();
+	initiatorSide->close();
+	targetSide->close();
+
+	return reportTestResult();
+}
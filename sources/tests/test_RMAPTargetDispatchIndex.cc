@@ -0,0 +1,92 @@
+/*
+ * test_RMAPTargetDispatchIndex.cc
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include "CxxUtilities/CxxUtilities.hh"
+#include "RMAPTargetDispatchIndex.hh"
+
+#include <random>
+
+using namespace std;
+
+const size_t NumberOfTargets = 20;
+const size_t NumberOfRangesPerTarget = 30;
+const size_t NumberOfLookups = 100000;
+
+class DummyAction: public RMAPTargetAccessAction {
+public:
+	void processTransaction(RMAPTransaction* rmapTransaction) throw (RMAPTargetAccessActionException) {
+	}
+};
+
+/** Reference implementation: scans targets and ranges in registration order. */
+RMAPTargetAccessAction* findLinearly(std::vector<RMAPTarget*>& targets, RMAPPacket* commandPacket) {
+	RMAPAddressRange range(commandPacket->getAddress(), commandPacket->getAddress() + commandPacket->getLength() - 1);
+	for (size_t i = 0; i < targets.size(); i++) {
+		if (!targets[i]->acceptsCommand(commandPacket)) {
+			continue;
+		}
+		std::vector<RMAPAddressRange*>* addressRanges = targets[i]->getAddressRanges();
+		for (size_t j = 0; j < addressRanges->size(); j++) {
+			if ((*addressRanges)[j]->contains(range)) {
+				return targets[i]->getAction((*addressRanges)[j]);
+			}
+		}
+	}
+	return NULL;
+}
+
+int main(int argc, char* argv[]) {
+	std::mt19937 random(1);
+	std::vector<RMAPTarget*> targets;
+	std::vector<DummyAction*> actions;
+
+	//overlapping ranges, and targets with and without logical address/key filters
+	for (size_t i = 0; i < NumberOfTargets; i++) {
+		RMAPTarget* target = new RMAPTarget();
+		if (i % 3 == 1) {
+			target->setTargetLogicalAddress(0xFE);
+		}
+		if (i % 4 == 2) {
+			target->setKey(random() % 2);
+		}
+		for (size_t j = 0; j < NumberOfRangesPerTarget; j++) {
+			uint32_t addressFrom = random() % 0x100000;
+			uint32_t addressTo = addressFrom + random() % 0x1000;
+			DummyAction* action = new DummyAction();
+			actions.push_back(action);
+			target->addAddressRangeAndAssociatedAction(new RMAPAddressRange(addressFrom, addressTo), action);
+		}
+		targets.push_back(target);
+	}
+
+	RMAPTargetDispatchIndex index(targets, 0);
+	RMAPPacket commandPacket;
+	size_t nErrors = 0;
+	size_t nFound = 0;
+	for (size_t i = 0; i < NumberOfLookups; i++) {
+		commandPacket.setTargetLogicalAddress((random() % 2 == 0) ? 0xFE : 0x30);
+		commandPacket.setKey(random() % 2);
+		commandPacket.setExtendedAddress(0);
+		commandPacket.setAddress(random() % 0x110000);
+		commandPacket.setLength(1 + random() % 0x200);
+		RMAPTargetAccessAction* expected = findLinearly(targets, &commandPacket);
+		if (index.find(&commandPacket) != expected) {
+			nErrors++;
+		}
+		if (expected != NULL) {
+			nFound++;
+		}
+	}
+	cout << nFound << "/" << NumberOfLookups << " lookups matched an address range" << endl;
+
+	if (nErrors == 0) {
+		cout << "OK" << endl;
+		return 0;
+	} else {
+		cout << "NG (" << nErrors << " errors)" << endl;
+		return -1;
+	}
+}
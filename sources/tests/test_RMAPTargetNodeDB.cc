@@ -0,0 +1,153 @@
+/*
+ * test_RMAPTargetNodeDB.cc
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+/* Handles resolved from RMAPTargetNodeDB remain valid when a node is replaced by another node with
+ * the same ID, and findRMAPTargetNode(uint8_t) returns the same node as a linear scan of the nodes
+ * in ID order.
+ */
+
+#include "CxxUtilities/CxxUtilities.hh"
+#include "SpaceWire.hh"
+#include "RMAP.hh"
+#include "TestUtilities.hh"
+
+#include <random>
+#include <sstream>
+
+using namespace std;
+
+const size_t NumberOfIDs = 40;
+const size_t NumberOfLogicalAddresses = 8;
+const size_t NumberOfOperations = 2000;
+
+RMAPTargetNode* createRMAPTargetNode(std::string id, uint8_t logicalAddress) {
+	RMAPTargetNode* rmapTargetNode = new RMAPTargetNode();
+	rmapTargetNode->setID(id);
+	rmapTargetNode->setTargetLogicalAddress(logicalAddress);
+	return rmapTargetNode;
+}
+
+RMAPMemoryObject* addMemoryObject(RMAPTargetNode* rmapTargetNode, std::string id, uint32_t address) {
+	RMAPMemoryObject* memoryObject = new RMAPMemoryObject();
+	memoryObject->setID(id);
+	memoryObject->setAddress(address);
+	memoryObject->setLength(4);
+	memoryObject->setAccessMode("ReadWrite");
+	rmapTargetNode->addMemoryObject(memoryObject);
+	return memoryObject;
+}
+
+void testReplacement() {
+	RMAPTargetNodeDB* db = new RMAPTargetNodeDB();
+	RMAPTargetNode* node = createRMAPTargetNode("node", 0x30);
+	addMemoryObject(node, "register", 0x100);
+	addMemoryObject(node, "status", 0x200);
+	db->addRMAPTargetNode(node);
+	RMAPTargetNodeHandle nodeHandle = db->resolveRMAPTargetNode("node");
+	RMAPMemoryObjectHandle registerHandle = db->resolveMemoryObject(nodeHandle, "register");
+	RMAPMemoryObjectHandle statusHandle = db->resolveMemoryObject("node", "status");
+	check(db->resolveMemoryObject("node", "register").index == registerHandle.index, "resolving again");
+
+	//the replacement has the register at another address, and no status
+	RMAPTargetNode* replacement = createRMAPTargetNode("node", 0x40);
+	RMAPMemoryObject* replacedRegister = addMemoryObject(replacement, "register", 0x300);
+	db->addRMAPTargetNode(replacement);
+	check(db->getSize() == 1, "size after replacement");
+	check(db->resolveRMAPTargetNode("node").index == nodeHandle.index, "node handle changed with replacement");
+	check(db->getRMAPTargetNode(nodeHandle) == replacement, "node handle refers to the old node");
+	check(db->getMemoryObject(registerHandle) == replacedRegister, "memory object handle refers to the old node");
+	check(db->getRMAPTargetNode(registerHandle) == replacement, "node of a memory object handle");
+	try {
+		db->getMemoryObject(statusHandle);
+		check(false, "memory object missing in the replacement was returned");
+	} catch (RMAPTargetNodeDBException& e) {
+		check(e.getStatus() == RMAPTargetNodeDBException::NoSuchRMAPMemoryObject,
+				"missing memory object was reported as " + e.toString());
+	}
+	try {
+		db->resolveMemoryObject(nodeHandle, "undefined");
+		check(false, "undefined memory object was resolved");
+	} catch (RMAPTargetNodeDBException& e) {
+		check(e.getStatus() == RMAPTargetNodeDBException::NoSuchRMAPMemoryObject,
+				"undefined memory object was reported as " + e.toString());
+	}
+
+	//a later replacement with the memory object makes the handle usable again
+	RMAPTargetNode* secondReplacement = createRMAPTargetNode("node", 0x40);
+	RMAPMemoryObject* status = addMemoryObject(secondReplacement, "status", 0x200);
+	db->addRMAPTargetNode(secondReplacement);
+	check(db->getMemoryObject(statusHandle) == status, "memory object handle after the second replacement");
+
+	//invalid handles
+	try {
+		db->getRMAPTargetNode(RMAPTargetNodeHandle());
+		check(false, "invalid node handle was accepted");
+	} catch (RMAPTargetNodeDBException& e) {
+		check(e.getStatus() == RMAPTargetNodeDBException::InvalidHandle, "invalid node handle");
+	}
+	try {
+		db->getMemoryObject(RMAPMemoryObjectHandle(statusHandle.index + 1));
+		check(false, "invalid memory object handle was accepted");
+	} catch (RMAPTargetNodeDBException& e) {
+		check(e.getStatus() == RMAPTargetNodeDBException::InvalidHandle, "invalid memory object handle");
+	}
+	try {
+		db->resolveRMAPTargetNode("undefined");
+		check(false, "undefined node was resolved");
+	} catch (RMAPTargetNodeDBException& e) {
+		check(e.getStatus() == RMAPTargetNodeDBException::NoSuchRMAPTargetNode, "undefined node");
+	}
+	delete db;
+}
+
+/** Returns the node with the smallest ID among those with the logical address, or NULL. */
+RMAPTargetNode* findByLinearScan(std::map<std::string, RMAPTargetNode*>& nodes, uint8_t logicalAddress) {
+	std::map<std::string, RMAPTargetNode*>::iterator it = nodes.begin();
+	for (; it != nodes.end(); it++) {
+		if (it->second->getTargetLogicalAddress() == logicalAddress) {
+			return it->second;
+		}
+	}
+	return NULL;
+}
+
+void testLogicalAddressIndex() {
+	RMAPTargetNodeDB* db = new RMAPTargetNodeDB();
+	std::map<std::string, RMAPTargetNode*> nodes;
+	std::mt19937 random(1);
+	for (size_t i = 0; i < NumberOfOperations; i++) {
+		std::stringstream ss;
+		ss << "node" << random() % NumberOfIDs;
+		std::string id = ss.str();
+		uint8_t logicalAddress = 0x20 + random() % NumberOfLogicalAddresses;
+		if (random() % 4 != 0 || nodes.find(id) == nodes.end()) {
+			//add a node, or replace the node with the same ID
+			RMAPTargetNode* rmapTargetNode = createRMAPTargetNode(id, logicalAddress);
+			nodes[id] = rmapTargetNode;
+			db->addRMAPTargetNode(rmapTargetNode);
+		} else {
+			//change the logical address of a registered node
+			nodes[id]->setTargetLogicalAddress(logicalAddress);
+			db->updateLogicalAddressIndex();
+		}
+		for (size_t address = 0; address < 256; address++) {
+			if (db->findRMAPTargetNode((uint8_t) address) != findByLinearScan(nodes, address)) {
+				check(false, "findRMAPTargetNode(uint8_t) differs from a linear scan");
+				delete db;
+				return;
+			}
+		}
+	}
+	check(db->getSize() == nodes.size(), "size");
+	delete db;
+}
+
+int main(int argc, char* argv[]) {
+	testReplacement();
+	testLogicalAddressIndex();
+
+	return reportTestResult();
+}
@@ -0,0 +1,208 @@
+/*
+ * test_RMAPTargetNodeImage.cc
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include "CxxUtilities/CxxUtilities.hh"
+#include "RMAPTargetNodeImage.hh"
+
+#include <fstream>
+#include <sstream>
+
+using namespace std;
+
+const size_t NumberOfTargetNodes = 50;
+const size_t NumberOfMemoryObjectsPerNode = 10;
+
+//image layout (see RMAPTargetNodeImage::Header, TargetNodeRecord and MemoryObjectRecord)
+const size_t HeaderSize = 48;
+const size_t NTargetNodesOffset = 32;
+const size_t NMemoryObjectsOffset = 36;
+const size_t BytePoolSizeOffset = 40;
+const size_t TargetNodeRecordSize = 44;
+const size_t MemoryObjectRecordSize = 32;
+const size_t FirstMemoryObjectOffsetInTargetNodeRecord = 32;
+
+const char* XMLFilename = "test_RMAPTargetNodeImage.xml";
+const char* ImageFilename = "test_RMAPTargetNodeImage.bin";
+const char* CorruptImageFilename = "test_RMAPTargetNodeImage_corrupt.bin";
+
+std::vector<RMAPTargetNode*> createTargetNodes() {
+	std::vector<RMAPTargetNode*> rmapTargetNodes;
+	for (size_t i = 0; i < NumberOfTargetNodes; i++) {
+		RMAPTargetNode* rmapTargetNode = new RMAPTargetNode();
+		stringstream ss;
+		ss << "Node" << i;
+		rmapTargetNode->setID(ss.str());
+		rmapTargetNode->setTargetLogicalAddress(0x20 + i);
+		rmapTargetNode->setDefaultKey(i);
+		std::vector<uint8_t> targetSpaceWireAddress(i % 4, (uint8_t) i);
+		rmapTargetNode->setTargetSpaceWireAddress(targetSpaceWireAddress);
+		std::vector<uint8_t> replyAddress(i % 3, (uint8_t) (i + 1));
+		rmapTargetNode->setReplyAddress(replyAddress);
+		if (i % 2 == 0) {
+			rmapTargetNode->setInitiatorLogicalAddress(0xFE);
+		}
+		rmapTargetNode->setLinkIndex(i % 4);
+		rmapTargetNode->setMaximumDataLengthPerTransaction(256 + i);
+		for (size_t j = 0; j < NumberOfMemoryObjectsPerNode; j++) {
+			RMAPMemoryObject* memoryObject = new RMAPMemoryObject();
+			stringstream ss2;
+			ss2 << "Register" << j;
+			memoryObject->setID(ss2.str());
+			memoryObject->setExtendedAddress(j % 2);
+			memoryObject->setAddress(i * 0x1000 + j * 4);
+			memoryObject->setLength(4);
+			if (j % 3 == 0) {
+				memoryObject->setKey(0x20 + j);
+			}
+			if (j % 2 == 1) {
+				memoryObject->setAccessMode("ReadOnly");
+			}
+			if (j % 5 == 0) {
+				memoryObject->setIncrementMode("NoIncrement");
+			}
+			rmapTargetNode->addMemoryObject(memoryObject);
+		}
+		rmapTargetNodes.push_back(rmapTargetNode);
+	}
+	return rmapTargetNodes;
+}
+
+std::string readFile(std::string filename) {
+	std::ifstream ifs(filename.c_str(), std::ios::binary);
+	return std::string((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>());
+}
+
+void writeFile(std::string filename, std::string content) {
+	std::ofstream ofs(filename.c_str(), std::ios::binary | std::ios::trunc);
+	ofs.write(content.data(), content.size());
+}
+
+void writeUInt32(std::string& image, size_t offset, uint32_t value) {
+	memcpy(&image[offset], &value, sizeof(value));
+}
+
+void writeUInt64(std::string& image, size_t offset, uint64_t value) {
+	memcpy(&image[offset], &value, sizeof(value));
+}
+
+uint32_t readUInt32(std::string& image, size_t offset) {
+	uint32_t value;
+	memcpy(&value, &image[offset], sizeof(value));
+	return value;
+}
+
+/** Returns true if reading a corrupt image throws InvalidImage (instead of crashing or succeeding). */
+bool isRejected(std::string image, std::string description) {
+	writeFile(CorruptImageFilename, image);
+	try {
+		std::vector<RMAPTargetNode*> rmapTargetNodes = RMAPTargetNodeImage::read(CorruptImageFilename);
+		cout << "NG: " << description << " was accepted (" << rmapTargetNodes.size() << " nodes)" << endl;
+		return false;
+	} catch (RMAPTargetNodeImageException& e) {
+		if (e.getStatus() != RMAPTargetNodeImageException::InvalidImage) {
+			cout << "NG: " << description << " was rejected with " << e.toString() << endl;
+			return false;
+		}
+	}
+	return true;
+}
+
+bool containsNode(std::vector<RMAPTargetNode*>& rmapTargetNodes, std::string id) {
+	for (size_t i = 0; i < rmapTargetNodes.size(); i++) {
+		if (rmapTargetNodes[i]->getID() == id) {
+			return true;
+		}
+	}
+	return false;
+}
+
+int main(int argc, char* argv[]) {
+	bool ok = true;
+	std::vector<RMAPTargetNode*> rmapTargetNodes = createTargetNodes();
+
+	//write -> read round trip
+	writeFile(XMLFilename, "<root>\n</root>\n");
+	RMAPTargetNodeImage::write(ImageFilename, rmapTargetNodes, XMLFilename);
+	std::vector<RMAPTargetNode*> readTargetNodes = RMAPTargetNodeImage::read(ImageFilename);
+	if (readTargetNodes.size() != rmapTargetNodes.size()) {
+		cout << "NG: round trip returned " << readTargetNodes.size() << " nodes" << endl;
+		ok = false;
+	} else {
+		for (size_t i = 0; i < readTargetNodes.size(); i++) {
+			if (readTargetNodes[i]->toXMLString() != rmapTargetNodes[i]->toXMLString()
+					|| readTargetNodes[i]->getLinkIndex() != rmapTargetNodes[i]->getLinkIndex()
+					|| readTargetNodes[i]->isInitiatorLogicalAddressSet()
+							!= rmapTargetNodes[i]->isInitiatorLogicalAddressSet()) {
+				cout << "NG: round trip mismatch at " << rmapTargetNodes[i]->getID() << endl;
+				ok = false;
+				break;
+			}
+		}
+	}
+
+	//stale XML: the image is used while it is up to date, and XML is used after the XML file changes
+	if (!RMAPTargetNodeImage::isUpToDate(ImageFilename, XMLFilename)) {
+		cout << "NG: fresh image was reported as stale" << endl;
+		ok = false;
+	}
+	std::vector<RMAPTargetNode*> fromFile = RMAPTargetNodeImage::constructFromFile(XMLFilename, ImageFilename);
+	if (!containsNode(fromFile, "Node0")) {
+		cout << "NG: up-to-date image was not used" << endl;
+		ok = false;
+	}
+	writeFile(XMLFilename, "<root>\n<!-- modified -->\n</root>\n");
+	if (RMAPTargetNodeImage::isUpToDate(ImageFilename, XMLFilename)) {
+		cout << "NG: stale image was reported as up to date" << endl;
+		ok = false;
+	}
+	fromFile = RMAPTargetNodeImage::constructFromFile(XMLFilename, ImageFilename, true);
+	if (containsNode(fromFile, "Node0")) {
+		cout << "NG: stale image was used" << endl;
+		ok = false;
+	}
+	if (!RMAPTargetNodeImage::isUpToDate(ImageFilename, XMLFilename)) {
+		cout << "NG: stale image was not regenerated" << endl;
+		ok = false;
+	}
+
+	//truncated and corrupt images
+	RMAPTargetNodeImage::write(ImageFilename, rmapTargetNodes, XMLFilename);
+	std::string image = readFile(ImageFilename);
+	ok = isRejected(image.substr(0, image.size() - 1), "truncated image") && ok;
+	ok = isRejected(image.substr(0, HeaderSize + 10), "image truncated in records") && ok;
+	ok = isRejected(image + '\0', "image with trailing garbage") && ok;
+	std::string corrupt = image;
+	corrupt[0] = 'X';
+	ok = isRejected(corrupt, "image with broken magic") && ok;
+
+	//record counts pointing beyond the image, with bytePoolSize chosen so that
+	//bytePoolOffset + bytePoolSize wraps around to the image size
+	uint32_t nMemoryObjects = readUInt32(image, NMemoryObjectsOffset);
+	corrupt = image;
+	writeUInt32(corrupt, NTargetNodesOffset, 0x10000000);
+	ok = isRejected(corrupt, "image with too many target node records") && ok;
+	uint64_t bytePoolOffset = HeaderSize + (uint64_t) 0x10000000 * TargetNodeRecordSize
+			+ (uint64_t) nMemoryObjects * MemoryObjectRecordSize;
+	writeUInt64(corrupt, BytePoolSizeOffset, (uint64_t) image.size() - bytePoolOffset);
+	ok = isRejected(corrupt, "image with wrapping byte pool size") && ok;
+
+	//memory object index of a target node record out of range
+	corrupt = image;
+	writeUInt32(corrupt, HeaderSize + FirstMemoryObjectOffsetInTargetNodeRecord, nMemoryObjects);
+	ok = isRejected(corrupt, "image with memory object index out of range") && ok;
+
+	unlink(XMLFilename);
+	unlink(ImageFilename);
+	unlink(CorruptImageFilename);
+
+	if (ok) {
+		cout << "OK" << endl;
+		return 0;
+	} else {
+		cout << "NG" << endl;
+		return -1;
+	}
+}
@@ -0,0 +1,198 @@
+/*
+ * test_RMAPTransactionIDRing.cc
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+/* A transaction ID is never handed out twice at a time, neither by RMAPTransactionIDRing popped and
+ * pushed concurrently, nor by RMAPEngine while auto-TID and manual-TID transactions are initiated and
+ * canceled concurrently. Intended to be run also with -fsanitize=thread.
+ */
+
+#include "CxxUtilities/CxxUtilities.hh"
+#include "SpaceWire.hh"
+#include "RMAP.hh"
+#include "TestUtilities.hh"
+#include "RecordingSpaceWireIF.hh"
+
+#include <random>
+#include <thread>
+
+using namespace std;
+
+const size_t FirstTransactionID = 100;
+const size_t NumberOfTransactionIDs = 40;
+const size_t NumberOfThreads = 8;
+const size_t NumberOfOperations = 20000;
+const size_t NumberOfEngineOperations = 2000;
+const size_t NumberOfLinks = 2;
+const double TimeoutDuration = 100000;
+
+/** Marks a transaction ID as held; returns false if it was already held. */
+bool take(std::vector<std::atomic<bool> >& held, uint16_t transactionID) {
+	return !held[transactionID].exchange(true);
+}
+
+void testRing() {
+	RMAPTransactionIDRing ring(FirstTransactionID, NumberOfTransactionIDs);
+	check(ring.size() == NumberOfTransactionIDs, "initial size");
+	std::vector<std::atomic<bool> > held(FirstTransactionID + NumberOfTransactionIDs);
+	for (size_t i = 0; i < held.size(); i++) {
+		held[i] = false;
+	}
+	std::atomic<size_t> nDuplicates(0);
+	std::atomic<size_t> nOutOfRange(0);
+	std::atomic<size_t> nFailedPushes(0);
+
+	//each thread holds up to a few IDs at a time, and pushes them back in random order
+	std::vector<std::thread> threads;
+	for (size_t t = 0; t < NumberOfThreads; t++) {
+		threads.push_back(std::thread([&, t]() {
+			std::mt19937 random(t);
+			std::vector<uint16_t> heldByThisThread;
+			for (size_t i = 0; i < NumberOfOperations; i++) {
+				uint16_t transactionID;
+				if (heldByThisThread.size() < 4 && random() % 2 == 0 && ring.pop(transactionID)) {
+					if (transactionID < FirstTransactionID || transactionID >= held.size()) {
+						nOutOfRange++;
+						continue;
+					}
+					if (!take(held, transactionID)) {
+						nDuplicates++;
+					}
+					heldByThisThread.push_back(transactionID);
+				} else if (!heldByThisThread.empty()) {
+					size_t index = random() % heldByThisThread.size();
+					transactionID = heldByThisThread[index];
+					heldByThisThread.erase(heldByThisThread.begin() + index);
+					held[transactionID] = false;
+					if (!ring.push(transactionID)) {
+						nFailedPushes++;
+					}
+				}
+			}
+			for (size_t i = 0; i < heldByThisThread.size(); i++) {
+				held[heldByThisThread[i]] = false;
+				if (!ring.push(heldByThisThread[i])) {
+					nFailedPushes++;
+				}
+			}
+		}));
+	}
+	for (size_t t = 0; t < threads.size(); t++) {
+		threads[t].join();
+	}
+	check(nDuplicates == 0, "an ID was popped while held by another thread");
+	check(nOutOfRange == 0, "an ID out of the range was popped");
+	check(nFailedPushes == 0, "push() failed");
+
+	//every ID is back in the ring exactly once
+	check(ring.size() == NumberOfTransactionIDs, "size after concurrent use");
+	std::vector<size_t> nPopped(held.size(), 0);
+	uint16_t transactionID;
+	while (ring.pop(transactionID)) {
+		nPopped[transactionID]++;
+	}
+	bool allOnce = true;
+	for (size_t i = FirstTransactionID; i < held.size(); i++) {
+		allOnce = allOnce && nPopped[i] == 1;
+	}
+	check(allOnce, "IDs in the ring after concurrent use");
+	check(ring.push(FirstTransactionID) && ring.size() == 1, "push() to an emptied ring");
+}
+
+/** Returns a transaction which reads 4 bytes via the link, and is never replied by RecordingSpaceWireIF. */
+RMAPTransaction* createTransaction(RMAPPacket* commandPacket, size_t linkIndex) {
+	commandPacket->setCommand();
+	commandPacket->setRead();
+	commandPacket->setReplyMode();
+	commandPacket->setTargetLogicalAddress(0xFE);
+	commandPacket->setAddress(0x100);
+	commandPacket->setLength(4);
+	RMAPTransaction* transaction = new RMAPTransaction();
+	transaction->commandPacket = commandPacket;
+	transaction->linkIndex = linkIndex;
+	transaction->setTimeoutDuration(TimeoutDuration);
+	return transaction;
+}
+
+void testEngine() {
+	RecordingSpaceWireIF* spwifs[NumberOfLinks];
+	for (size_t i = 0; i < NumberOfLinks; i++) {
+		spwifs[i] = new RecordingSpaceWireIF();
+		spwifs[i]->open();
+	}
+	RMAPEngine* rmapEngine = new RMAPEngine(spwifs[0]);
+	for (size_t i = 1; i < NumberOfLinks; i++) {
+		rmapEngine->addSpaceWireIF(spwifs[i]);
+	}
+	rmapEngine->start();
+	size_t nAvailableTransactionIDs = rmapEngine->getNAvailableTransactionIDs();
+	std::vector<std::atomic<bool> > held(RMAPEngine::MaximumTIDNumber);
+	for (size_t i = 0; i < held.size(); i++) {
+		held[i] = false;
+	}
+	std::atomic<size_t> nDuplicates(0);
+	std::atomic<size_t> nUnexpectedExceptions(0);
+	std::atomic<size_t> nManualTransactions(0);
+	//released by an auto-TID transaction, and hence likely still in the ring
+	std::atomic<uint16_t> lastReleasedTransactionID(0);
+
+	//auto-TID threads on each link, and manual-TID threads which take IDs still in the rings
+	std::vector<std::thread> threads;
+	for (size_t t = 0; t < NumberOfThreads; t++) {
+		threads.push_back(std::thread([&, t]() {
+			std::mt19937 random(t);
+			bool isManual = (t % 2 == 1);
+			RMAPPacket commandPacket;
+			RMAPTransaction* transaction = createTransaction(&commandPacket, t % NumberOfLinks);
+			for (size_t i = 0; i < NumberOfEngineOperations; i++) {
+				if (isManual) {
+					transaction->setTransactionID(lastReleasedTransactionID + random() % 4);
+				} else {
+					transaction->setTransactionIDMode(RMAPTransaction::AutoTransactionID);
+				}
+				try {
+					rmapEngine->initiateTransaction(transaction);
+				} catch (RMAPEngineException& e) {
+					if (!isManual || e.getStatus() != RMAPEngineException::SpecifiedTransactionIDIsAlreadyInUse) {
+						nUnexpectedExceptions++;
+					}
+					continue;
+				}
+				uint16_t transactionID = commandPacket.getTransactionID();
+				if (!take(held, transactionID)) {
+					nDuplicates++;
+				}
+				if (isManual) {
+					nManualTransactions++;
+				}
+				std::this_thread::yield();
+				held[transactionID] = false;
+				if (!rmapEngine->cancelTransaction(transaction)) {
+					nUnexpectedExceptions++;
+				}
+				if (!isManual) {
+					lastReleasedTransactionID = transactionID;
+				}
+			}
+			delete transaction;
+		}));
+	}
+	for (size_t t = 0; t < threads.size(); t++) {
+		threads[t].join();
+	}
+	check(nDuplicates == 0, "an ID was handed out while held by another transaction");
+	check(nUnexpectedExceptions == 0, "initiateTransaction() or cancelTransaction() failed");
+	check(nManualTransactions > 0, "no manual-TID transaction was initiated");
+	check(rmapEngine->getNAvailableTransactionIDs() == nAvailableTransactionIDs, "transaction IDs were leaked");
+
+	rmapEngine->stop();
+}
+
+int main(int argc, char* argv[]) {
+	testRing();
+	testEngine();
+
+	return reportTestResult();
+}
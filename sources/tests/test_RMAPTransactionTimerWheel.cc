@@ -0,0 +1,74 @@
+/*
+ * test_RMAPTransactionTimerWheel.cc
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include "CxxUtilities/CxxUtilities.hh"
+#include "RMAPTransactionTimerWheel.hh"
+
+#include <random>
+
+using namespace std;
+
+const size_t NumberOfTransactions = 5000;
+
+int main(int argc, char* argv[]) {
+	std::mt19937_64 random(1);
+	uint64_t currentTick = 123456;
+	RMAPTransactionTimerWheel timerWheel(currentTick);
+	std::vector<RMAPTransaction> transactions(NumberOfTransactions);
+	std::vector<uint64_t> expiryTicks(NumberOfTransactions);
+	std::vector<bool> removed(NumberOfTransactions, false);
+	std::vector<bool> expired(NumberOfTransactions, false);
+
+	//schedule short and long deadlines, and unschedule some of them
+	for (size_t i = 0; i < NumberOfTransactions; i++) {
+		uint64_t delay = (i % 4 == 0) ? random() % 300000 : random() % 5000;
+		expiryTicks[i] = currentTick + delay;
+		timerWheel.add(&transactions[i], expiryTicks[i]);
+		if (i % 10 == 0) {
+			timerWheel.remove(&transactions[i]);
+			removed[i] = true;
+		}
+	}
+
+	//every transaction should expire exactly at its deadline, and not before getNextExpiryTick()
+	size_t nErrors = 0;
+	std::vector<RMAPTransaction*> expiredTransactions;
+	while (!timerWheel.empty()) {
+		currentTick++;
+		uint64_t nextExpiryTick = timerWheel.getNextExpiryTick();
+		timerWheel.advance(currentTick, expiredTransactions);
+		bool isCascadeTick = (nextExpiryTick % RMAPTransactionTimerWheel::SlotsPerLevel) == 0;
+		if ((!expiredTransactions.empty() && currentTick < nextExpiryTick)
+				|| (expiredTransactions.empty() && currentTick == nextExpiryTick && !isCascadeTick)) {
+			cerr << "getNextExpiryTick() returned " << nextExpiryTick << " at " << currentTick << endl;
+			nErrors++;
+		}
+		for (size_t i = 0; i < expiredTransactions.size(); i++) {
+			size_t index = expiredTransactions[i] - &transactions[0];
+			if (removed[index] || expired[index] || expiryTicks[index] != currentTick) {
+				cerr << "transaction " << index << " expired at " << currentTick << " (deadline=" << expiryTicks[index]
+						<< ")" << endl;
+				nErrors++;
+			}
+			expired[index] = true;
+		}
+		expiredTransactions.clear();
+	}
+	for (size_t i = 0; i < NumberOfTransactions; i++) {
+		if (!removed[i] && !expired[i]) {
+			cerr << "transaction " << i << " did not expire" << endl;
+			nErrors++;
+		}
+	}
+
+	if (nErrors == 0) {
+		cout << "OK" << endl;
+		return 0;
+	} else {
+		cout << "NG (" << nErrors << " errors)" << endl;
+		return -1;
+	}
+}
@@ -0,0 +1,81 @@
+/*
+ * test_RMAPUtilities_crc.cc
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+/* The slice-by-8 RMAP CRC equals the byte-by-byte table lookup, and both equal a bitwise reference, for
+ * the CRC of the RMAP Standard (ECSS-E-ST-50-52C) and that of Draft E, at any length and alignment.
+ */
+
+#include "CxxUtilities/CxxUtilities.hh"
+#include "RMAPUtilities.hh"
+#include "TestUtilities.hh"
+
+#include <random>
+
+using namespace std;
+
+const size_t MaximumLength = 300;
+
+/** CRC-8 with polynomial x^8+x^2+x+1, calculated bit by bit.
+ * The RMAP Standard processes bits LSB first (reflected), and Draft E MSB first.
+ */
+uint8_t calculateCRCBitwise(const uint8_t* data, size_t length, bool useDraftE) {
+	uint8_t crc = 0x00;
+	for (size_t i = 0; i < length; i++) {
+		crc ^= data[i];
+		for (size_t bit = 0; bit < 8; bit++) {
+			if (useDraftE) {
+				crc = (crc & 0x80) ? (uint8_t) ((crc << 1) ^ 0x07) : (uint8_t) (crc << 1);
+			} else {
+				crc = (crc & 0x01) ? (uint8_t) ((crc >> 1) ^ 0xE0) : (uint8_t) (crc >> 1);
+			}
+		}
+	}
+	return crc;
+}
+
+int main(int argc, char* argv[]) {
+	std::mt19937 random(1);
+	std::vector<uint8_t> buffer(MaximumLength + 8);
+	for (size_t i = 0; i < buffer.size(); i++) {
+		buffer[i] = (uint8_t) random();
+	}
+
+	for (size_t variant = 0; variant < 2; variant++) {
+		bool useDraftE = (variant == 1);
+		std::string name = useDraftE ? "Draft E" : "ECSS";
+		bool byteByByteIsCorrect = true;
+		bool sliceBy8IsCorrect = true;
+		bool dispatchIsCorrect = true;
+		for (size_t offset = 0; offset < 8; offset++) {
+			for (size_t length = 0; length <= MaximumLength; length++) {
+				uint8_t* data = &(buffer[offset]);
+				uint8_t expected = calculateCRCBitwise(data, length, useDraftE);
+				byteByByteIsCorrect = byteByByteIsCorrect
+						&& RMAPUtilities::calculateCRCByteByByte(data, length, useDraftE) == expected;
+				sliceBy8IsCorrect = sliceBy8IsCorrect
+						&& RMAPUtilities::calculateCRCSliceBy8(data, length, useDraftE) == expected;
+				uint8_t dispatched = useDraftE ? RMAPUtilities::calculateCRCBasedOnDraftESpecification(data, length) //
+				: RMAPUtilities::calculateCRC(data, length);
+				dispatchIsCorrect = dispatchIsCorrect && dispatched == expected;
+			}
+		}
+		check(byteByByteIsCorrect, name + ": byte-by-byte table lookup differs from the bitwise reference");
+		check(sliceBy8IsCorrect, name + ": slice-by-8 differs from the bitwise reference");
+		check(dispatchIsCorrect, name + ": length-based dispatch differs from the bitwise reference");
+
+		//vector overloads, including an empty vector
+		std::vector<uint8_t> empty;
+		std::vector<uint8_t> data(buffer.begin(), buffer.begin() + MaximumLength);
+		uint8_t crcOfEmpty = useDraftE ? RMAPUtilities::calculateCRCBasedOnDraftESpecification(empty) //
+		: RMAPUtilities::calculateCRC(empty);
+		uint8_t crcOfData = useDraftE ? RMAPUtilities::calculateCRCBasedOnDraftESpecification(data) //
+		: RMAPUtilities::calculateCRC(data);
+		check(crcOfEmpty == 0x00 && crcOfData == calculateCRCBitwise(&(data[0]), data.size(), useDraftE),
+				name + ": vector overloads");
+	}
+
+	return reportTestResult();
+}
@@ -0,0 +1,295 @@
+/*
+ * test_SpaceWireIFOverTCPReactor.cc
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include "CxxUtilities/CxxUtilities.hh"
+#include "SpaceWire.hh"
+
+#include <atomic>
+#include <chrono>
+#include <dirent.h>
+#include <mutex>
+#include <thread>
+
+using namespace std;
+
+const uint32_t FirstPortNumber = 10070;
+const size_t NumberOfLinks = 32;
+const size_t NumberOfPacketsPerLink = 200;
+const size_t LargePacketSize = 100 * 1024;
+const uint32_t HandoverPortNumber = FirstPortNumber + NumberOfLinks;
+
+class Handler: public SpaceWireIFOverTCPReactorHandler, public SpaceWireIFActionTimecodeScynchronizedAction {
+public:
+	size_t nPackets;
+	size_t nErrors;
+	std::atomic<size_t> nReceivedPackets;
+	std::atomic<size_t> nTimeCodes;
+	std::atomic<bool> disconnected;
+
+public:
+	Handler() :
+			nPackets(0), nErrors(0), nReceivedPackets(0), nTimeCodes(0), disconnected(false) {
+	}
+
+public:
+	void packetReceived(SpaceWireIFOverTCP* spwif, SpaceWireReceiveBuffer* buffer) {
+		//packets carry their sequence number, and every 50th packet is large
+		size_t expectedSize = (nPackets % 50 == 49) ? LargePacketSize : 16 + nPackets % 7;
+		if (buffer->getSize() != expectedSize || buffer->getData()[0] != (uint8_t) nPackets
+				|| buffer->getData()[expectedSize - 1] != (uint8_t) nPackets) {
+			nErrors++;
+		}
+		nPackets++;
+		nReceivedPackets++;
+	}
+
+	void linkDisconnected(SpaceWireIFOverTCP* spwif) {
+		disconnected = true;
+	}
+
+	void doAction(unsigned char timecode) {
+		nTimeCodes++;
+	}
+};
+
+size_t getNThreads() {
+	size_t nThreads = 0;
+	DIR* directory = opendir("/proc/self/task");
+	while (readdir(directory) != NULL) {
+		nThreads++;
+	}
+	closedir(directory);
+	return nThreads;
+}
+
+class ParserAction: public SpaceWireSSDTPParserAction {
+public:
+	std::vector<std::vector<uint8_t> > packets;
+	std::vector<SpaceWireEOPMarker::EOPType> eopTypes;
+	std::vector<uint8_t> timecodes;
+
+public:
+	void packetParsed(SpaceWireReceiveBuffer* buffer) {
+		packets.push_back(*buffer->getVector());
+		eopTypes.push_back(buffer->getEOPType());
+	}
+
+	void timecodeParsed(uint8_t timecode) {
+		timecodes.push_back(timecode);
+	}
+};
+
+bool testParser() {
+	//a fragmented packet with a TimeCode in between, an EEP-terminated packet, and a broken frame,
+	//fed to the parser one byte at a time
+	const uint8_t stream[] = { //
+			0x02, 0x00, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0x01, 0x02, //
+					0x30, 0x00, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0x21, 0x00, //
+					0x00, 0x00, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0x03, //
+					0x01, 0x00, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 0x04, //
+					0x77, 0x00, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 };
+	SpaceWireReceiveBufferPool pool;
+	SpaceWireSSDTPParser parser(&pool);
+	ParserAction action;
+	bool brokenFrameDetected = false;
+	try {
+		for (size_t i = 0; i < sizeof(stream); i++) {
+			parser.parse(stream + i, 1, &action);
+		}
+	} catch (SpaceWireSSDTPException& e) {
+		brokenFrameDetected = (e.getStatus() == SpaceWireSSDTPException::TCPSocketError);
+	}
+	std::vector<uint8_t> firstPacket = { 0x01, 0x02, 0x03 };
+
+	//a fragment size which does not fit in 64 bits
+	const uint8_t oversizedHeader[] = { 0x00, 0x00, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF };
+	SpaceWireSSDTPParser oversizedParser(&pool);
+	bool oversizedFragmentDetected = false;
+	try {
+		oversizedParser.parse(oversizedHeader, sizeof(oversizedHeader), &action);
+	} catch (SpaceWireSSDTPException& e) {
+		oversizedFragmentDetected = (e.getStatus() == SpaceWireSSDTPException::DataSizeTooLarge);
+	}
+	return action.packets.size() == 2 && action.packets[0] == firstPacket && action.packets[1][0] == 0x04
+			&& action.eopTypes[0] == SpaceWireEOPMarker::EOP && action.eopTypes[1] == SpaceWireEOPMarker::EEP
+			&& action.timecodes.size() == 1 && action.timecodes[0] == 0x21 && brokenFrameDetected
+			&& oversizedFragmentDetected;
+}
+
+class HandoverHandler: public SpaceWireIFOverTCPReactorHandler {
+public:
+	std::vector<std::vector<uint8_t> > packets;
+	std::mutex mutex;
+
+public:
+	void packetReceived(SpaceWireIFOverTCP* spwif, SpaceWireReceiveBuffer* buffer) {
+		std::lock_guard<std::mutex> guard(mutex);
+		packets.push_back(*buffer->getVector());
+	}
+};
+
+/** A packet which the SSDTP module of a link has read ahead is passed to the handler when the link is added. */
+bool testReadAheadHandover(SpaceWireIFOverTCPReactor* reactor) {
+	SpaceWireIFOverTCP* server = new SpaceWireIFOverTCP(HandoverPortNumber);
+	std::thread openThread([&]() {
+		server->open();
+	});
+	CxxUtilities::Condition condition;
+	condition.wait(20);
+	SpaceWireIFOverTCP* client = new SpaceWireIFOverTCP("127.0.0.1", HandoverPortNumber);
+	client->open();
+	openThread.join();
+
+	//both packets are written at once, and the first receive() reads them into the read-ahead buffer
+	std::vector<uint8_t> firstPacket(16, 0x01);
+	std::vector<uint8_t> secondPacket(24, 0x02);
+	std::vector<std::vector<uint8_t>*> packets = { &firstPacket, &secondPacket };
+	client->sendMany(packets);
+	condition.wait(50);
+	std::vector<uint8_t>* receivedPacket = server->receive();
+	bool ok = (*receivedPacket == firstPacket);
+	delete receivedPacket;
+
+	HandoverHandler handler;
+	reactor->addLink(server, &handler);
+	std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+	while (std::chrono::steady_clock::now() < deadline) {
+		{
+			std::lock_guard<std::mutex> guard(handler.mutex);
+			if (!handler.packets.empty()) {
+				break;
+			}
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	reactor->removeLink(server);
+	ok = ok && handler.packets.size() == 1 && handler.packets[0] == secondPacket;
+	client->close();
+	server->close();
+	return ok;
+}
+
+int main(int argc, char* argv[]) {
+	bool ok = true;
+	if (!testParser()) {
+		cerr << "NG: SpaceWireSSDTPParser" << endl;
+		ok = false;
+	}
+
+	//connect pairs of SpaceWireIFOverTCP instances via the loopback interface
+	std::vector<SpaceWireIFOverTCP*> senders;
+	std::vector<SpaceWireIFOverTCP*> receivers;
+	for (size_t i = 0; i < NumberOfLinks; i++) {
+		SpaceWireIFOverTCP* server = new SpaceWireIFOverTCP(FirstPortNumber + i);
+		std::thread openThread([&]() {
+			server->open();
+		});
+		CxxUtilities::Condition condition;
+		condition.wait(20);
+		SpaceWireIFOverTCP* client = new SpaceWireIFOverTCP("127.0.0.1", FirstPortNumber + i);
+		client->open();
+		openThread.join();
+		senders.push_back(client);
+		receivers.push_back(server);
+	}
+
+	SpaceWireIFOverTCPReactor* reactor = new SpaceWireIFOverTCPReactor();
+	reactor->start();
+	std::vector<Handler*> handlers;
+	size_t nThreadsBeforeAddingLinks = getNThreads();
+	for (size_t i = 0; i < NumberOfLinks; i++) {
+		handlers.push_back(new Handler());
+		receivers[i]->addTimecodeAction(handlers[i]);
+		reactor->addLink(receivers[i], handlers[i]);
+	}
+	if (getNThreads() != nThreadsBeforeAddingLinks) {
+		cerr << "NG: adding links created threads" << endl;
+		ok = false;
+	}
+	try {
+		reactor->addLink(receivers[0], handlers[0]);
+		cerr << "NG: a link was added twice" << endl;
+		ok = false;
+	} catch (SpaceWireIFOverTCPReactorException& e) {
+	}
+
+	//all links send concurrently
+	std::vector<std::thread*> sendThreads;
+	for (size_t i = 0; i < NumberOfLinks; i++) {
+		sendThreads.push_back(new std::thread([&, i]() {
+			std::vector<uint8_t> packet;
+			for (size_t n = 0; n < NumberOfPacketsPerLink; n++) {
+				packet.assign((n % 50 == 49) ? LargePacketSize : 16 + n % 7, (uint8_t) n);
+				senders[i]->send(&packet[0], packet.size());
+				if (n % 100 == 0) {
+					senders[i]->emitTimecode(n % 64);
+				}
+			}
+		}));
+	}
+	for (size_t i = 0; i < NumberOfLinks; i++) {
+		sendThreads[i]->join();
+		delete sendThreads[i];
+	}
+	std::chrono::steady_clock::time_point deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+	for (size_t i = 0; i < NumberOfLinks; i++) {
+		while (handlers[i]->nReceivedPackets != NumberOfPacketsPerLink || handlers[i]->nTimeCodes != 2) {
+			if (std::chrono::steady_clock::now() > deadline) {
+				cerr << "NG: link " << i << " received " << handlers[i]->nReceivedPackets << " packets and "
+						<< handlers[i]->nTimeCodes << " TimeCodes" << endl;
+				ok = false;
+				break;
+			}
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		}
+		if (handlers[i]->nErrors != 0) {
+			cerr << "NG: link " << i << " received " << handlers[i]->nErrors << " broken packets" << endl;
+			ok = false;
+		}
+	}
+
+	//disconnection is reported, and the link is removed
+	senders[0]->close();
+	deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+	while (!handlers[0]->disconnected && std::chrono::steady_clock::now() < deadline) {
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	if (!handlers[0]->disconnected || reactor->getNLinks() != NumberOfLinks - 1) {
+		cerr << "NG: disconnection was not reported" << endl;
+		ok = false;
+	}
+
+	//after removeLink() returns, the handler is not invoked
+	reactor->removeLink(receivers[1]);
+	std::vector<uint8_t> packet(16, 0xFF);
+	senders[1]->send(&packet[0], packet.size());
+	std::this_thread::sleep_for(std::chrono::milliseconds(50));
+	if (handlers[1]->nReceivedPackets != NumberOfPacketsPerLink) {
+		cerr << "NG: a removed link was served" << endl;
+		ok = false;
+	}
+
+	if (!testReadAheadHandover(reactor)) {
+		cerr << "NG: a read-ahead packet was not handed over to the reactor" << endl;
+		ok = false;
+	}
+
+	//stopping does not wait for receive timeouts
+	std::chrono::steady_clock::time_point stopStarted = std::chrono::steady_clock::now();
+	reactor->stop();
+	double stopDurationInMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - stopStarted).count();
+	if (stopDurationInMs > 100) {
+		cerr << "NG: stop() took " << stopDurationInMs << " ms" << endl;
+		ok = false;
+	}
+	reactor->waitUntilRunMethodComplets();
+	cout << "nReadSystemCalls=" << reactor->nReadSystemCalls << " nReceivedPackets=" << reactor->nReceivedPackets
+			<< " nAllocatedObjects=" << reactor->getReceiveBufferPool()->nAllocatedObjects << endl;
+
+	delete reactor;
+	cout << (ok ? "OK" : "NG") << endl;
+	return ok ? 0 : -1;
+}
@@ -0,0 +1,73 @@
+/*
+ * test_SpaceWireRPacket_getPacket.cc
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+/* SpaceWireRPacket::getPacket(uint8_t*, size_t) writes the same bytes as getPacketBufferPointer(), and
+ * its CRC covers the header and the payload (not the destination SpaceWire address nor the byte after
+ * the payload), so that interpretPacket() accepts the packet.
+ */
+
+#include "CxxUtilities/CxxUtilities.hh"
+#include "SpaceWireR/SpaceWireRPacket.hh"
+#include "TestUtilities.hh"
+
+#include <sstream>
+
+using namespace std;
+
+const size_t MaximumPacketSize = 1024;
+
+void testGetPacket(std::vector<uint8_t> destinationSpaceWireAddress, size_t payloadSize) {
+	std::stringstream ss;
+	ss << "address of " << destinationSpaceWireAddress.size() << " bytes, payload of " << payloadSize << " bytes";
+	std::string name = ss.str();
+
+	SpaceWireRPacket packet;
+	packet.setDestinationSpaceWireAddress(destinationSpaceWireAddress);
+	packet.setDestinationLogicalAddress(0x30);
+	packet.setSourceLogicalAddress(0xFE);
+	packet.setChannelNumber(0x6342);
+	packet.setSequenceNumber(7);
+	packet.setDataPacketFlag();
+	packet.setCompleteSegmentFlag();
+	std::vector<uint8_t> payload(payloadSize);
+	for (size_t i = 0; i < payloadSize; i++) {
+		payload[i] = (uint8_t) (i * 13 + 1);
+	}
+	packet.setPayload(payload);
+
+	std::vector<uint8_t>* expected = packet.getPacketBufferPointer();
+	//the byte after the packet is filled so that a CRC range exceeding the packet is detected
+	for (uint8_t filler = 0x00; filler < 0x02; filler++) {
+		std::vector<uint8_t> buffer(MaximumPacketSize, filler);
+		size_t length = packet.getPacket(&(buffer[0]), buffer.size());
+		buffer.resize(length);
+		check(buffer == *expected, name + ": getPacket() differs from getPacketBufferPointer()");
+		SpaceWireRPacket interpreted;
+		try {
+			interpreted.interpretPacket(&buffer);
+			check(*interpreted.getPayload() == payload, name + ": payload");
+		} catch (SpaceWireRPacketException& e) {
+			check(false, name + ": interpretPacket() threw " + e.toString());
+		}
+	}
+	delete expected;
+
+	//too small a buffer
+	std::vector<uint8_t> buffer(MaximumPacketSize);
+	check(packet.getPacket(&(buffer[0]), packet.getPacket(&(buffer[0]), buffer.size()) - 1) == 0,
+			name + ": getPacket() to a too small buffer");
+}
+
+int main(int argc, char* argv[]) {
+	std::vector<uint8_t> noAddress;
+	std::vector<uint8_t> address( { 3, 10 });
+	testGetPacket(noAddress, 0);
+	testGetPacket(noAddress, 100);
+	testGetPacket(address, 0);
+	testGetPacket(address, 100);
+
+	return reportTestResult();
+}
@@ -0,0 +1,93 @@
+/*
+ * test_SpaceWireRUtilities_crc.cc
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+/* The slice-by-8 CRC-16/CCITT of SpaceWireRUtilities equals a bitwise reference implementation for
+ * any length and alignment, and updateCRC() over split parts equals the CRC over the whole array.
+ */
+
+#include "CxxUtilities/CxxUtilities.hh"
+#include "SpaceWireR/SpaceWireRUtilities.hh"
+#include "TestUtilities.hh"
+
+#include <random>
+
+using namespace std;
+
+const size_t MaximumLength = 300;
+const size_t NumberOfRandomSplits = 2000;
+
+/** CRC-16/CCITT (polynomial 0x1021, MSB first, not inverted) calculated bit by bit. */
+uint16_t calculateCRCBitwise(const uint8_t* data, size_t length) {
+	uint16_t crc = SpaceWireRUtilities::CRCInitialValue;
+	for (size_t i = 0; i < length; i++) {
+		crc ^= (uint16_t) (data[i] << 8);
+		for (size_t bit = 0; bit < 8; bit++) {
+			crc = (crc & 0x8000) ? (uint16_t) ((crc << 1) ^ 0x1021) : (uint16_t) (crc << 1);
+		}
+	}
+	return crc;
+}
+
+int main(int argc, char* argv[]) {
+	std::mt19937 random(1);
+	std::vector<uint8_t> buffer(MaximumLength + 8);
+	for (size_t i = 0; i < buffer.size(); i++) {
+		buffer[i] = (uint8_t) random();
+	}
+
+	//check value of CRC-16/CCITT-FALSE
+	uint8_t checkString[] = { '1', '2', '3', '4', '5', '6', '7', '8', '9' };
+	check(SpaceWireRUtilities::calculateCRCForArray(checkString, sizeof(checkString)) == 0x29B1, "check value");
+
+	//every length at every alignment
+	bool allEqual = true;
+	for (size_t offset = 0; offset < 8; offset++) {
+		for (size_t length = 0; length <= MaximumLength; length++) {
+			uint8_t* data = &(buffer[offset]);
+			allEqual = allEqual
+					&& SpaceWireRUtilities::calculateCRCForArray(data, length) == calculateCRCBitwise(data, length);
+		}
+	}
+	check(allEqual, "calculateCRCForArray() differs from the bitwise reference");
+
+	//every split into two parts, and random splits into three parts
+	allEqual = true;
+	for (size_t length = 0; length <= 40; length++) {
+		uint16_t expected = calculateCRCBitwise(&(buffer[0]), length);
+		for (size_t split = 0; split <= length; split++) {
+			uint16_t crc = SpaceWireRUtilities::updateCRC(SpaceWireRUtilities::CRCInitialValue, &(buffer[0]), split);
+			crc = SpaceWireRUtilities::updateCRC(crc, &(buffer[split]), length - split);
+			allEqual = allEqual && crc == expected;
+		}
+	}
+	for (size_t i = 0; i < NumberOfRandomSplits; i++) {
+		size_t length = random() % (MaximumLength + 1);
+		size_t first = random() % (length + 1);
+		size_t second = first + random() % (length - first + 1);
+		uint16_t crc = SpaceWireRUtilities::updateCRC(SpaceWireRUtilities::CRCInitialValue, &(buffer[0]), first);
+		crc = SpaceWireRUtilities::updateCRC(crc, &(buffer[first]), second - first);
+		crc = SpaceWireRUtilities::updateCRC(crc, &(buffer[second]), length - second);
+		allEqual = allEqual && crc == calculateCRCBitwise(&(buffer[0]), length);
+	}
+	check(allEqual, "updateCRC() over split parts differs from the bitwise reference");
+
+	//header and data, either of which can be empty
+	allEqual = true;
+	size_t lengths[] = { 0, 1, 7, 8, 9, 12, 100 };
+	size_t nLengths = sizeof(lengths) / sizeof(lengths[0]);
+	for (size_t h = 0; h < nLengths; h++) {
+		for (size_t d = 0; d < nLengths; d++) {
+			std::vector<uint8_t> header(buffer.begin(), buffer.begin() + lengths[h]);
+			std::vector<uint8_t> data(buffer.begin() + lengths[h], buffer.begin() + lengths[h] + lengths[d]);
+			allEqual = allEqual
+					&& SpaceWireRUtilities::calculateCRCForHeaderAndData(header, data)
+							== calculateCRCBitwise(&(buffer[0]), lengths[h] + lengths[d]);
+		}
+	}
+	check(allEqual, "calculateCRCForHeaderAndData() differs from the bitwise reference");
+
+	return reportTestResult();
+}
@@ -0,0 +1,118 @@
+/*
+ * test_SpaceWireReceiveBufferPool.cc
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include "CxxUtilities/CxxUtilities.hh"
+#include "SpaceWire.hh"
+
+#include <thread>
+
+using namespace std;
+
+const uint32_t PortNumber = 10031;
+const size_t NumberOfPackets = 1000;
+
+int main(int argc, char* argv[]) {
+	//connect two SpaceWireIFOverTCP instances via the loopback interface
+	SpaceWireIFOverTCP* server = new SpaceWireIFOverTCP(PortNumber);
+	std::thread openThread([&]() {
+		server->open();
+	});
+	CxxUtilities::Condition condition;
+	condition.wait(200);
+	SpaceWireIFOverTCP* client = new SpaceWireIFOverTCP("127.0.0.1", PortNumber);
+	client->open();
+	openThread.join();
+	client->setTimeoutDuration(1000000);
+
+	bool ok = true;
+	SpaceWireReceiveBufferPool pool(4, 1024);
+	pool.reserve(2);
+	std::vector<uint8_t> packet(512);
+	for (size_t i = 0; i < NumberOfPackets; i++) {
+		packet[0] = (uint8_t) i;
+		server->send(&packet[0], packet.size(), (i % 2 == 0) ? SpaceWireEOPMarker::EOP : SpaceWireEOPMarker::EEP);
+		SpaceWireReceiveBuffer* buffer = client->receiveIntoPooledBuffer(&pool);
+		//hand the buffer to a second consumer; the buffer returns to the pool after both release it
+		buffer->retain();
+		if (buffer->getSize() != packet.size() || buffer->getData()[0] != (uint8_t) i
+				|| buffer->getEOPType() != ((i % 2 == 0) ? SpaceWireEOPMarker::EOP : SpaceWireEOPMarker::EEP)) {
+			cerr << "NG: packet " << i << " was not received correctly" << endl;
+			ok = false;
+		}
+		buffer->release();
+		if (pool.getNFreeObjects() != 1) {
+			cerr << "NG: buffer was returned to the pool while still referenced" << endl;
+			ok = false;
+		}
+		buffer->release();
+	}
+	if (pool.nAllocatedObjects != 2 || pool.getNFreeObjects() != 2) {
+		cerr << "NG: steady-state receive allocated buffers (nAllocatedObjects=" << pool.nAllocatedObjects << ")" << endl;
+		ok = false;
+	}
+
+	//the array variant reports the EOP marker type
+	uint8_t array[16];
+	size_t length;
+	SpaceWireEOPMarker::EOPType eopType;
+	std::vector<uint8_t> shortPacket = { 0x01, 0x02, 0x03 };
+	server->send(&shortPacket[0], shortPacket.size(), SpaceWireEOPMarker::EEP);
+	client->receive(array, eopType, sizeof(array), length);
+	if (length != 3 || array[2] != 0x03 || eopType != SpaceWireEOPMarker::EEP) {
+		cerr << "NG: array receive" << endl;
+		ok = false;
+	}
+
+	//a burst sent with sendMany() is received with fewer receiveMany() calls
+	const size_t BurstSize = 64;
+	std::vector<std::vector<uint8_t> > burst(BurstSize, std::vector<uint8_t>(100));
+	std::vector<std::vector<uint8_t>*> burstPointers;
+	for (size_t i = 0; i < BurstSize; i++) {
+		burst[i][0] = (uint8_t) i;
+		burstPointers.push_back(&burst[i]);
+	}
+	server->sendMany(burstPointers);
+	std::vector<SpaceWireReceiveBuffer*> buffers;
+	for (size_t i = 0; i < 16; i++) {
+		buffers.push_back(pool.acquire());
+	}
+	size_t nReceived = 0;
+	size_t nCalls = 0;
+	while (nReceived < BurstSize) {
+		size_t n = client->receiveMany(buffers);
+		nCalls++;
+		if (n == 0) {
+			cerr << "NG: receiveMany() timed out" << endl;
+			ok = false;
+			break;
+		}
+		for (size_t i = 0; i < n; i++) {
+			if (buffers[i]->getSize() != 100 || buffers[i]->getData()[0] != (uint8_t) nReceived) {
+				cerr << "NG: packet " << nReceived << " of the burst was not received correctly" << endl;
+				ok = false;
+			}
+			nReceived++;
+		}
+	}
+	if (nCalls >= BurstSize) {
+		cerr << "NG: receiveMany() returned one packet per call" << endl;
+		ok = false;
+	}
+	//a timeout is reported by returning 0
+	client->setTimeoutDuration(100000);
+	if (client->receiveMany(buffers) != 0) {
+		cerr << "NG: receiveMany() returned a packet which was not sent" << endl;
+		ok = false;
+	}
+	for (size_t i = 0; i < buffers.size(); i++) {
+		buffers[i]->release();
+	}
+
+	client->close();
+	server->close();
+	cout << (ok ? "OK" : "NG") << endl;
+	return ok ? 0 : -1;
+}
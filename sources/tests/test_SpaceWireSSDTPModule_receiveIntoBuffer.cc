@@ -0,0 +1,108 @@
+/*
+ * test_SpaceWireSSDTPModule_receiveIntoBuffer.cc
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include "CxxUtilities/CxxUtilities.hh"
+#include "SpaceWire.hh"
+
+#include <thread>
+
+using namespace std;
+using namespace CxxUtilities;
+
+const uint32_t PortNumber = 10030;
+
+int main(int argc, char* argv[]) {
+	//connect two SSDTP modules via the loopback interface
+	TCPServerSocket* serverSocket = new TCPServerSocket(PortNumber);
+	serverSocket->open();
+	TCPSocket* acceptedSocket = NULL;
+	std::thread acceptThread([&]() {
+		acceptedSocket = serverSocket->accept();
+	});
+	TCPClientSocket* clientSocket = new TCPClientSocket("127.0.0.1", PortNumber);
+	clientSocket->open(1000);
+	acceptThread.join();
+	clientSocket->setTimeout(1000);
+
+	SpaceWireSSDTPModule* sender = new SpaceWireSSDTPModule(acceptedSocket);
+	SpaceWireSSDTPModule* receiver = new SpaceWireSSDTPModule(clientSocket);
+
+	//a fragmented packet with a TimeCode in between, then a packet larger than the receive buffer
+	std::vector<uint8_t> firstHalf = { 0x01, 0x02, 0x03 };
+	std::vector<uint8_t> secondHalf = { 0x04, 0x05 };
+	std::vector<uint8_t> largePacket(64, 0xAA);
+	std::vector<uint8_t> lastPacket = { 0xFE, 0x01 };
+	sender->send(&firstHalf, SpaceWireEOPMarker::Continued);
+	sender->sendTimeCode(0x21);
+	sender->send(&secondHalf, SpaceWireEOPMarker::EOP);
+	sender->send(largePacket);
+	sender->send(lastPacket);
+
+	bool ok = true;
+	uint8_t buffer[16];
+	uint32_t eopType;
+	size_t length = receiver->receive(buffer, sizeof(buffer), eopType);
+	if (length != 5 || buffer[0] != 0x01 || buffer[4] != 0x05 || eopType != SpaceWireEOPMarker::EOP) {
+		cerr << "NG: fragmented packet was not reassembled in the buffer" << endl;
+		ok = false;
+	}
+	if (receiver->getTimeCode() != 0x21) {
+		cerr << "NG: TimeCode was not received" << endl;
+		ok = false;
+	}
+	try {
+		receiver->receive(buffer, sizeof(buffer), eopType);
+		cerr << "NG: too-large packet was not reported" << endl;
+		ok = false;
+	} catch (SpaceWireSSDTPException& e) {
+		if (e.getStatus() != SpaceWireSSDTPException::DataSizeTooLarge) {
+			cerr << "NG: unexpected exception " << e.toString() << endl;
+			ok = false;
+		}
+	}
+	std::vector<uint8_t> received;
+	receiver->receive(&received, eopType);
+	if (received != lastPacket) {
+		cerr << "NG: stream lost synchronization after a too-large packet" << endl;
+		ok = false;
+	}
+
+	//a vector reused for packets of different sizes; the middle fragment is large enough to be read directly
+	std::vector<uint8_t> fragments[3] = { std::vector<uint8_t>(100), std::vector<uint8_t>(100000),
+			std::vector<uint8_t>(10) };
+	std::vector<uint8_t> expected;
+	for (size_t i = 0; i < 3; i++) {
+		for (size_t j = 0; j < fragments[i].size(); j++) {
+			fragments[i][j] = (uint8_t) (i * 7 + j);
+		}
+		expected.insert(expected.end(), fragments[i].begin(), fragments[i].end());
+	}
+	std::thread sendThread([&]() {
+		sender->send(&fragments[0], SpaceWireEOPMarker::Continued);
+		sender->send(&fragments[1], SpaceWireEOPMarker::Continued);
+		sender->send(&fragments[2], SpaceWireEOPMarker::EOP);
+		sender->send(lastPacket);
+	});
+	received.assign(300, 0x55);
+	receiver->receive(&received, eopType);
+	if (received != expected) {
+		cerr << "NG: large fragmented packet was not received into the vector (" << received.size() << " bytes)" << endl;
+		ok = false;
+	}
+	receiver->receive(&received, eopType);
+	if (received != lastPacket) {
+		cerr << "NG: small packet was not received into the reused vector" << endl;
+		ok = false;
+	}
+	sendThread.join();
+
+	delete sender;
+	delete receiver;
+	clientSocket->close();
+	serverSocket->close();
+	cout << (ok ? "OK" : "NG") << endl;
+	return ok ? 0 : -1;
+}
@@ -0,0 +1,58 @@
+/*
+ * test_SpaceWireSSDTPModule_sendToClosedPeer.cc
+ *
+ *  Created on: Oct 17, 2026
+ */
+
+#include "CxxUtilities/CxxUtilities.hh"
+#include "SpaceWire.hh"
+
+#include <thread>
+
+using namespace std;
+using namespace CxxUtilities;
+
+const uint32_t PortNumber = 10032;
+const size_t MaxNumberOfAttempts = 1000;
+
+int main(int argc, char* argv[]) {
+	//connect via the loopback interface, then close the receiving side
+	TCPServerSocket* serverSocket = new TCPServerSocket(PortNumber);
+	serverSocket->open();
+	TCPSocket* acceptedSocket = NULL;
+	std::thread acceptThread([&]() {
+		acceptedSocket = serverSocket->accept();
+	});
+	TCPClientSocket* clientSocket = new TCPClientSocket("127.0.0.1", PortNumber);
+	clientSocket->open(1000);
+	acceptThread.join();
+	acceptedSocket->close();
+	serverSocket->close();
+
+	//sending to the closed peer should be reported as an exception (not SIGPIPE)
+	SpaceWireSSDTPModule* sender = new SpaceWireSSDTPModule(clientSocket);
+	std::vector<uint8_t> packet(1024, 0xAA);
+	std::vector<std::vector<uint8_t>*> packets(4, &packet);
+	bool ok = false;
+	for (size_t i = 0; i < MaxNumberOfAttempts; i++) {
+		try {
+			if (i % 2 == 0) {
+				sender->send(packet);
+			} else {
+				sender->sendMany(packets);
+			}
+		} catch (SpaceWireSSDTPException& e) {
+			if (e.getStatus() == SpaceWireSSDTPException::Disconnected) {
+				ok = true;
+			} else {
+				cerr << "NG: unexpected exception " << e.toString() << endl;
+			}
+			break;
+		}
+	}
+
+	delete sender;
+	clientSocket->close();
+	cout << (ok ? "OK" : "NG") << endl;
+	return ok ? 0 : -1;
+}